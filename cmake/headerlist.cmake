@@ -1,13 +1,30 @@
 set(headers ${headers}
 	src/API/BTPS_API_decl.h
+	src/API/ImmersiveHUDAPI.h
 	src/API/SmoothCamAPI.h
 	src/API/TrueDirectionalMovementAPI.h
 	src/Compat.h
 	src/Events.h
+	src/FadeEngine.h
+	src/GFxOps.h
+	src/HUDApply.h
 	src/HUDElements.h
 	src/HUDManager.h
+	src/JsonStream.h
+	src/MCMConfig.h
 	src/MCMGen.h
+	src/MCMUpdate.h
 	src/PCH.h
+	src/Papyrus.h
+	src/PatternMatcher.h
+	src/PluginAPI.h
+	src/Profiler.h
+	src/ScriptOverrides.h
 	src/Settings.h
+	src/SourceProbe.h
+	src/StringKernels.h
+	src/Trace.h
 	src/Utils.h
+	src/WidgetDiscovery.h
+	src/WidgetMode.h
 )
@@ -1,10 +1,20 @@
 set(sources ${sources}
 	src/Compat.cpp
 	src/Events.cpp
+	src/FadeEngine.cpp
 	src/HUDManager.cpp
+	src/MCMConfig.cpp
 	src/MCMGen.cpp
 	src/PCH.cpp
+	src/Papyrus.cpp
+	src/PatternMatcher.cpp
+	src/PluginAPI.cpp
+	src/Profiler.cpp
+	src/ScriptOverrides.cpp
 	src/Settings.cpp
+	src/SourceProbe.cpp
+	src/StringKernels.cpp
+	src/Trace.cpp
 	src/Utils.cpp
 	src/main.cpp
 )
@@ -0,0 +1,319 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <stdint.h>
+
+/*
+* For modders: Copy this file into your own project if you wish to use this API (requires CommonLibSSE)
+*
+* Registered widgets are never scanned for and are not listed in ImmersiveHUD's MCM: the registering
+* plugin chooses the channel. ImmersiveHUD pushes alpha to them only when it changes.
+*/
+namespace ImmersiveHUDAPI
+{
+	constexpr const auto ImmersiveHUDPluginName = "ImmersiveHUD";
+
+	// Available ImmersiveHUD interface versions
+	enum class InterfaceVersion : uint8_t
+	{
+		V1,
+		V2
+	};
+
+	// Error types that may be returned by the ImmersiveHUD API
+	enum class APIResult : uint8_t
+	{
+		// Your request was successful
+		OK,
+
+		// A widget with this id, or this exact subscription, already exists
+		AlreadyRegistered,
+
+		// No widget with this id, or no matching subscription, exists
+		NotRegistered,
+
+		// Empty or non-ASCII id/target, or a channel that cannot be used here
+		InvalidArgument,
+
+		// You tried to release an element you do not own
+		NotOwner,
+
+		// You already own this element
+		AlreadyGiven,
+
+		// Another plugin owns this element
+		AlreadyTaken,
+	};
+
+	// What a widget registration points at
+	enum class TargetType : uint8_t
+	{
+		// Name of a menu in the UI menu map. Its _root receives the alpha.
+		Menu,
+
+		// SWF file of a menu's movie (e.g. "MyWidget.swf"), matched against the end of the movie URL.
+		// Bound to the owning menu the next time ImmersiveHUD scans the open menus.
+		Movie,
+
+		// Full path of a clip in the HUD Menu movie (e.g. "_root.MyWidgetHolder.widget").
+		// Receives alpha and visibility.
+		Clip,
+	};
+
+	// Fade channels. Values match ImmersiveHUD's widget modes.
+	enum class Channel : uint8_t
+	{
+		Visible = 0,    // HUD opacity maximum
+		Immersive = 1,  // Main HUD fade
+		Hidden = 2,     // Always 0
+		Ignored = 3,    // Never written. Cannot be subscribed to.
+		Interior = 4,
+		Exterior = 5,
+		InCombat = 6,
+		NotInCombat = 7,
+		WeaponDrawn = 8,
+		LockedOn = 9,
+	};
+
+	constexpr std::size_t ChannelCount = 10;
+
+	// Owner reported for elements ImmersiveHUD controls itself
+	constexpr SKSE::PluginHandle NoOwner = static_cast<SKSE::PluginHandle>(-1);
+
+	// Owner of claims ImmersiveHUD makes on behalf of plugins that do not use this API
+	constexpr SKSE::PluginHandle CompatOwner = static_cast<SKSE::PluginHandle>(-2);
+
+	// Pseudo element: the detection-level fade of the vanilla stealth meter. Claim it if your plugin draws its own
+	// detection indicator; the vanilla meter then only follows the HUD fade and aiming.
+	constexpr const auto DetectionElementId = "Detection";
+
+	// Called on the UI thread with the channel's alpha (0-100) when it changes, and once after subscribing.
+	// While the HUD is hidden by menus every channel reports 0.
+	using AlphaCallback = void (*)(Channel a_channel, float a_alpha, void* a_userData);
+
+	// Called on the claiming or releasing thread when an element changes owner (NoOwner: back to ImmersiveHUD).
+	using OwnershipCallback = void (*)(const char* a_elementId, SKSE::PluginHandle a_owner, void* a_userData);
+
+	// ImmersiveHUD's modder interface, all methods are thread safe
+	class IVImmersiveHUD1
+	{
+	public:
+		/// <summary>
+		/// Hands a widget to ImmersiveHUD under a stable id. The target is controlled from the next frame on.
+		/// </summary>
+		/// <param name="a_id">Stable id of your widget, e.g. "MyMod.Compass"</param>
+		/// <param name="a_type">What a_target names</param>
+		/// <param name="a_target">Menu name, SWF file or clip path</param>
+		/// <param name="a_channel">Channel the widget follows</param>
+		/// <returns>OK, AlreadyRegistered, InvalidArgument</returns>
+		virtual APIResult RegisterWidget(const char* a_id, TargetType a_type, const char* a_target, Channel a_channel) noexcept = 0;
+
+		/// <summary>
+		/// Releases a widget. Its target is restored to full alpha and made visible.
+		/// </summary>
+		/// <param name="a_id">Id passed to RegisterWidget</param>
+		/// <returns>OK, NotRegistered</returns>
+		virtual APIResult UnregisterWidget(const char* a_id) noexcept = 0;
+
+		/// <summary>
+		/// Moves a registered widget to another channel.
+		/// </summary>
+		/// <param name="a_id">Id passed to RegisterWidget</param>
+		/// <param name="a_channel">New channel</param>
+		/// <returns>OK, NotRegistered, InvalidArgument</returns>
+		virtual APIResult SetWidgetChannel(const char* a_id, Channel a_channel) noexcept = 0;
+
+		/// <summary>
+		/// Subscribes to alpha changes of a channel, for widgets that apply the alpha themselves.
+		/// </summary>
+		/// <param name="a_channel">Channel to follow</param>
+		/// <param name="a_callback">Called on the UI thread</param>
+		/// <param name="a_userData">Passed back to the callback</param>
+		/// <returns>OK, AlreadyRegistered, InvalidArgument</returns>
+		virtual APIResult SubscribeChannel(Channel a_channel, AlphaCallback a_callback, void* a_userData) noexcept = 0;
+
+		/// <summary>
+		/// Removes a subscription. The callback may still run once during the current frame.
+		/// </summary>
+		/// <param name="a_channel">Channel passed to SubscribeChannel</param>
+		/// <param name="a_callback">Callback passed to SubscribeChannel</param>
+		/// <param name="a_userData">User data passed to SubscribeChannel</param>
+		/// <returns>OK, NotRegistered</returns>
+		virtual APIResult UnsubscribeChannel(Channel a_channel, AlphaCallback a_callback, void* a_userData) noexcept = 0;
+
+		/// <summary>
+		/// Returns the alpha (0-100) ImmersiveHUD applied to a channel on the last frame.
+		/// </summary>
+		/// <param name="a_channel">Channel to query</param>
+		[[nodiscard]] virtual float GetChannelAlpha(Channel a_channel) const noexcept = 0;
+
+		/// <summary>
+		/// Returns true if the HUD was drawn on the last frame: not hidden by menus and above 0 alpha.
+		/// </summary>
+		[[nodiscard]] virtual bool IsHUDShown() const noexcept = 0;
+
+		/// <summary>
+		/// Returns true if the player has toggled the HUD on with the ImmersiveHUD hotkey.
+		/// </summary>
+		[[nodiscard]] virtual bool IsToggledOn() const noexcept = 0;
+	};
+
+	// Element ownership. Element ids are the ids ImmersiveHUD's MCM uses: vanilla elements by INI id
+	// (e.g. "iMode_StealthMeter"), external menus by menu name and widgets by their discovered path.
+	// ImmersiveHUD does not write to an element while another plugin owns it.
+	class IVImmersiveHUD2 : public IVImmersiveHUD1
+	{
+	public:
+		/// <summary>
+		/// Takes control of an element. It is handed over at full alpha and visible on the next frame.
+		/// </summary>
+		/// <param name="a_myPluginHandle">Your assigned plugin handle</param>
+		/// <param name="a_elementId">Element id</param>
+		/// <returns>OK, AlreadyGiven, AlreadyTaken, InvalidArgument</returns>
+		virtual APIResult ClaimElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept = 0;
+
+		/// <summary>
+		/// Returns control of an element to ImmersiveHUD.
+		/// </summary>
+		/// <param name="a_myPluginHandle">Your assigned plugin handle</param>
+		/// <param name="a_elementId">Element id</param>
+		/// <returns>OK, NotOwner</returns>
+		virtual APIResult ReleaseElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept = 0;
+
+		/// <summary>
+		/// Returns the plugin controlling an element, or NoOwner if ImmersiveHUD controls it.
+		/// </summary>
+		/// <param name="a_elementId">Element id</param>
+		[[nodiscard]] virtual SKSE::PluginHandle GetElementOwner(const char* a_elementId) const noexcept = 0;
+
+		/// <summary>
+		/// Registers a callback for ownership changes of any element.
+		/// </summary>
+		/// <param name="a_callback">Called on the thread that claimed or released the element</param>
+		/// <param name="a_userData">Passed back to the callback</param>
+		/// <returns>OK, AlreadyRegistered, InvalidArgument</returns>
+		virtual APIResult RegisterOwnershipCallback(OwnershipCallback a_callback, void* a_userData) noexcept = 0;
+
+		/// <summary>
+		/// Removes an ownership callback.
+		/// </summary>
+		/// <param name="a_callback">Callback passed to RegisterOwnershipCallback</param>
+		/// <param name="a_userData">User data passed to RegisterOwnershipCallback</param>
+		/// <returns>OK, NotRegistered</returns>
+		virtual APIResult UnregisterOwnershipCallback(OwnershipCallback a_callback, void* a_userData) noexcept = 0;
+	};
+
+	struct PluginCommand
+	{
+		// Command types available
+		enum class Type : uint8_t
+		{
+			RequestInterface,
+		};
+
+		// Packet header
+		uint32_t header = 0x49485544;
+		// Command type to invoke
+		Type type;
+		// Pointer to data for the given command
+		void* commandStructure = nullptr;
+	};
+
+	struct InterfaceRequest
+	{
+		// Version to request
+		InterfaceVersion interfaceVersion;
+	};
+
+	struct PluginResponse
+	{
+		enum class Type : uint8_t
+		{
+			Error,
+			InterfaceProvider,
+		};
+
+		// Response type
+		Type type;
+		// Pointer to data for the given response
+		void* responseData = nullptr;
+	};
+
+	struct InterfaceContainer
+	{
+		// Pointer to interface
+		void* interfaceInstance = nullptr;
+		// Contained version
+		InterfaceVersion interfaceVersion;
+	};
+
+	using InterfaceLoaderCallback = std::function<void(
+		void* interfaceInstance, InterfaceVersion interfaceVersion)>;
+
+	/// <summary>
+	/// Initiate a request for the ImmersiveHUD API interface via SKSE's messaging system.
+	/// You must register a callback to obtain the response to this request.
+	/// Recommended: Send your request during SKSEMessagingInterface::kMessage_PostPostLoad
+	/// </summary>
+	/// <param name="skseMessaging">SKSE's messaging interface</param>
+	/// <param name="version">The interface version to request</param>
+	/// <returns>If any plugin was listening for this request, true. See skse/PluginAPI.h</returns>
+	[[nodiscard]] inline bool RequestInterface(const SKSE::MessagingInterface* skseMessaging,
+		InterfaceVersion version = InterfaceVersion::V2) noexcept
+	{
+		InterfaceRequest req = {};
+		req.interfaceVersion = version;
+
+		PluginCommand cmd = {};
+		cmd.type = PluginCommand::Type::RequestInterface;
+		cmd.commandStructure = &req;
+
+		return skseMessaging->Dispatch(
+			0,
+			&cmd, sizeof(PluginCommand),
+			ImmersiveHUDPluginName);
+	}
+
+	/// <summary>
+	/// Register the callback for obtaining the ImmersiveHUD API interface. Call only once.
+	/// Recommended: Register your callback during SKSEMessagingInterface::kMessage_PostLoad
+	/// </summary>
+	/// <param name="skseMessaging">SKSE's messaging interface</param>
+	/// <param name="callback">A callback function receiving both the interface pointer and interface version</param>
+	/// <returns></returns>
+	[[nodiscard]] inline bool RegisterInterfaceLoaderCallback(const SKSE::MessagingInterface* skseMessaging,
+		InterfaceLoaderCallback&& callback) noexcept
+	{
+		static InterfaceLoaderCallback storedCallback = callback;
+
+		return skseMessaging->RegisterListener(
+			ImmersiveHUDPluginName,
+			[](SKSE::MessagingInterface::Message* msg) {
+				if (msg->sender && strcmp(msg->sender, ImmersiveHUDPluginName) != 0)
+					return;
+				if (msg->type != 0)
+					return;
+				if (msg->dataLen != sizeof(PluginResponse))
+					return;
+
+				const auto resp = reinterpret_cast<PluginResponse*>(msg->data);
+				switch (resp->type) {
+				case PluginResponse::Type::InterfaceProvider:
+					{
+						auto interfaceContainer = reinterpret_cast<InterfaceContainer*>(resp->responseData);
+						storedCallback(
+							interfaceContainer->interfaceInstance,
+							interfaceContainer->interfaceVersion);
+						break;
+					}
+				case PluginResponse::Type::Error:
+					{
+						SKSE::log::info("ImmersiveHUD API: Error obtaining interface");
+						break;
+					}
+				default:
+					return;
+				}
+			});
+	}
+}
@@ -37,7 +37,11 @@ void Compat::InitExternalData()
 		_inpaSekiroCombatLoaded = true;
 		logger::info("Inpa Sekiro Combat detected. Relinquishing Stamina control.");
 	}
+}
 
+// Pure file parse with no game data dependency, run on the startup preload thread.
+void Compat::LoadSkyHUDConfig()
+{
 	// SkyHUD alt charge detection
 	const fs::path skyhudPath = "Data/Interface/skyhud/skyhud.txt";
 	if (fs::exists(skyhudPath)) {
@@ -145,11 +149,6 @@ bool Compat::IsSmoothCamActive()
 	return false;
 }
 
-bool Compat::IsDetectionMeterInstalled()
-{
-	return g_DetectionMeter != nullptr;
-}
-
 bool Compat::IsBTPSActive()
 {
 	return g_BTPS && g_BTPS->GetWidget3DEnabled();
@@ -172,22 +171,14 @@ bool Compat::IsFakeFirstPerson()
 	return thirdPersonState && thirdPersonState->currentZoomOffset == -0.275f;
 }
 
-bool Compat::IsImmersiveHUDDisabled()
+void Compat::PollExternalControl()
 {
 	// ImmersiveHUD is disabled when the global is set to 1
-	return g_DisableiHUD && (g_DisableiHUD->value != 0.0f);
-}
+	_immersiveHUDDisabled = g_DisableiHUD && (g_DisableiHUD->value != 0.0f);
 
-bool Compat::IsCompassAllowed()
-{
-	// Element is allowed if the "Disable" global is 0 (or if the global isn't found)
-	return !g_DisableCompass || (g_DisableCompass->value == 0.0f);
-}
-
-bool Compat::IsSneakAllowed()
-{
-	// Element is allowed if the "Disable" global is 0 (or if the global isn't found)
-	return !g_DisableSneak || (g_DisableSneak->value == 0.0f);
+	// Elements are allowed if the "Disable" global is 0 (or if the global isn't found)
+	_compassAllowed = !g_DisableCompass || (g_DisableCompass->value == 0.0f);
+	_sneakAllowed = !g_DisableSneak || (g_DisableSneak->value == 0.0f);
 }
 
 bool Compat::HasEnchantedWeapon(bool a_leftHand)
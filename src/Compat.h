@@ -10,13 +10,13 @@ class Compat : public ISingleton<Compat>
 public:
 	// Initialization
 	void InitExternalData();
+	void LoadSkyHUDConfig();
 	void ManageSmoothCamCrosshairControl(bool a_shouldBlock);
 	void ManageSmoothCamStealthControl(bool a_shouldBlock);
 
 	// Compatibility Checks
 	bool IsTDMActive();
 	bool IsSmoothCamActive();
-	bool IsDetectionMeterInstalled();
 	bool IsBTPSActive();
 	bool IsIFPVActive();
 	bool IsFakeFirstPerson();
@@ -24,9 +24,11 @@ public:
 	bool HasSmoothCamStealthControl() const;
 
 	// External Control Logic
-	bool IsImmersiveHUDDisabled();
-	bool IsCompassAllowed();
-	bool IsSneakAllowed();
+	// Legacy globals kept for existing scripts; the Papyrus natives (Papyrus.h) replace them.
+	void PollExternalControl();
+	bool IsImmersiveHUDDisabled() const { return _immersiveHUDDisabled; }
+	bool IsCompassAllowed() const { return _compassAllowed; }
+	bool IsSneakAllowed() const { return _sneakAllowed; }
 
 	// State Context Helpers
 	bool HasEnchantedWeapon(bool a_leftHand);
@@ -47,7 +49,6 @@ public:
 	SmoothCamAPI::IVSmoothCam3* g_SmoothCam = nullptr;
 	TDM_API::IVTDM2* g_TDM = nullptr;
 	BTPS_API_decl::API_V0* g_BTPS = nullptr;
-	HMODULE g_DetectionMeter = nullptr;
 	RE::TESGlobal* g_IFPV = nullptr;
 
 	// Generic HUD Control Globals (from ImmersiveHUD.esp)
@@ -59,5 +60,8 @@ private:
 	bool _hasSmoothCamCrosshairControl = false;
 	bool _hasSmoothCamStealthControl = false;
 	bool _skyHUDAltCharge = false;
+	bool _immersiveHUDDisabled = false;
+	bool _compassAllowed = true;
+	bool _sneakAllowed = true;
 	bool _inpaSekiroCombatLoaded = false;
 };
@@ -1,6 +1,7 @@
 #include "Events.h"
 #include "HUDManager.h"
 #include "Settings.h"
+#include "Trace.h"
 #include "Utils.h"
 
 namespace Events
@@ -126,6 +127,8 @@ namespace Events
 
 		const char* menuName = a_event->menuName.c_str();
 
+		Trace::RecordEvent(a_event->opening ? Trace::kMenuOpen : Trace::kMenuClose);
+
 		// -----------------------------------------------------------------
 		// LIFECYCLE MANAGEMENT
 		// -----------------------------------------------------------------
@@ -161,6 +164,8 @@ namespace Events
 			// 1. Snap HUD hidden immediately if a system menu opens
 			if (Utils::IsSystemMenu(menuName)) {
 				HUDManager::GetSingleton()->Reset(false);
+				// Game is paused: a good moment to write out buffered trace frames
+				Trace::Flush();
 			}
 			// 2. Catch widgets appearing late
 			else if (a_event->menuName != RE::HUDMenu::MENU_NAME) {
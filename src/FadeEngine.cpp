@@ -0,0 +1,283 @@
+#include "FadeEngine.h"
+#include "WidgetMode.h"
+
+namespace FadeEngine
+{
+	Targets ComputeTargets(State& a_state, const Inputs& a_inputs, const Config& a_config)
+	{
+		Targets targets;
+
+		const float hudMax = a_config.hudMax;
+		const float hudMin = a_config.hudMin;
+		const float ctxMax = a_config.ctxMax;
+		const float ctxMin = a_config.ctxMin;
+
+		bool shouldBeVisible = a_inputs.userWantsVisible;
+		if (!shouldBeVisible) {
+			if ((a_config.alwaysShowInCombat && a_inputs.isInCombat) ||
+				(a_config.alwaysShowWeaponDrawn && a_inputs.isWeaponDrawn)) {
+				shouldBeVisible = true;
+			}
+		}
+		a_state.targetAlpha = shouldBeVisible ? hudMax : hudMin;
+
+		// Per-element state targets helper
+		auto getTarget = [&](bool active) { return active ? hudMax : hudMin; };
+
+		// Per-element state targets for fancy linear fading
+		targets.interior = getTarget(a_inputs.isInterior);
+		targets.exterior = getTarget(!a_inputs.isInterior);
+		targets.combat = getTarget(a_inputs.isInCombat);
+		targets.notInCombat = getTarget(!a_inputs.isInCombat);
+		targets.weapon = getTarget(a_inputs.isWeaponDrawn);
+		targets.lockedOn = getTarget(a_inputs.isLockedOn);
+
+		// Calculate Contextual States
+		// Action: Aiming a Bow, Casting an Aimed Spell.
+		const bool isActionActive = a_inputs.isActionActive;
+		// Look: Hovering over a valid interactable object.
+		const bool isLookActive = a_inputs.isLookActive && !a_inputs.isBTPS;
+
+		// Crosshair Target Alpha
+		float targetCtx = ctxMin;
+		bool blockSmoothCam = false;
+
+		if (a_config.crosshairEnabled) {
+			bool isHiddenByAiming = a_config.crosshairHideWhileAiming && isActionActive;
+			bool isHiddenBySneaking = a_config.crosshairHideWhileSneaking && a_inputs.isSneaking;
+
+			// Visibility Authority: Merge contextual states.
+			bool shouldDrawCrosshair = (isActionActive || isLookActive);
+
+			// SmoothCam Block Logic:
+			// We block SmoothCam if we want to hide it explicitly (aiming), or if there's no reason to draw at all.
+			// We DO NOT block SmoothCam just because we are sneaking (since it draws its arc/3D crosshair in worldspace).
+			blockSmoothCam = isHiddenByAiming || !shouldDrawCrosshair;
+
+			// Alpha Calculation for 2D HUD Crosshair:
+			if (isHiddenByAiming || isHiddenBySneaking) {
+				targetCtx = 0.0f;
+			} else if (shouldDrawCrosshair) {
+				if (a_inputs.isTDM) {
+					// TDM handles rendering; vanilla is suppressed
+					targetCtx = 0.0f;
+				} else {
+					// Target 100% for active use/SmoothCam, 50% for passive interaction
+					if (isActionActive || a_inputs.isSmoothCam) {
+						targetCtx = ctxMax;
+					} else {
+						targetCtx = std::max(ctxMin, ctxMax * 0.5f);
+					}
+				}
+			} else {
+				targetCtx = ctxMin;
+			}
+		} else {
+			// If Contextual Crosshair is disabled in settings, link it to the global toggle
+			targetCtx = a_state.targetAlpha;
+			blockSmoothCam = (targetCtx <= 0.01f);
+		}
+
+		targets.ctx = targetCtx;
+		targets.blockSmoothCam = blockSmoothCam;
+
+		// Sneak Meter Target Alpha
+		float targetSneak = 0.0f;
+		float sneakFadeSpeed = a_config.fadeOutSpeed;
+		if (a_inputs.isSneaking && a_inputs.isSneakAllowed) {
+			if (a_config.sneakMeterEnabled) {
+				// Contextual Authority: detection level math mixed with global toggle state
+				float detectionAlpha = a_inputs.detectionLevel * 0.85f;
+
+				// Detection claimed by another plugin (e.g. Detection Meter):
+				// hide vanilla meter unless we are aiming (Contextual Crosshair logic).
+				if (a_config.detectionClaimed) {
+					detectionAlpha = isActionActive ? 100.0f : 0.0f;
+				}
+
+				targetSneak = std::max(detectionAlpha, a_state.currentAlpha);
+
+				// Normalize raw detection (0-100) to a 0.0-1.0 scalar.
+				float scalar = std::clamp(targetSneak / 100.0f, 0.0f, 1.0f);
+
+				// Map the scalar to the Context Opacity Range [Min, Max].
+				targetSneak = ctxMin + (scalar * (ctxMax - ctxMin));
+
+				// Determine context speed
+				sneakFadeSpeed = (targetSneak > a_state.ctxSneakAlpha) ? a_config.fadeInSpeed : a_config.fadeOutSpeed;
+
+			} else {
+				// Manual Authority: follow linear state synchronization trackers
+				switch (a_config.stealthMeterMode) {
+				case WidgetModes::kVisible:
+					targetSneak = hudMax;
+					break;
+				case WidgetModes::kInterior:
+					targetSneak = targets.interior;
+					break;
+				case WidgetModes::kExterior:
+					targetSneak = targets.exterior;
+					break;
+				case WidgetModes::kInCombat:
+					targetSneak = targets.combat;
+					break;
+				case WidgetModes::kNotInCombat:
+					targetSneak = targets.notInCombat;
+					break;
+				case WidgetModes::kWeaponDrawn:
+					targetSneak = targets.weapon;
+					break;
+				case WidgetModes::kHidden:
+					targetSneak = 0.0f;
+					break;
+				case WidgetModes::kIgnored:
+					targetSneak = 100.0f;
+					break;
+				default:
+					targetSneak = a_state.currentAlpha;
+					break;  // kImmersive
+				}
+				sneakFadeSpeed = (targetSneak > a_state.ctxSneakAlpha) ? a_config.fadeInSpeed : a_config.fadeOutSpeed;
+			}
+		} else {
+			// Player stood up or globally disabled: target hard 0
+			targetSneak = 0.0f;
+			sneakFadeSpeed = 16.0f;  // Fast-fade exit
+		}
+
+		targets.sneak = targetSneak;
+		targets.sneakFadeSpeed = sneakFadeSpeed;
+
+		// Enchantment Target Logic
+		const bool weaponsActive = a_inputs.isWeaponDrawn;
+		const bool leftEnch = a_inputs.hasLeftEnchant;
+		const bool rightEnch = a_inputs.hasRightEnchant;
+
+		targets.enchantL = (weaponsActive && leftEnch) ? hudMax : hudMin;
+		targets.enchantR = (weaponsActive && rightEnch) ? hudMax : hudMin;
+
+		// Dual-wield handshaking: forces synchronous fading regardless of equipment delay.
+		if (weaponsActive && leftEnch && rightEnch) {
+			float highest = std::max(a_state.enchantAlphaL, a_state.enchantAlphaR);
+			a_state.enchantAlphaL = highest;
+			a_state.enchantAlphaR = highest;
+		}
+
+		return targets;
+	}
+
+	void Advance(State& a_state, const Targets& a_targets, const Inputs& a_inputs, const Config& a_config)
+	{
+		// Snap to target instantly when coming out of a menu or loading to match vanilla behaviour
+		if (a_state.wasHidden) {
+			a_state.currentAlpha = a_state.targetAlpha;
+			a_state.enchantAlphaL = a_targets.enchantL;
+			a_state.enchantAlphaR = a_targets.enchantR;
+			a_state.interiorAlpha = a_targets.interior;
+			a_state.exteriorAlpha = a_targets.exterior;
+			a_state.combatAlpha = a_targets.combat;
+			a_state.notInCombatAlpha = a_targets.notInCombat;
+			a_state.weaponAlpha = a_targets.weapon;
+			a_state.lockedOnAlpha = a_targets.lockedOn;
+			a_state.ctxAlpha = a_targets.ctx;
+			a_state.ctxSneakAlpha = a_targets.sneak;
+			a_state.wasHidden = false;
+		}
+
+		// Mixed Math Calculations (Skip if delta is 0)
+		const float delta = a_inputs.delta;
+		if (delta <= 0.0f) {
+			return;
+		}
+
+		const float speedIn = a_config.fadeInSpeed;
+		const float speedOut = a_config.fadeOutSpeed;
+		const float changeIn = speedIn * (delta * 60.0f);
+		const float changeOut = speedOut * (delta * 60.0f);
+
+		// Helper lambda for consistent linear transitions
+		auto UpdateLinear = [&](float& a_currentAlpha, float a_targetAlpha) {
+			float change = (a_currentAlpha < a_targetAlpha) ? changeIn : changeOut;
+
+			if (std::abs(a_currentAlpha - a_targetAlpha) <= change) {
+				a_currentAlpha = a_targetAlpha;
+			} else if (a_currentAlpha < a_targetAlpha) {
+				a_currentAlpha += change;
+			} else {
+				a_currentAlpha -= change;
+			}
+		};
+
+		// Global HUD & State Conditions: Linear Math (Vanilla Feel)
+		UpdateLinear(a_state.currentAlpha, a_state.targetAlpha);
+		UpdateLinear(a_state.enchantAlphaL, a_targets.enchantL);
+		UpdateLinear(a_state.enchantAlphaR, a_targets.enchantR);
+		UpdateLinear(a_state.interiorAlpha, a_targets.interior);
+		UpdateLinear(a_state.exteriorAlpha, a_targets.exterior);
+		UpdateLinear(a_state.combatAlpha, a_targets.combat);
+		UpdateLinear(a_state.notInCombatAlpha, a_targets.notInCombat);
+		UpdateLinear(a_state.weaponAlpha, a_targets.weapon);
+		UpdateLinear(a_state.lockedOnAlpha, a_targets.lockedOn);
+
+		// Crosshair: Lerp Math (Smooth Feel)
+		if (a_inputs.smoothCamOwnsCrosshair) {
+			// SmoothCam is drawing its own crosshair; force our internal alpha to 0 so we don't blip on shot release
+			a_state.ctxAlpha = 0.0f;
+		} else {
+			float ctxSpeed = (a_targets.ctx > a_state.ctxAlpha) ? speedIn : speedOut;
+			a_state.ctxAlpha = std::lerp(a_state.ctxAlpha, a_targets.ctx, delta * ctxSpeed);
+			if (std::abs(a_state.ctxAlpha - a_targets.ctx) < 0.1f) {
+				a_state.ctxAlpha = a_targets.ctx;
+			}
+		}
+
+		// Stealth Meter: Mixed Math depending on mode
+		if (a_config.sneakMeterEnabled || !a_inputs.isSneaking) {
+			a_state.ctxSneakAlpha = std::lerp(a_state.ctxSneakAlpha, a_targets.sneak, delta * a_targets.sneakFadeSpeed);
+			if (std::abs(a_state.ctxSneakAlpha - a_targets.sneak) < 0.1f) {
+				a_state.ctxSneakAlpha = a_targets.sneak;
+			}
+		} else {
+			UpdateLinear(a_state.ctxSneakAlpha, a_targets.sneak);
+		}
+	}
+
+	std::optional<Channel> GetChannel(const State& a_state, const Targets& a_targets, int a_mode, bool a_isCrosshair)
+	{
+		switch (a_mode) {
+		case WidgetModes::kIgnored:
+		case WidgetModes::kHidden:
+		case WidgetModes::kVisible:
+			return std::nullopt;
+		case WidgetModes::kInterior:
+			return Channel{ a_state.interiorAlpha, a_targets.interior };
+		case WidgetModes::kExterior:
+			return Channel{ a_state.exteriorAlpha, a_targets.exterior };
+		case WidgetModes::kInCombat:
+			return Channel{ a_state.combatAlpha, a_targets.combat };
+		case WidgetModes::kNotInCombat:
+			return Channel{ a_state.notInCombatAlpha, a_targets.notInCombat };
+		case WidgetModes::kWeaponDrawn:
+			return Channel{ a_state.weaponAlpha, a_targets.weapon };
+		case WidgetModes::kLockedOn:
+			return Channel{ a_state.lockedOnAlpha, a_targets.lockedOn };
+		default:
+			return a_isCrosshair ? Channel{ a_state.ctxAlpha, a_targets.ctx } : Channel{ a_state.currentAlpha, a_state.targetAlpha };
+		}
+	}
+
+	double QuantizeAlpha(double a_alpha, double a_step, double a_end)
+	{
+		if (a_step <= 0.0 || a_alpha <= 0.0) {
+			return a_alpha;
+		}
+		// Written as the target itself: an earlier frame may already have been clamped there
+		if (std::abs(a_alpha - a_end) <= 0.01) {
+			return a_end;
+		}
+
+		// Never snap past the end target
+		const double quantized = std::round(a_alpha / a_step) * a_step;
+		return a_alpha < a_end ? std::min(quantized, a_end) : std::max(quantized, a_end);
+	}
+}
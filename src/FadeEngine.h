@@ -0,0 +1,107 @@
+#pragma once
+
+// Fade and mode math behind HUDManager::Update.
+// Takes no game pointers: everything it reads is sampled into Inputs/Config by the caller,
+// which lets recorded traces be replayed through the exact same code (see Trace).
+namespace FadeEngine
+{
+	// Settings snapshot used by the fade math.
+	struct Config
+	{
+		float hudMax = 100.0f;
+		float hudMin = 0.0f;
+		float ctxMax = 100.0f;
+		float ctxMin = 0.0f;
+		float fadeInSpeed = 10.0f;
+		float fadeOutSpeed = 5.0f;
+		int stealthMeterMode = 1;  // WidgetModes::WidgetMode of the stealth meter (manual authority)
+		bool alwaysShowInCombat = false;
+		bool alwaysShowWeaponDrawn = false;
+		bool crosshairEnabled = true;
+		bool crosshairHideWhileAiming = false;
+		bool crosshairHideWhileSneaking = false;
+		bool sneakMeterEnabled = true;
+		bool detectionClaimed = false;  // Another plugin draws the detection level (plugin API "Detection" claim)
+
+		bool operator==(const Config&) const = default;
+	};
+
+	// Game state sampled once per frame.
+	struct Inputs
+	{
+		float delta = 0.0f;
+		float detectionLevel = 0.0f;
+		bool userWantsVisible = false;
+		bool shouldHide = false;
+		bool isInterior = false;
+		bool isInCombat = false;
+		bool isWeaponDrawn = false;
+		bool isSneaking = false;
+		bool isSneakAllowed = true;
+		bool isLockedOn = false;
+		bool isSmoothCam = false;
+		bool isTDM = false;
+		bool isBTPS = false;
+		bool isActionActive = false;
+		bool isLookActive = false;
+		bool hasLeftEnchant = false;
+		bool hasRightEnchant = false;
+		// SmoothCam is drawing its own crosshair. Sampled after the frame's control request.
+		bool smoothCamOwnsCrosshair = false;
+	};
+
+	// Per-channel alpha carried between frames. Default values match HUDManager::Reset.
+	struct State
+	{
+		float currentAlpha = 0.0f;
+		float targetAlpha = 0.0f;
+		float ctxAlpha = 0.0f;
+		float ctxSneakAlpha = 0.0f;
+		float enchantAlphaL = 0.0f;
+		float enchantAlphaR = 0.0f;
+		float interiorAlpha = 0.0f;
+		float exteriorAlpha = 0.0f;
+		float combatAlpha = 0.0f;
+		float notInCombatAlpha = 0.0f;
+		float weaponAlpha = 0.0f;
+		float lockedOnAlpha = 0.0f;
+		bool wasHidden = true;
+	};
+
+	// Targets resolved for the current frame.
+	struct Targets
+	{
+		float interior = 0.0f;
+		float exterior = 0.0f;
+		float combat = 0.0f;
+		float notInCombat = 0.0f;
+		float weapon = 0.0f;
+		float lockedOn = 0.0f;
+		float enchantL = 0.0f;
+		float enchantR = 0.0f;
+		float ctx = 0.0f;
+		float sneak = 0.0f;
+		float sneakFadeSpeed = 0.0f;
+		bool blockSmoothCam = false;
+	};
+
+	// Resolves the frame's targets. Also applies dual-wield enchantment handshaking to a_state.
+	Targets ComputeTargets(State& a_state, const Inputs& a_inputs, const Config& a_config);
+
+	// Snaps after a hidden period, then steps every channel towards its target by a_inputs.delta.
+	void Advance(State& a_state, const Targets& a_targets, const Inputs& a_inputs, const Config& a_config);
+
+	// A fading alpha: its value this frame and the end target it is heading for.
+	struct Channel
+	{
+		float current;
+		float end;
+	};
+
+	// Channel a widget mode's alpha is stepped on, or nullopt for modes with a fixed alpha.
+	std::optional<Channel> GetChannel(const State& a_state, const Targets& a_targets, int a_mode, bool a_isCrosshair = false);
+
+	// Output quantization (fAlphaStep) of a channel fading towards a_end: mid-fade alphas snap to a_step.
+	// 0 passes through, anything within 0.01 of a_end is written as a_end, and the result never passes a_end.
+	double QuantizeAlpha(double a_alpha, double a_step, double a_end);
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Profiler.h"
+
+// Thin layer over the Scaleform operations used by the per-frame apply path.
+// Routing them through one place lets the Profiler count calls per frame (bDumpPerfStats).
+// The operations are written against the Value/Movie concepts below rather than RE types: the plugin
+// passes RE::GFxValue and RE::GFxMovieView, the host tests an in-memory tree (tests/MockScaleform.h).
+namespace GFxOps
+{
+	// Display properties read and written through a value. RE::GFxValue::DisplayInfo provides them natively.
+	template <class I>
+	concept DisplayInfo = std::default_initializable<I> && requires(I& a_info, const I& a_cinfo) {
+		{ a_cinfo.GetAlpha() } -> std::convertible_to<double>;
+		{ a_cinfo.GetVisible() } -> std::convertible_to<bool>;
+		a_info.SetAlpha(0.0);
+		a_info.SetVisible(true);
+	};
+
+	// The subset of RE::GFxValue used by the apply and discovery paths. VisitMembers(F) is also
+	// required, with F called as (const char* name, const V& value) for every member.
+	template <class V>
+	concept Value = std::default_initializable<V> && std::constructible_from<V, double> && std::constructible_from<V, bool> &&
+	                DisplayInfo<typename V::DisplayInfo> &&
+	                requires(V& a_val, const V& a_cval, const char* a_name, V* a_out, typename V::DisplayInfo* a_info,
+		                const typename V::DisplayInfo& a_cinfo, const V* a_args) {
+		{ a_cval.IsObject() } -> std::convertible_to<bool>;
+		{ a_cval.IsDisplayObject() } -> std::convertible_to<bool>;
+		{ a_cval.IsArray() } -> std::convertible_to<bool>;
+		{ a_cval.IsString() } -> std::convertible_to<bool>;
+		{ a_cval.IsNumber() } -> std::convertible_to<bool>;
+		{ a_cval.IsBool() } -> std::convertible_to<bool>;
+		{ a_cval.IsUndefined() } -> std::convertible_to<bool>;
+		{ a_cval.GetString() } -> std::convertible_to<const char*>;
+		{ a_cval.GetNumber() } -> std::convertible_to<double>;
+		{ a_cval.GetBool() } -> std::convertible_to<bool>;
+		{ a_cval.GetMember(a_name, a_out) } -> std::convertible_to<bool>;
+		{ a_cval.GetDisplayInfo(a_info) } -> std::convertible_to<bool>;
+		{ a_val.SetDisplayInfo(a_cinfo) } -> std::convertible_to<bool>;
+		{ a_val.SetMember(a_name, a_cval) } -> std::convertible_to<bool>;
+		{ a_val.Invoke(a_name, a_out, a_args, 1u) } -> std::convertible_to<bool>;
+	};
+
+	// The subset of RE::GFxMovieView used alongside Value.
+	template <class M, class V>
+	concept Movie = Value<V> && requires(M& a_movie, V* a_out, const char* a_path) {
+		{ a_movie.GetVariable(a_out, a_path) } -> std::convertible_to<bool>;
+		a_movie.CreateObject(a_out);
+	};
+
+	template <class M, class V>
+		requires Movie<M, V>
+	inline bool GetVariable(M* a_movie, V* a_val, const char* a_path)
+	{
+		Profiler::CountCall(Profiler::Call::kGetVariable);
+		return a_movie->GetVariable(a_val, a_path);
+	}
+
+	template <Value V>
+	inline bool GetMember(const V& a_obj, const char* a_name, V* a_val)
+	{
+		Profiler::CountCall(Profiler::Call::kGetMember);
+		return a_obj.GetMember(a_name, a_val);
+	}
+
+	template <Value V>
+	inline bool GetDisplayInfo(const V& a_obj, typename V::DisplayInfo* a_info)
+	{
+		Profiler::CountCall(Profiler::Call::kGetDisplayInfo);
+		return a_obj.GetDisplayInfo(a_info);
+	}
+
+	// How _alpha/_visible are written (iAlphaWritePath). Switchable at runtime so both can be profiled in game.
+	enum class AlphaWritePath : std::uint32_t
+	{
+		kDisplayInfo,  // SetDisplayInfo carrying only the alpha/visible fields
+		kMember        // SetMember("_alpha") / SetMember("_visible")
+	};
+
+	inline std::atomic<AlphaWritePath> g_alphaWritePath{ AlphaWritePath::kDisplayInfo };
+
+	inline void SetAlphaWritePath(AlphaWritePath a_path)
+	{
+		g_alphaWritePath.store(a_path, std::memory_order_relaxed);
+	}
+
+	// Writes only the given properties; the rest of the display transform is left untouched.
+	template <Value V>
+	inline bool SetAlphaVisible(V& a_obj, std::optional<double> a_alpha, std::optional<bool> a_visible)
+	{
+		if (a_alpha) {
+			Profiler::Count(Profiler::Counter::kAlphaWrites);
+		}
+
+		if (g_alphaWritePath.load(std::memory_order_relaxed) == AlphaWritePath::kMember) {
+			bool result = true;
+			if (a_alpha) {
+				Profiler::CountCall(Profiler::Call::kSetMember);
+				result = a_obj.SetMember("_alpha", V(*a_alpha)) && result;
+			}
+			if (a_visible) {
+				Profiler::CountCall(Profiler::Call::kSetMember);
+				result = a_obj.SetMember("_visible", V(*a_visible)) && result;
+			}
+			return result;
+		}
+
+		// A fresh DisplayInfo only flags the fields set on it, so nothing else is marshalled or applied
+		Profiler::CountCall(Profiler::Call::kSetAlphaVisible);
+		typename V::DisplayInfo info;
+		if (a_alpha) {
+			info.SetAlpha(*a_alpha);
+		}
+		if (a_visible) {
+			info.SetVisible(*a_visible);
+		}
+		return a_obj.SetDisplayInfo(info);
+	}
+
+	template <Value V>
+	inline bool SetAlpha(V& a_obj, double a_alpha)
+	{
+		return SetAlphaVisible(a_obj, a_alpha, std::nullopt);
+	}
+
+	template <Value V>
+	inline bool SetVisible(V& a_obj, bool a_visible)
+	{
+		return SetAlphaVisible(a_obj, std::nullopt, a_visible);
+	}
+
+	// Hands an _alpha transition to Scaleform's MovieClip.tweenTo extension, which interpolates natively
+	// during Advance. Returns false if the extension is unavailable on this movie or clip.
+	template <class M, class V>
+		requires Movie<M, V>
+	inline bool TweenAlpha(M* a_movie, V& a_clip, double a_alpha, double a_seconds)
+	{
+		// tweenTo only exists while the movie has GFx extensions enabled. Only movies that enabled them
+		// themselves are tweened: switching them on changes how a foreign movie's own ActionScript behaves.
+		V extensions;
+		if (!a_movie->GetVariable(&extensions, "_global.gfxExtensions") || !extensions.IsBool() || !extensions.GetBool()) {
+			return false;
+		}
+
+		V tweenTo;
+		if (!GetMember(a_clip, "tweenTo", &tweenTo) || tweenTo.IsUndefined()) {
+			return false;
+		}
+
+		V props;
+		a_movie->CreateObject(&props);
+		props.SetMember("_alpha", V(a_alpha));
+
+		Profiler::CountCall(Profiler::Call::kInvoke);
+		V args[] = { V(a_seconds), props };
+		return a_clip.Invoke("tweenTo", nullptr, args, 2);
+	}
+
+	// Stops a running tweenTo so direct writes are not overwritten on the next Advance.
+	template <Value V>
+	inline void EndTween(V& a_clip)
+	{
+		Profiler::CountCall(Profiler::Call::kInvoke);
+		a_clip.Invoke("tweenEnd", nullptr, nullptr, 0);
+	}
+
+	template <Value V, class F>
+	inline void VisitMembers(const V& a_obj, F&& a_visitor)
+	{
+		Profiler::CountCall(Profiler::Call::kVisitMembers);
+		a_obj.VisitMembers(std::forward<F>(a_visitor));
+	}
+
+	template <Value V>
+	inline bool Invoke(V& a_obj, const char* a_name, V* a_result, const V* a_args, std::uint32_t a_numArgs)
+	{
+		Profiler::CountCall(Profiler::Call::kInvoke);
+		return a_obj.Invoke(a_name, a_result, a_args, a_numArgs);
+	}
+}
@@ -0,0 +1,1522 @@
+#pragma once
+
+#include "FadeEngine.h"
+#include "GFxOps.h"
+#include "HUDElements.h"
+#include "Profiler.h"
+#include "StringKernels.h"
+#include "WidgetMode.h"
+
+// Per-frame alpha application behind HUDManager::ApplyAlphaToHUD: vanilla HUD elements, discovered widgets
+// and external menu roots. Written against the GFxOps Value/Movie concepts, so the plugin runs it on
+// RE::GFxValue and the host tests run the same code over an in-memory movie (tests/MockScaleform.h).
+// Game state is sampled into a Frame by the caller; settings and ownership are read through a Host.
+namespace HUDApply
+{
+	using enum WidgetModes::WidgetMode;
+
+	// Visibility hysteresis: inside the band around a cut-off the clip keeps its current state,
+	// so alphas hovering at the threshold (pulses, quantization) do not flip _visible every frame.
+	inline bool ApplyVisibleHysteresis(bool a_target, bool a_current, double a_alpha, double a_threshold)
+	{
+		return (a_alpha > a_threshold * 0.5 && a_alpha <= a_threshold * 2.0) ? a_current : a_target;
+	}
+
+	// Protect penalty bars: low-health/survival blinking uses these names.
+	inline bool IsAnimatedChild(std::string_view a_name)
+	{
+		return StringKernels::FindNoCase(a_name, "flash") != std::string_view::npos ||
+		       StringKernels::FindNoCase(a_name, "blink") != std::string_view::npos ||
+		       StringKernels::FindNoCase(a_name, "penalty") != std::string_view::npos;
+	}
+
+	// Visibility Hammer: aggressively forces a DisplayObject to be visible and at 100 alpha.
+	// Used to fix vanilla enchantment charge meter visibility issues, required for unlabeled children.
+	// Returns false if the child no longer resolves (removed or unloaded).
+	template <GFxOps::Value V>
+	bool HammerChild(V& a_child, bool a_skipAlpha)
+	{
+		typename V::DisplayInfo d;
+		if (!GFxOps::GetDisplayInfo(a_child, &d)) {
+			return false;
+		}
+
+		std::optional<double> alpha;
+		std::optional<bool> visible;
+		if (!d.GetVisible()) {
+			visible = true;
+		}
+
+		// Force 100 alpha to skip vanilla fade-ins while ScaleX handles draining. Animated clips keep theirs.
+		if (!a_skipAlpha && d.GetAlpha() < 100.0) {
+			alpha = 100.0;
+		}
+
+		if (alpha || visible) {
+			GFxOps::SetAlphaVisible(a_child, alpha, visible);
+		}
+		return true;
+	}
+
+	// Game and settings state sampled once per ApplyAlphaToHUD call.
+	struct Frame
+	{
+		float timer = 0.0f;  // HUDManager::_timer
+		float globalAlpha = 0.0f;
+		FadeEngine::State fade;
+		FadeEngine::Targets targets;
+		float fadeInSpeed = 10.0f;
+		float fadeOutSpeed = 5.0f;
+		float hudMax = 100.0f;
+		float alphaStep = 1.0f;
+		float detectionLevel = 0.0f;
+		bool nativeTweens = false;
+		bool sneakMeterEnabled = true;
+		bool menuOpen = false;  // HUDManager::ShouldHideHUD
+		bool consoleOpen = false;
+		bool isSneaking = false;
+		bool compassAllowed = true;
+		bool skyHUDAltCharge = false;
+		bool inpaSekiro = false;
+		bool smoothCam = false;
+		bool smoothCamCrosshairControl = false;
+		bool weaponDrawn = false;
+		bool enchantedLeft = false;
+		bool enchantedRight = false;
+		bool enchantFullLeft = false;
+		bool enchantFullRight = false;
+	};
+
+	// Settings and plugin API state the apply path queries per element and widget.
+	template <class H>
+	concept Host = requires(const H& a_host, std::size_t a_index, std::string_view a_path) {
+		{ a_host.IsElementClaimed(a_index) } -> std::convertible_to<bool>;
+		{ a_host.GetElementMode(a_index, a_path) } -> std::convertible_to<int>;  // HUDElements::Get()[a_index]
+		{ a_host.GetWidgetMode(a_path) } -> std::convertible_to<int>;
+		{ a_host.IsWidgetSkipped(a_path) } -> std::convertible_to<bool>;  // Plugin API clip or claimed path
+		{ a_host.GetWidgetPaths() } -> std::ranges::range;
+		{ a_host.GetSourceGeneration() } -> std::convertible_to<std::uint32_t>;
+		{ a_host.GetSourceGeneration(a_path) } -> std::convertible_to<std::uint32_t>;
+		{ a_host.GetWidgetSource(a_path) } -> std::convertible_to<std::string_view>;
+	};
+
+	template <class M, class V>
+	class Applier
+	{
+		static_assert(GFxOps::Movie<M, V>);
+
+	public:
+		using DisplayInfo = typename V::DisplayInfo;
+
+		// Starts an ApplyAlphaToHUD pass with the state sampled for it.
+		void BeginFrame(const Frame& a_frame)
+		{
+			_frame = a_frame;
+			_applyFrame++;
+		}
+
+		// HUD Menu: the hardcoded elements, then the discovered widgets listed by a_host.
+		template <Host H>
+		void ApplyHUD(M* a_movie, const H& a_host);
+
+		// External menu root in a_mode. Menus the caller does not manage never get here.
+		void ApplyMenu(M* a_movie, std::string_view a_menuName, int a_mode);
+
+		// Claimed by another controller through the plugin API: handed back at full alpha and visible.
+		void HandOverElement(M* a_movie, const HUDElements::Def& a_def);
+		void HandOverPath(M* a_movie, const char* a_clipPath, std::string_view a_key);
+
+		// The HUD movie was reloaded or a scan reported new content: cached handles and absent paths are dropped.
+		void InvalidateLayout();
+
+		// HUDManager::Reset restarts the timer at 0. Pending retries keep their remaining delay.
+		void RestartTimer(float a_oldTimer);
+
+		// New session: every per-path state is dropped.
+		void ResetSession();
+
+		void DumpContention() const;
+
+	private:
+		// Runtime Verification
+		// Dynamic widget slots are only controlled while their live _url matches the cached source.
+		struct PathVerification
+		{
+			enum class Status : std::uint8_t
+			{
+				kUnresolved,  // Not checked yet, or the element/_url could not be read
+				kVerified,    // Live source matches the cache
+				kMismatched   // Slot holds a different widget (SkyUI index shift)
+			};
+
+			static constexpr float kRetryBase = 0.25f;
+			static constexpr float kRetryMaxUnresolved = 1.0f;
+			static constexpr float kRetryMaxMismatched = 8.0f;
+
+			// Exponential backoff so failing slots are not re-read every frame
+			void Fail(Status a_status, float a_now)
+			{
+				status = a_status;
+				const float maxDelay = a_status == Status::kMismatched ? kRetryMaxMismatched : kRetryMaxUnresolved;
+				retryAt = a_now + std::min(kRetryBase * static_cast<float>(1u << failures), maxDelay);
+				failures = static_cast<std::uint8_t>(std::min(failures + 1, 8));
+			}
+
+			Status status = Status::kUnresolved;
+			std::uint8_t failures = 0;
+			std::uint32_t generation = 0;  // Settings source generation this state was last validated against
+			float retryAt = 0.0f;          // Frame::timer value of the next check while not verified
+		};
+		std::unordered_map<std::string, PathVerification, StringKernels::TransparentStringHash, std::equal_to<>> _pathVerification;
+
+		// Negative Lookup Cache
+		// HUDElements lists alternate paths per element (vanilla, SkyHUD, ...); only one layout exists in a given movie.
+		// Absent paths are skipped until the entry expires, the HUD movie is reloaded or a scan reports a layout change.
+		// Expiry catches clips a mod creates later without any scan noticing.
+		static constexpr float kAbsentRetryInterval = 5.0f;
+		std::unordered_map<const char*, float> _absentElementPaths;  // Path -> timer value of the next probe
+
+		bool IsAbsentPath(const char* a_path) const
+		{
+			const auto it = _absentElementPaths.find(a_path);
+			return it != _absentElementPaths.end() && _frame.timer < it->second;
+		}
+		void MarkAbsentPath(const char* a_path) { _absentElementPaths[a_path] = _frame.timer + kAbsentRetryInterval; }
+
+		// Visibility Hammer Cache
+		// Child handles of each enforced parent, classified once. A pass only touches these handles; the
+		// hierarchy is walked again when one of them stops resolving (removed, or its parent was replaced),
+		// when the parent's direct children differ at the periodic layout check, or when the movie or
+		// widget layout changes.
+		struct HammerCache
+		{
+			struct Child
+			{
+				V value;
+				bool skipAlpha;  // Animated penalty/blink clip: forced visible only
+			};
+
+			static constexpr float kLayoutCheckInterval = 2.0f;
+
+			std::vector<Child> children;
+			std::uint32_t directChildren = 0;  // Display children of the parent itself at the last walk
+			std::string lastChild;             // Name of the last of them, so a swap that keeps the count is seen
+			float layoutCheckAt = 0.0f;        // Frame::timer value of the next direct children comparison
+		};
+		std::unordered_map<const char*, HammerCache> _hammerCache;
+
+		static void CollectHammerChildren(const V& a_parent, int a_depth, std::vector<typename HammerCache::Child>& a_out);
+		static void WalkHammerChildren(const V& a_parent, int a_depth, HammerCache& a_cache);
+		static bool HammerLayoutMatches(const V& a_parent, const HammerCache& a_cache);
+
+		// Parent-Coalesced Elements
+		// While every element coalesced onto a declared parent (HUDElements::ParentMembers) resolves to one target,
+		// the alpha goes to the parent alone and the clips below it are held at 100 alpha. Their handles are cached
+		// when coalescing starts and one of them is read back per frame, so a clip the engine or SkyHUD fades on its
+		// own is caught within a few frames without resolving any path. A parent with display children outside its
+		// members is never coalesced. The parent is restored when coalescing stops.
+		struct ParentGroup
+		{
+			struct Held
+			{
+				V value;
+				bool shoutMeter;  // Subject to the shout meter depth fix
+			};
+
+			V parent;
+			std::vector<Held> held;
+			std::size_t nextCheck = 0;
+			std::uint32_t decidedFrame = 0;  // _applyFrame of the last decision
+			bool coalesced = false;          // Decision for decidedFrame
+			bool active = false;
+			bool rejected = false;  // Parent owns other display children
+		};
+		std::unordered_map<const char*, ParentGroup> _parentGroups;
+
+		template <Host H>
+		bool ApplyParentGroup(M* a_movie, const H& a_host, const char* a_parent);
+		static void RestoreParentGroup(ParentGroup& a_group);
+		void ReleaseParentGroups();
+
+		// Native Tweening (bNativeTweens)
+		// External menu roots and dynamic widgets get each fade handed to Scaleform once; C++ only steps in
+		// when the end target changes, the fade is interrupted, or the clip is at rest.
+		struct TweenTrack
+		{
+			double end = 0.0;
+			bool running = false;
+			bool unsupported = false;  // tweenTo missing, or GFx extensions off in this movie: C++ stepping only
+		};
+		std::unordered_map<std::string, TweenTrack, StringKernels::TransparentStringHash, std::equal_to<>> _tweens;
+
+		// Render Culling
+		// External menu roots only receive alpha, so fully transparent menus were still drawn every frame.
+		// After kHoldTime at 0 alpha the root is hidden; it is shown again one frame before its channel fades in.
+		struct MenuCull
+		{
+			static constexpr float kHoldTime = 0.5f;
+
+			float zeroSince = -1.0f;  // Frame::timer value when the root reached 0 alpha, or -1
+			bool culled = false;
+		};
+		std::unordered_map<std::string, MenuCull, StringKernels::TransparentStringHash, std::equal_to<>> _menuCulling;
+
+		// Write Contention
+		// Elements whose _alpha is also animated by their own SWF or another mod. The shadow of our last write is
+		// compared with the value read back on the next frame; overwrites are counted over the last kWindow writes.
+		// Contended third-party elements (widgets, external menus) fall back to one write per kBackoffInterval.
+		struct Contention
+		{
+			static constexpr std::uint32_t kWindow = 64;
+			static constexpr int kThreshold = 16;
+			static constexpr double kTolerance = 0.5;
+			static constexpr float kBackoffInterval = 0.5f;
+
+			std::uint64_t history = 0;  // One bit per observed write, newest in bit 0: 1 = overwritten
+			double shadow = -1.0;       // Last alpha we wrote, or -1
+			std::uint32_t shadowFrame = 0;
+			float nextWriteAt = 0.0f;
+			bool contended = false;
+			bool hinted = false;
+		};
+		std::unordered_map<std::string, Contention, StringKernels::TransparentStringHash, std::equal_to<>> _contention;
+		std::uint32_t _applyFrame = 0;
+
+		// Fading
+		std::optional<FadeEngine::Channel> GetFadeChannel(int a_mode, bool a_isCrosshair = false) const
+		{
+			return FadeEngine::GetChannel(_frame.fade, _frame.targets, a_mode, a_isCrosshair);
+		}
+		double QuantizeAlpha(double a_alpha, const std::optional<FadeEngine::Channel>& a_channel) const
+		{
+			return a_channel ? FadeEngine::QuantizeAlpha(a_alpha, _frame.alphaStep, a_channel->end) : a_alpha;
+		}
+		bool TryNativeTween(M* a_movie, V& a_clip, std::string_view a_key, int a_mode, double a_frameAlpha, bool a_managesVisibility);
+		bool BeginAlphaWrite(std::string_view a_key, double a_readAlpha, double a_alpha, bool a_allowBackoff);
+		bool UpdateMenuCulling(V& a_root, std::string_view a_menuName, int a_mode, double a_frameAlpha);
+		void RestoreCulledMenu(M* a_movie, std::string_view a_menuName);
+
+		// Child Visibility Enforcement
+		// a_cacheKey identifies the parent across frames (static element path or member name).
+		void EnforceHMSMeterVisible(V& a_parent, const char* a_cacheKey, bool a_forcePermanent = false);
+		void EnforceEnchantMeterVisible(V& a_parent, const char* a_cacheKey);
+		void EnforceChildrenVisible(V& a_parent, const char* a_cacheKey, int a_depth);
+		void EnforceIgnoredVisibility(V& a_target);
+
+		// Enchantment Bar Helper Functions
+		static bool IsEnchantmentElement(const char* a_elementId, bool& a_isLeft, bool& a_isRight, bool& a_isSkyHUD);
+		float CalculateEnchantmentIgnoredAlpha(bool a_isEnchantLeft, bool a_isEnchantSkyHUD, float a_alphaL, float a_alphaR) const;
+		void ApplySkyHUDSubMeter(V& a_parent, const char* a_memberName, bool a_shouldBeVisible, bool a_callHammer);
+		void ApplySkyHUDEnchantment(V& a_elem, float a_alphaL, float a_alphaR, float a_managedAlpha, int a_mode, bool a_isIgnoredMode);
+		static double CalculateEnchantmentTargetAlpha(bool a_isEnchantLeft, bool a_isEnchantSkyHUD, int a_mode,
+			float a_alphaL, float a_alphaR, double a_managedAlpha);
+
+		double ResolveElementTarget(const HUDElements::Def& a_def, int a_mode, bool& a_shouldBeVisible) const;
+		void FixShoutMeterDepth(V& a_shout);
+
+		template <Host H>
+		void ApplyElements(M* a_movie, const H& a_host);
+		template <Host H>
+		void ApplyWidgets(M* a_movie, const H& a_host);
+
+		Frame _frame;
+		float _lastShoutMeterFixTime = 0.0f;
+	};
+
+	// ==========================================
+	// Session State
+	// ==========================================
+
+	template <class M, class V>
+	void Applier<M, V>::InvalidateLayout()
+	{
+		_absentElementPaths.clear();
+		_hammerCache.clear();
+		ReleaseParentGroups();
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::RestartTimer(float a_oldTimer)
+	{
+		for (auto& [path, verification] : _pathVerification) {
+			if (verification.status != PathVerification::Status::kVerified) {
+				verification.retryAt = std::max(verification.retryAt - a_oldTimer, 0.0f);
+			}
+		}
+		_frame.timer = 0.0f;
+		_lastShoutMeterFixTime = 0.0f;
+		InvalidateLayout();  // Refresh times are relative to the timer
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::ResetSession()
+	{
+		_pathVerification.clear();
+		InvalidateLayout();
+		_tweens.clear();
+		_menuCulling.clear();
+		_contention.clear();
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::HandOverElement(M* a_movie, const HUDElements::Def& a_def)
+	{
+		for (const char* parent : HUDElements::ParentsOf(HUDElements::IndexOf(a_def.id))) {
+			if (const auto group = _parentGroups.find(parent); group != _parentGroups.end()) {
+				RestoreParentGroup(group->second);
+				_parentGroups.erase(group);
+			}
+		}
+
+		if (!a_movie) {
+			return;
+		}
+		for (const char* rawPath : a_def.paths) {
+			V elem;
+			if (GFxOps::GetVariable(a_movie, &elem, rawPath) && elem.IsDisplayObject()) {
+				GFxOps::SetAlphaVisible(elem, 100.0, true);
+			}
+		}
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::HandOverPath(M* a_movie, const char* a_clipPath, std::string_view a_key)
+	{
+		if (const auto cull = _menuCulling.find(a_key); cull != _menuCulling.end()) {
+			_menuCulling.erase(cull);
+		}
+
+		V elem;
+		if (!a_movie || !GFxOps::GetVariable(a_movie, &elem, a_clipPath) || !elem.IsDisplayObject()) {
+			return;
+		}
+		if (const auto tween = _tweens.find(a_key); tween != _tweens.end()) {
+			if (tween->second.running) {
+				GFxOps::EndTween(elem);
+			}
+			_tweens.erase(tween);
+		}
+		GFxOps::SetAlphaVisible(elem, 100.0, true);
+	}
+
+	// ==========================================
+	//  Health/Magicka/Stamina Meter Helpers
+	// ==========================================
+
+	// Depth 0 is critical: protects Survival penalties and resource blinking from freezing.
+	template <class M, class V>
+	void Applier<M, V>::EnforceHMSMeterVisible(V& a_parent, const char* a_cacheKey, bool a_forcePermanent)
+	{
+		// Without a permanent override the engine keeps control of the children
+		if (a_forcePermanent) {
+			EnforceChildrenVisible(a_parent, a_cacheKey, 0);
+		}
+	}
+
+	// Depth 1 is critical: reaches ChargeMeter_mc to kill vanilla auto-hide logic.
+	template <class M, class V>
+	void Applier<M, V>::EnforceEnchantMeterVisible(V& a_parent, const char* a_cacheKey)
+	{
+		EnforceChildrenVisible(a_parent, a_cacheKey, 1);
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::CollectHammerChildren(const V& a_parent, int a_depth, std::vector<typename HammerCache::Child>& a_out)
+	{
+		GFxOps::VisitMembers(a_parent, [&](const char* a_name, const V& a_val) {
+			if (!a_val.IsDisplayObject()) {
+				return;
+			}
+
+			a_out.push_back({ a_val, IsAnimatedChild(a_name ? a_name : "unnamed") });
+
+			// Recurse to handle nested clips (e.g. ChargeMeter_mc).
+			if (a_depth > 0) {
+				CollectHammerChildren(a_val, a_depth - 1, a_out);
+			}
+		});
+	}
+
+	// Shallow check of the parent's own display children: count and last name, no classification or recursion.
+	template <class M, class V>
+	bool Applier<M, V>::HammerLayoutMatches(const V& a_parent, const HammerCache& a_cache)
+	{
+		std::uint32_t count = 0;
+		bool lastMatches = true;
+		GFxOps::VisitMembers(a_parent, [&](const char* a_name, const V& a_val) {
+			if (a_val.IsDisplayObject()) {
+				count++;
+				lastMatches = a_cache.lastChild == (a_name ? a_name : "");
+			}
+		});
+		return count == a_cache.directChildren && lastMatches;
+	}
+
+	// Full re-enumeration. The direct children are recorded in the same pass for the later layout checks.
+	template <class M, class V>
+	void Applier<M, V>::WalkHammerChildren(const V& a_parent, int a_depth, HammerCache& a_cache)
+	{
+		a_cache.children.clear();
+		a_cache.directChildren = 0;
+		a_cache.lastChild.clear();
+		GFxOps::VisitMembers(a_parent, [&](const char* a_name, const V& a_val) {
+			if (!a_val.IsDisplayObject()) {
+				return;
+			}
+
+			a_cache.directChildren++;
+			a_cache.lastChild = a_name ? a_name : "";
+			a_cache.children.push_back({ a_val, IsAnimatedChild(a_name ? a_name : "unnamed") });
+
+			if (a_depth > 0) {
+				CollectHammerChildren(a_val, a_depth - 1, a_cache.children);
+			}
+		});
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::EnforceChildrenVisible(V& a_parent, const char* a_cacheKey, int a_depth)
+	{
+		if (!a_parent.IsObject()) {
+			return;
+		}
+
+		Profiler::ScopedTimer timer(Profiler::Stage::kVisibilityHammer);
+
+		auto& cache = _hammerCache[a_cacheKey];
+
+		// Clips added without removing any are only seen here; the first pass always compares
+		bool walk = false;
+		if (_frame.timer >= cache.layoutCheckAt) {
+			cache.layoutCheckAt = _frame.timer + HammerCache::kLayoutCheckInterval;
+			walk = !HammerLayoutMatches(a_parent, cache);
+		}
+
+		if (!walk) {
+			for (auto& child : cache.children) {
+				if (!HammerChild(child.value, child.skipAlpha)) {
+					walk = true;
+					break;
+				}
+			}
+			if (!walk) {
+				return;
+			}
+		}
+
+		// Child set changed: walk the hierarchy again
+		WalkHammerChildren(a_parent, a_depth, cache);
+		Profiler::Count(Profiler::Counter::kHammerChildrenWalked, static_cast<std::uint32_t>(cache.children.size()));
+
+		for (auto& child : cache.children) {
+			HammerChild(child.value, child.skipAlpha);
+		}
+	}
+
+	// ==========================================
+	// Enchantment Charge Meter Helpers
+	// ==========================================
+
+	template <class M, class V>
+	bool Applier<M, V>::IsEnchantmentElement(const char* a_elementId, bool& a_isLeft, bool& a_isRight, bool& a_isSkyHUD)
+	{
+		a_isLeft = (strcmp(a_elementId, "iMode_EnchantLeft") == 0);
+		a_isRight = (strcmp(a_elementId, "iMode_EnchantRight") == 0);
+		a_isSkyHUD = (strcmp(a_elementId, "iMode_EnchantCombined") == 0);
+
+		return a_isLeft || a_isRight || a_isSkyHUD;
+	}
+
+	// kIgnored block: simulates vanilla hide-when-full while fixing the reappear bug.
+	template <class M, class V>
+	float Applier<M, V>::CalculateEnchantmentIgnoredAlpha(bool a_isEnchantLeft, bool a_isEnchantSkyHUD, float a_alphaL, float a_alphaR) const
+	{
+		if (a_isEnchantSkyHUD) {
+			return std::max(a_alphaL, a_alphaR);
+		} else {
+			bool full = a_isEnchantLeft ? _frame.enchantFullLeft : _frame.enchantFullRight;
+			float tracked = a_isEnchantLeft ? a_alphaL : a_alphaR;
+			return (_frame.menuOpen || full) ? 0.0f : tracked;
+		}
+	}
+
+	// Helper that handles visibility logic for a single SkyHUD sub-meter
+	template <class M, class V>
+	void Applier<M, V>::ApplySkyHUDSubMeter(V& a_parent, const char* a_memberName, bool a_shouldBeVisible, bool a_callHammer)
+	{
+		V sub;
+		if (GFxOps::GetMember(a_parent, a_memberName, &sub)) {
+			if (sub.IsDisplayObject()) {
+				GFxOps::SetAlphaVisible(sub, a_shouldBeVisible ? 100.0 : 0.0, a_shouldBeVisible);
+			}
+			if (a_shouldBeVisible && a_callHammer) {
+				EnforceEnchantMeterVisible(sub, a_memberName);
+			}
+		}
+	}
+
+	// Unified method that handles both IgnoredMode and Hammer cases
+	template <class M, class V>
+	void Applier<M, V>::ApplySkyHUDEnchantment(V& a_elem, float a_alphaL, float a_alphaR, float a_managedAlpha, int a_mode, bool a_isIgnoredMode)
+	{
+		bool lVal, rVal;
+
+		if (a_isIgnoredMode) {
+			// IgnoredMode: check fullness state
+			lVal = (a_alphaL > 0.01f) && !_frame.enchantFullLeft;
+			rVal = (a_alphaR > 0.01f) && !_frame.enchantFullRight;
+		} else {
+			// Hammer mode: check weapon drawn state and mode
+			lVal = _frame.weaponDrawn && _frame.enchantedLeft;
+			rVal = _frame.weaponDrawn && _frame.enchantedRight;
+
+			if (a_mode == kImmersive && a_managedAlpha < 0.1f) {
+				lVal = false;
+				rVal = false;
+			}
+		}
+
+		// Apply to all three sub-meters using helper
+		ApplySkyHUDSubMeter(a_elem, "ChargeMeterFrameAlt", lVal || rVal, true);
+		ApplySkyHUDSubMeter(a_elem, "ChargeMeterLeftAlt", lVal, true);
+		ApplySkyHUDSubMeter(a_elem, "ChargeMeterRightAlt", rVal, true);
+	}
+
+	template <class M, class V>
+	double Applier<M, V>::CalculateEnchantmentTargetAlpha(bool a_isEnchantLeft, bool a_isEnchantSkyHUD, int a_mode,
+		float a_alphaL, float a_alphaR, double a_managedAlpha)
+	{
+		float tracked = a_isEnchantSkyHUD ? std::max(a_alphaL, a_alphaR) : (a_isEnchantLeft ? a_alphaL : a_alphaR);
+
+		if (a_mode == kVisible) {
+			return tracked;
+		} else {
+			return std::min(tracked, static_cast<float>(a_managedAlpha));
+		}
+	}
+
+	// ==========================================
+	// Ignored Visibility Helper
+	// ==========================================
+
+	template <class M, class V>
+	void Applier<M, V>::EnforceIgnoredVisibility(V& a_target)
+	{
+		DisplayInfo dInfo;
+		if (GFxOps::GetDisplayInfo(a_target, &dInfo)) {
+			std::optional<double> alpha;
+			std::optional<bool> visible;
+
+			// 1. Ensure the element is flagged as Visible
+			if (!dInfo.GetVisible()) {
+				visible = true;
+			}
+
+			// 2. Alpha Correction
+			// If a widget is effectively invisible (Alpha ~0) despite being flagged "Visible",
+			// force it to 100. We use a low threshold to avoid overriding intended
+			// partial transparency (e.g., a widget that is naturally 50% opacity).
+			if (dInfo.GetAlpha() < 1.0) {
+				alpha = 100.0;
+			}
+
+			if (alpha || visible) {
+				GFxOps::SetAlphaVisible(a_target, alpha, visible);
+			}
+		}
+	}
+
+	// ==========================================
+	// HUD Application
+	// ==========================================
+
+	// Target alpha and visibility of one managed clip of a_def in a_mode.
+	template <class M, class V>
+	double Applier<M, V>::ResolveElementTarget(const HUDElements::Def& a_def, int a_mode, bool& a_shouldBeVisible) const
+	{
+		const bool menuOpen = _frame.menuOpen;
+		const float hudMax = _frame.hudMax;
+		const float managedAlpha = menuOpen ? 0.0f : _frame.globalAlpha;
+		const float alphaL = menuOpen ? 0.0f : _frame.fade.enchantAlphaL;
+		const float alphaR = menuOpen ? 0.0f : _frame.fade.enchantAlphaR;
+		const float interiorAlpha = menuOpen ? 0.0f : _frame.fade.interiorAlpha;
+		const float exteriorAlpha = menuOpen ? 0.0f : _frame.fade.exteriorAlpha;
+		const float combatAlpha = menuOpen ? 0.0f : _frame.fade.combatAlpha;
+		const float notInCombatAlpha = menuOpen ? 0.0f : _frame.fade.notInCombatAlpha;
+		const float weaponAlpha = menuOpen ? 0.0f : _frame.fade.weaponAlpha;
+		const float lockedOnAlpha = menuOpen ? 0.0f : _frame.fade.lockedOnAlpha;
+
+		bool isEnchantLeft, isEnchantRight, isEnchantSkyHUD;
+		const bool isEnchantElement = IsEnchantmentElement(a_def.id, isEnchantLeft, isEnchantRight, isEnchantSkyHUD);
+		const bool isCrosshair = a_def.isCrosshair;
+
+		a_shouldBeVisible = true;
+		double targetAlpha = managedAlpha;
+
+		if (a_mode == kHidden) {
+			a_shouldBeVisible = false;
+			targetAlpha = 0.0;
+		} else if (a_mode == kInterior) {
+			targetAlpha = interiorAlpha;
+			a_shouldBeVisible = (interiorAlpha > 0.01) && !menuOpen;
+		} else if (a_mode == kExterior) {
+			targetAlpha = exteriorAlpha;
+			a_shouldBeVisible = (exteriorAlpha > 0.01) && !menuOpen;
+		} else if (a_mode == kInCombat) {
+			targetAlpha = combatAlpha;
+			a_shouldBeVisible = (combatAlpha > 0.01) && !menuOpen;
+		} else if (a_mode == kNotInCombat) {
+			targetAlpha = notInCombatAlpha;
+			a_shouldBeVisible = (notInCombatAlpha > 0.01) && !menuOpen;
+		} else if (a_mode == kWeaponDrawn) {
+			targetAlpha = weaponAlpha;
+			a_shouldBeVisible = (weaponAlpha > 0.01) && !menuOpen;
+		} else if (a_mode == kLockedOn) {
+			targetAlpha = lockedOnAlpha;
+			a_shouldBeVisible = (lockedOnAlpha > 0.01) && !menuOpen;
+		} else if (isEnchantElement) {
+			targetAlpha = CalculateEnchantmentTargetAlpha(isEnchantLeft, isEnchantSkyHUD, a_mode, alphaL, alphaR, managedAlpha);
+			a_shouldBeVisible = (targetAlpha > 0.01);
+		} else if (a_mode == kVisible) {
+			a_shouldBeVisible = !menuOpen;
+			targetAlpha = menuOpen ? 0.0 : hudMax;
+		} else {
+			if (isCrosshair) {
+				float ctxBased = (menuOpen ? 0.0f : _frame.fade.ctxAlpha);
+				targetAlpha = ctxBased;
+				a_shouldBeVisible = (targetAlpha > 0.0);
+			} else {
+				targetAlpha = managedAlpha;
+				a_shouldBeVisible = (targetAlpha > 0.01) && !menuOpen;
+			}
+		}
+		return targetAlpha;
+	}
+
+	// Shout Meter Z-Order Fix for Infinity UI/Compass Navigation Overhaul
+	// We ensure the visible shout meter stays on top of the compass.
+	// The timer prevents checking every single frame, but aggressive enough to catch updates.
+	template <class M, class V>
+	void Applier<M, V>::FixShoutMeterDepth(V& a_shout)
+	{
+		if (_frame.timer - _lastShoutMeterFixTime <= 2.0f) {
+			return;
+		}
+		// Only update the timer on the very first element we process in this frame
+		_lastShoutMeterFixTime = _frame.timer;
+
+		V parent;
+		V compass;
+		if (GFxOps::GetMember(a_shout, "_parent", &parent) && GFxOps::GetMember(parent, "Compass", &compass) && compass.IsDisplayObject()) {
+			V shoutDepthVal, compassDepthVal;
+			GFxOps::Invoke(a_shout, "getDepth", &shoutDepthVal, static_cast<const V*>(nullptr), 0);
+			GFxOps::Invoke(compass, "getDepth", &compassDepthVal, static_cast<const V*>(nullptr), 0);
+
+			if (shoutDepthVal.IsNumber() && compassDepthVal.IsNumber()) {
+				double sDepth = shoutDepthVal.GetNumber();
+				double cDepth = compassDepthVal.GetNumber();
+
+				// If Shout is below Compass, Swap them.
+				if (sDepth < cDepth) {
+					V args[] = { compass };
+					GFxOps::Invoke(a_shout, "swapDepths", static_cast<V*>(nullptr), args, 1);
+					logger::info("Fixed Shout Meter Z-Order. [Shout: {} < Compass: {}]", sDepth, cDepth);
+				}
+			}
+		}
+	}
+
+	// Decides once per frame whether the members of a_parent agree, and if so applies their alpha to it.
+	// Returns true when the members' clips are taken care of for this frame.
+	template <class M, class V>
+	template <Host H>
+	bool Applier<M, V>::ApplyParentGroup(M* a_movie, const H& a_host, const char* a_parent)
+	{
+		auto& group = _parentGroups[a_parent];
+		if (group.decidedFrame == _applyFrame) {
+			return group.coalesced;
+		}
+		group.decidedFrame = _applyFrame;
+		group.coalesced = false;
+		if (group.rejected || IsAbsentPath(a_parent)) {
+			return false;
+		}
+
+		// kIgnored hands the clips back to the engine; claimed members, mixed modes and mixed targets need per-clip writes
+		const auto& elements = HUDElements::Get();
+		const auto& members = HUDElements::ParentMembers(a_parent);
+		std::optional<double> targetAlpha;
+		for (const auto member : members) {
+			const auto& def = elements[member];
+			const int mode = a_host.GetElementMode(member, def.paths.front());
+			bool agrees = mode != kIgnored && !a_host.IsElementClaimed(member) &&
+			              std::ranges::all_of(def.paths, [&](const char* a_path) { return a_host.GetElementMode(member, a_path) == mode; });
+			if (agrees) {
+				bool shouldBeVisible = true;
+				// TESGlobal in esp ensures compass is always hidden if set.
+				const double alpha = (strcmp(def.id, "iMode_Compass") == 0 && !_frame.compassAllowed) ?
+				                         0.0 :
+				                         QuantizeAlpha(ResolveElementTarget(def, mode, shouldBeVisible), GetFadeChannel(mode));
+				agrees = !targetAlpha || std::abs(*targetAlpha - alpha) <= 0.01;
+				targetAlpha = alpha;
+			}
+			if (!agrees) {
+				if (group.active) {
+					RestoreParentGroup(group);
+				}
+				return false;
+			}
+		}
+
+		if (!group.parent.IsDisplayObject()) {
+			if (!GFxOps::GetVariable(a_movie, &group.parent, a_parent) || !group.parent.IsDisplayObject()) {
+				MarkAbsentPath(a_parent);
+				Profiler::Count(Profiler::Counter::kFailedLookups);
+				group.parent = V{};
+				return false;
+			}
+
+			// The parent's alpha reaches all its display children: layouts that put other clips there are left per-clip
+			GFxOps::VisitMembers(group.parent, [&](const char* a_name, const V& a_val) {
+				if (!group.rejected && a_val.IsDisplayObject() && !HUDElements::IsCoalescedChild(a_parent, a_name)) {
+					logger::info("Not coalescing {}: it also holds {}", a_parent, a_name);
+					group.rejected = true;
+				}
+			});
+			if (group.rejected) {
+				group.parent = V{};
+				return false;
+			}
+		}
+
+		// Hold the clips, and the parents declared below this one, at 100 so the parent alone decides the final alpha.
+		// _visible stays with the engine/SkyHUD.
+		if (!group.active) {
+			group.held.clear();
+			group.nextCheck = 0;
+			const auto hold = [&](const char* a_path, bool a_shoutMeter) {
+				if (IsAbsentPath(a_path)) {
+					return;
+				}
+				V clip;
+				if (!GFxOps::GetVariable(a_movie, &clip, a_path) || !clip.IsDisplayObject()) {
+					MarkAbsentPath(a_path);
+					Profiler::Count(Profiler::Counter::kFailedLookups);
+					return;
+				}
+				DisplayInfo info;
+				if (GFxOps::GetDisplayInfo(clip, &info) && info.GetAlpha() < 100.0) {
+					GFxOps::SetAlpha(clip, 100.0);
+				}
+				group.held.push_back({ clip, a_shoutMeter });
+			};
+
+			for (const auto member : members) {
+				const auto& def = elements[member];
+				if (std::string_view(def.parent) != a_parent) {
+					if (const auto inner = _parentGroups.find(def.parent); inner != _parentGroups.end()) {
+						inner->second.active = false;
+					}
+					hold(def.parent, false);
+				}
+				const bool shoutMeter = strcmp(def.id, "iMode_ShoutMeter") == 0;
+				for (const char* path : def.paths) {
+					hold(path, shoutMeter);
+				}
+			}
+			group.active = true;
+		} else if (!group.held.empty()) {
+			// One held clip per frame
+			auto& held = group.held[group.nextCheck++ % group.held.size()];
+			DisplayInfo info;
+			if (!GFxOps::GetDisplayInfo(held.value, &info)) {
+				// Unloaded: the handles are collected again from fresh lookups
+				RestoreParentGroup(group);
+				group.parent = V{};
+				return false;
+			}
+			if (info.GetAlpha() < 100.0) {
+				GFxOps::SetAlpha(held.value, 100.0);
+			}
+			if (held.shoutMeter && info.GetVisible()) {
+				FixShoutMeterDepth(held.value);
+			}
+		}
+
+		DisplayInfo parentInfo;
+		if (!GFxOps::GetDisplayInfo(group.parent, &parentInfo)) {
+			// Parent no longer resolves: per-clip writes take over this frame
+			group.parent = V{};
+			group.active = false;
+			return false;
+		}
+		if (std::abs(parentInfo.GetAlpha() - *targetAlpha) > 0.01 && BeginAlphaWrite(a_parent, parentInfo.GetAlpha(), *targetAlpha, false)) {
+			GFxOps::SetAlpha(group.parent, *targetAlpha);
+		}
+		group.coalesced = true;
+		return true;
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::RestoreParentGroup(ParentGroup& a_group)
+	{
+		DisplayInfo info;
+		if (a_group.active && a_group.parent.IsDisplayObject() && GFxOps::GetDisplayInfo(a_group.parent, &info) && info.GetAlpha() < 100.0) {
+			GFxOps::SetAlpha(a_group.parent, 100.0);
+		}
+		a_group.active = false;
+	}
+
+	// Returns every coalesced parent to full alpha so per-clip writes start from a neutral parent.
+	template <class M, class V>
+	void Applier<M, V>::ReleaseParentGroups()
+	{
+		for (auto& [path, group] : _parentGroups) {
+			RestoreParentGroup(group);
+		}
+		_parentGroups.clear();
+	}
+
+	template <class M, class V>
+	template <Host H>
+	void Applier<M, V>::ApplyHUD(M* a_movie, const H& a_host)
+	{
+		{
+			Profiler::ScopedTimer vanillaTimer(Profiler::Stage::kHUDVanilla);
+			ApplyElements(a_movie, a_host);
+		}
+		Profiler::ScopedTimer dynamicTimer(Profiler::Stage::kHUDDynamic);
+		ApplyWidgets(a_movie, a_host);
+	}
+
+	template <class M, class V>
+	template <Host H>
+	void Applier<M, V>::ApplyElements(M* a_movie, const H& a_host)
+	{
+		const bool menuOpen = _frame.menuOpen;
+
+		// Management of vanilla elements; target 0 alpha while menus are open to respect engine hiding (ResolveElementTarget).
+		const float alphaL = menuOpen ? 0.0f : _frame.fade.enchantAlphaL;
+		const float alphaR = menuOpen ? 0.0f : _frame.fade.enchantAlphaR;
+
+		// Immediate state checks for Visibility Hammer logic
+		const bool isSneaking = _frame.isSneaking;
+		const bool isSmoothCam = _frame.smoothCam;
+		const bool hasSmoothCamCrosshairControl = _frame.smoothCamCrosshairControl;
+
+		const auto& elements = HUDElements::Get();
+		for (std::size_t index = 0; index < elements.size(); index++) {
+			const auto& def = elements[index];
+
+			// Claimed by another HUD controller through the plugin API
+			if (a_host.IsElementClaimed(index)) {
+				continue;
+			}
+
+			// A script override replaces the configured mode of every clip
+			auto modeOf = [&](std::string_view a_path) {
+				return a_host.GetElementMode(index, a_path);
+			};
+
+			bool isCompass = (strcmp(def.id, "iMode_Compass") == 0);
+			bool isShoutMeter = (strcmp(def.id, "iMode_ShoutMeter") == 0);
+			bool isStealthMeter = (strcmp(def.id, "iMode_StealthMeter") == 0);
+			bool isHealth = (strcmp(def.id, "iMode_Health") == 0);
+			bool isMagicka = (strcmp(def.id, "iMode_Magicka") == 0);
+			bool isStamina = (strcmp(def.id, "iMode_Stamina") == 0);
+			bool isTemperature = (strcmp(def.id, "iMode_Temperature") == 0);
+
+			// INPA SEKIRO FIX: Completely skip stamina handling if Inpa is managing it
+			if (isStamina && _frame.inpaSekiro) {
+				continue;
+			}
+
+			bool isEnchantLeft, isEnchantRight, isEnchantSkyHUD;
+			bool isEnchantElement = IsEnchantmentElement(def.id, isEnchantLeft, isEnchantRight, isEnchantSkyHUD);
+			bool isResourceBar = isHealth || isMagicka || isStamina;
+			bool isCrosshair = def.isCrosshair;
+
+			// Parent-coalesced write (see ParentGroup). Falls through to per-clip writes whenever the members differ.
+			if (std::ranges::any_of(HUDElements::ParentsOf(index), [&](const char* a_parent) { return ApplyParentGroup(a_movie, a_host, a_parent); })) {
+				continue;
+			}
+
+			for (const char* rawPath : def.paths) {
+				// Alternate path for a layout this movie does not use
+				if (IsAbsentPath(rawPath)) {
+					continue;
+				}
+
+				const std::string_view path(rawPath);
+				int mode = modeOf(path);
+				V elem;
+				if (!GFxOps::GetVariable(a_movie, &elem, rawPath) || !elem.IsDisplayObject()) {
+					MarkAbsentPath(rawPath);
+					Profiler::Count(Profiler::Counter::kFailedLookups);
+					continue;
+				}
+
+				// We need display info to determine if we should even attempt Z-Order fixing
+				DisplayInfo dInfo;
+				if (!GFxOps::GetDisplayInfo(elem, &dInfo)) {
+					continue;
+				}
+
+				// We only fix elements that are currently VISIBLE, otherwise we might
+				// swap a hidden vanilla meter with the compass and mess up the hierarchy.
+				if (isShoutMeter && dInfo.GetVisible()) {
+					FixShoutMeterDepth(elem);
+				}
+
+				// SkyHUD alt charge: hide separate left/right meters completely
+				if ((_frame.skyHUDAltCharge && (isEnchantLeft || isEnchantRight)) ||
+					(!_frame.skyHUDAltCharge && isEnchantSkyHUD)) {
+					if (dInfo.GetAlpha() > 0.0 || dInfo.GetVisible()) {
+						GFxOps::SetAlphaVisible(elem, 0.0, false);
+					}
+					continue;
+				}
+
+				// TESGlobal in esp ensures compass is always hidden if set.
+				if (isCompass && !_frame.compassAllowed) {
+					if (dInfo.GetAlpha() > 0.0) {
+						GFxOps::SetAlpha(elem, 0.0);
+					}
+					continue;
+				}
+
+				// Stealth Meter Handling (Unified Logic)
+				if (isStealthMeter) {
+					// Managed/Contextual Authority
+					float finalAlpha = _frame.fade.ctxSneakAlpha;
+
+					// Apply Pulse logic (Ensures vanilla mode still breathes when detected)
+					if (_frame.sneakMeterEnabled && isSneaking && _frame.detectionLevel > 0.1f && finalAlpha > 0.01f) {
+						// Hardcoded constants for sin/pi
+						constexpr float kPulseRange = 0.05f;
+						constexpr float kPulseFreq = 0.05f;
+						constexpr float kTwoPi = 6.2831853f;
+
+						auto detectionFreq = (_frame.detectionLevel / 200.0f) + 0.5f;
+						auto pulse = (kPulseRange * std::sin(kTwoPi * detectionFreq * kPulseFreq * 0.25f * _frame.timer)) + (1.0f - kPulseRange);
+						finalAlpha *= std::min(static_cast<float>(pulse), 1.0f);
+					}
+
+					double targetSneakAlpha = QuantizeAlpha(finalAlpha, FadeEngine::Channel{ _frame.fade.ctxSneakAlpha, _frame.targets.sneak });
+					bool sneakVisible = ApplyVisibleHysteresis(targetSneakAlpha > 0.1f, dInfo.GetVisible(), targetSneakAlpha, 0.1) && !menuOpen;
+
+					// Written only where the clip differs, so a meter at rest costs reads alone
+					auto applySneak = [&](V& a_clip, const DisplayInfo& a_info) {
+						std::optional<double> alpha;
+						std::optional<bool> visible;
+						if (std::abs(a_info.GetAlpha() - targetSneakAlpha) > 0.01) {
+							alpha = targetSneakAlpha;
+						}
+						if (a_info.GetVisible() != sneakVisible) {
+							visible = sneakVisible;
+						}
+						if (alpha || visible) {
+							GFxOps::SetAlphaVisible(a_clip, alpha, visible);
+						}
+					};
+					applySneak(elem, dInfo);
+
+					// Clip Injection: override eye/text clips
+					const char* subPaths[] = { "SneakAnimInstance", "SneakTextHolder" };
+					for (auto p : subPaths) {
+						V sub;
+						DisplayInfo subInfo;
+						if (GFxOps::GetMember(elem, p, &sub) && sub.IsDisplayObject() && GFxOps::GetDisplayInfo(sub, &subInfo)) {
+							applySneak(sub, subInfo);
+						}
+					}
+					continue;
+				}
+
+				// Enchantment kIgnored block
+				if (mode == kIgnored && isEnchantElement) {
+					float target = CalculateEnchantmentIgnoredAlpha(isEnchantLeft, isEnchantSkyHUD, alphaL, alphaR);
+					if (isEnchantSkyHUD) {
+						ApplySkyHUDEnchantment(elem, alphaL, alphaR, 0.0f, 0, true);
+					}
+					GFxOps::SetAlphaVisible(elem, target, target > 0.01);
+					if (target > 0.1 && !isEnchantSkyHUD) {
+						EnforceEnchantMeterVisible(elem, rawPath);
+					}
+					continue;
+				}
+
+				// Handle reset for other ignored elements
+				if (mode == kIgnored) {
+					// For Compass/ShoutMeter, we must respect the external "Visible" state (Vanilla vs Alt).
+					// If it's hidden, it's likely the inactive variant. Don't force it to show.
+					if ((isCompass || isShoutMeter) && !dInfo.GetVisible()) {
+						continue;
+					}
+
+					if (!dInfo.GetVisible() || dInfo.GetAlpha() < 100.0) {
+						// Only force Visible=True if it's NOT a compass/shout element
+						std::optional<bool> visible;
+						if (!isCompass && !isShoutMeter) {
+							visible = true;
+						}
+						GFxOps::SetAlphaVisible(elem, 100.0, visible);
+					}
+					continue;
+				}
+
+				bool shouldBeVisible = true;
+				double targetAlpha = ResolveElementTarget(def, mode, shouldBeVisible);
+				if (!isEnchantElement) {
+					targetAlpha = QuantizeAlpha(targetAlpha, GetFadeChannel(mode, isCrosshair));
+				}
+				if (!menuOpen) {
+					shouldBeVisible = ApplyVisibleHysteresis(shouldBeVisible, dInfo.GetVisible(), targetAlpha, 0.01);
+				}
+
+				// For Compass AND Shout Meter sub-components, we MUST NOT touch the _visible property.
+				// SkyHUD hides the vanilla frame and shows the Alt frame via _visible.
+				// If we force SetVisible(true), we show both. We rely on Alpha to hide.
+				std::optional<double> alpha;
+				std::optional<bool> visible;
+
+				// Check API owner: If we DO NOT have control, SmoothCam manages the alpha & visibility.
+				bool skipCrosshairEnforcement = isCrosshair && isSmoothCam && !hasSmoothCamCrosshairControl;
+
+				if (!isCompass && !isShoutMeter) {
+					if (!skipCrosshairEnforcement && dInfo.GetVisible() != shouldBeVisible) {
+						visible = shouldBeVisible;
+					}
+				}
+
+				if (!skipCrosshairEnforcement && std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01) {
+					// Vanilla elements are overridden on purpose: tracked for the dump, never backed off
+					BeginAlphaWrite(path, dInfo.GetAlpha(), targetAlpha, false);
+					alpha = targetAlpha;
+				}
+
+				if (alpha || visible) {
+					GFxOps::SetAlphaVisible(elem, alpha, visible);
+				}
+
+				// Visibility Hammer logic: Override engine hiding
+				if (shouldBeVisible && (targetAlpha > 0.1 || _frame.fade.wasHidden)) {
+					if (isResourceBar) {
+						// Pass true if the mode is Immersive/Visible to override "hide when full"
+						bool forceOverride = (mode == kVisible || mode == kImmersive ||
+											  mode == kInterior || mode == kExterior ||
+											  mode == kInCombat || mode == kNotInCombat ||
+											  mode == kWeaponDrawn || mode == kLockedOn);
+						EnforceHMSMeterVisible(elem, rawPath, forceOverride);
+					} else if (isTemperature) {
+						// Ensure the Temperature Meter CONTAINER stays visible even if the game wants to hide it.
+						// We verify current state first to avoid flickering caused by snapping Alpha.
+						DisplayInfo tempInfo;
+						if (GFxOps::GetDisplayInfo(elem, &tempInfo)) {
+							if (!tempInfo.GetVisible()) {
+								GFxOps::SetVisible(elem, true);
+							}
+						}
+					} else if (isEnchantSkyHUD) {
+						ApplySkyHUDEnchantment(elem, 0.0f, 0.0f, static_cast<float>(targetAlpha), mode, false);
+					} else if (isEnchantLeft || isEnchantRight) {
+						EnforceEnchantMeterVisible(elem, rawPath);
+					}
+				}
+			}
+		}
+	}
+
+	template <class M, class V>
+	template <Host H>
+	void Applier<M, V>::ApplyWidgets(M* a_movie, const H& a_host)
+	{
+		const bool menuOpen = _frame.menuOpen;
+		const float managedAlpha = menuOpen ? 0.0f : _frame.globalAlpha;
+		const float interiorAlpha = menuOpen ? 0.0f : _frame.fade.interiorAlpha;
+		const float exteriorAlpha = menuOpen ? 0.0f : _frame.fade.exteriorAlpha;
+		const float combatAlpha = menuOpen ? 0.0f : _frame.fade.combatAlpha;
+		const float notInCombatAlpha = menuOpen ? 0.0f : _frame.fade.notInCombatAlpha;
+		const float weaponAlpha = menuOpen ? 0.0f : _frame.fade.weaponAlpha;
+		const float lockedOnAlpha = menuOpen ? 0.0f : _frame.fade.lockedOnAlpha;
+
+		// Scratch buffer keeps its capacity across frames
+		thread_local std::string decodedUrl;
+
+		const auto sourceGeneration = a_host.GetSourceGeneration();
+		for (const auto& path : a_host.GetWidgetPaths()) {
+			// Hardcoded elements are handled above
+			if (HUDElements::IsElementPath(path) ||
+				path == "_root.HUDMovieBaseInstance.StealthMeterInstance") {
+				continue;
+			}
+
+			if (path.find("markerData") != std::string::npos ||
+				path.find("widgetLoaderContainer") != std::string::npos) {
+				continue;
+			}
+
+			// Registered or claimed through the plugin API
+			if (a_host.IsWidgetSkipped(path)) {
+				continue;
+			}
+
+			// RUNTIME VERIFICATION (Fix for SkyUI WidgetContainer Indices)
+			// Only control widgets if the currently loaded Source matches what we cached.
+			// The state is dropped exactly when the scanner reports a new source for this slot.
+			auto& verification = _pathVerification[path];
+			if (verification.generation != sourceGeneration) {
+				if (a_host.GetSourceGeneration(path) > verification.generation) {
+					verification = PathVerification{};
+				}
+				verification.generation = sourceGeneration;
+			}
+
+			if (verification.status != PathVerification::Status::kVerified && _frame.timer < verification.retryAt) {
+				continue;
+			}
+
+			V elem;
+			if (!GFxOps::GetVariable(a_movie, &elem, path.c_str()) || !elem.IsDisplayObject()) {
+				verification.Fail(PathVerification::Status::kUnresolved, _frame.timer);
+				Profiler::Count(Profiler::Counter::kFailedLookups);
+				continue;
+			}
+
+			if (verification.status != PathVerification::Status::kVerified) {
+				V urlVal;
+				if (!GFxOps::GetMember(elem, "_url", &urlVal) || !urlVal.IsString()) {
+					verification.Fail(PathVerification::Status::kUnresolved, _frame.timer);
+					continue;
+				}
+
+				StringKernels::PercentDecode(urlVal.GetString(), decodedUrl);
+
+				if (decodedUrl != std::string_view(a_host.GetWidgetSource(path))) {
+					// MISMATCH! Index X has changed owners.
+					// Do not control it. Wait for the Scanner to update Settings.
+					verification.Fail(PathVerification::Status::kMismatched, _frame.timer);
+					continue;
+				}
+
+				verification.status = PathVerification::Status::kVerified;
+				verification.failures = 0;
+			}
+
+			int mode = a_host.GetWidgetMode(path);
+
+			// Menus active: relinquish control of dynamic widgets to allow 3rd party function.
+			// Important for mod-added system menus, and widgets open during vanilla menus.
+			if (menuOpen && mode != kHidden && !_frame.consoleOpen) {
+				continue;
+			}
+
+			// Handle passive ignore for dynamic widgets.
+			if (mode == kIgnored) {
+				EnforceIgnoredVisibility(elem);
+				continue;
+			}
+
+			bool shouldBeVisible = true;
+			double targetAlpha = managedAlpha;
+
+			if (mode == kHidden) {
+				shouldBeVisible = false;
+				targetAlpha = 0.0;
+			} else if (mode == kVisible) {
+				shouldBeVisible = true;
+				targetAlpha = _frame.hudMax;
+			} else if (mode == kInterior) {
+				shouldBeVisible = (interiorAlpha > 0.01);
+				targetAlpha = interiorAlpha;
+			} else if (mode == kExterior) {
+				shouldBeVisible = (exteriorAlpha > 0.01);
+				targetAlpha = exteriorAlpha;
+			} else if (mode == kInCombat) {
+				shouldBeVisible = (combatAlpha > 0.01);
+				targetAlpha = combatAlpha;
+			} else if (mode == kNotInCombat) {
+				shouldBeVisible = (notInCombatAlpha > 0.01);
+				targetAlpha = notInCombatAlpha;
+			} else if (mode == kWeaponDrawn) {
+				shouldBeVisible = (weaponAlpha > 0.01);
+				targetAlpha = weaponAlpha;
+			} else if (mode == kLockedOn) {
+				shouldBeVisible = (lockedOnAlpha > 0.01);
+				targetAlpha = lockedOnAlpha;
+			} else {
+				shouldBeVisible = (managedAlpha > 0.01f);
+				targetAlpha = managedAlpha;
+			}
+
+			if (TryNativeTween(a_movie, elem, path, mode, targetAlpha, true)) {
+				continue;
+			}
+
+			DisplayInfo dInfo;
+			GFxOps::GetDisplayInfo(elem, &dInfo);
+
+			targetAlpha = QuantizeAlpha(targetAlpha, GetFadeChannel(mode));
+			shouldBeVisible = ApplyVisibleHysteresis(shouldBeVisible, dInfo.GetVisible(), targetAlpha, 0.01);
+
+			std::optional<double> alpha;
+			std::optional<bool> visible;
+			if (dInfo.GetVisible() != shouldBeVisible) {
+				visible = shouldBeVisible;
+			}
+			if (std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01 && BeginAlphaWrite(path, dInfo.GetAlpha(), targetAlpha, true)) {
+				alpha = targetAlpha;
+			}
+
+			if (alpha || visible) {
+				GFxOps::SetAlphaVisible(elem, alpha, visible);
+			}
+		}
+	}
+
+	// ==========================================
+	// External Menus
+	// ==========================================
+
+	template <class M, class V>
+	void Applier<M, V>::ApplyMenu(M* a_movie, std::string_view a_menuName, int a_mode)
+	{
+		const bool menuOpen = _frame.menuOpen;
+
+		// Menus active: relinquish control of external menus.
+		// Important for mod-added system menus, and widgets open during vanilla menus.
+		if (menuOpen && a_mode != kHidden && !_frame.consoleOpen) {
+			RestoreCulledMenu(a_movie, a_menuName);
+			return;
+		}
+
+		V root;
+		if (!GFxOps::GetVariable(a_movie, &root, "_root")) {
+			return;
+		}
+
+		// Handle passive ignore for external menus.
+		if (a_mode == kIgnored) {
+			if (const auto cull = _menuCulling.find(a_menuName); cull != _menuCulling.end()) {
+				_menuCulling.erase(cull);
+			}
+			EnforceIgnoredVisibility(root);
+			return;
+		}
+
+		// For other modes, we set the target alpha blindly
+		double targetAlpha = _frame.globalAlpha;
+
+		if (a_mode == kVisible) {
+			targetAlpha = _frame.hudMax;
+		} else if (a_mode == kHidden) {
+			targetAlpha = 0.0;
+		} else if (a_mode == kInterior) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.interiorAlpha;
+		} else if (a_mode == kExterior) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.exteriorAlpha;
+		} else if (a_mode == kInCombat) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.combatAlpha;
+		} else if (a_mode == kNotInCombat) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.notInCombatAlpha;
+		} else if (a_mode == kWeaponDrawn) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.weaponAlpha;
+		} else if (a_mode == kLockedOn) {
+			targetAlpha = menuOpen ? 0.0f : _frame.fade.lockedOnAlpha;
+		}
+
+		if (UpdateMenuCulling(root, a_menuName, a_mode, targetAlpha)) {
+			return;
+		}
+
+		if (TryNativeTween(a_movie, root, a_menuName, a_mode, targetAlpha, false)) {
+			return;
+		}
+
+		DisplayInfo dInfo;
+		GFxOps::GetDisplayInfo(root, &dInfo);
+
+		targetAlpha = QuantizeAlpha(targetAlpha, GetFadeChannel(a_mode));
+		if (std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01 && BeginAlphaWrite(a_menuName, dInfo.GetAlpha(), targetAlpha, true)) {
+			GFxOps::SetAlpha(root, targetAlpha);
+		}
+	}
+
+	// Returns true while the menu root is culled; the caller then has nothing to write.
+	template <class M, class V>
+	bool Applier<M, V>::UpdateMenuCulling(V& a_root, std::string_view a_menuName, int a_mode, double a_frameAlpha)
+	{
+		auto it = _menuCulling.find(a_menuName);
+		if (it == _menuCulling.end()) {
+			it = _menuCulling.emplace(std::string(a_menuName), MenuCull{}).first;
+		}
+		auto& cull = it->second;
+
+		// Restore as soon as the channel heads above 0, a frame before the alpha write that starts the fade-in
+		const auto channel = GetFadeChannel(a_mode);
+		if (a_frameAlpha > 0.01 || (channel && channel->end > 0.01f)) {
+			if (cull.culled) {
+				GFxOps::SetVisible(a_root, true);
+			}
+			cull = MenuCull{};
+			return false;
+		}
+
+		if (cull.culled) {
+			// A reloaded menu, or its owner, may have shown the root again
+			DisplayInfo dInfo;
+			if (GFxOps::GetDisplayInfo(a_root, &dInfo) && !dInfo.GetVisible()) {
+				Profiler::Count(Profiler::Counter::kCulledMenus);
+				return true;
+			}
+			cull = MenuCull{};
+			return false;
+		}
+
+		// The timer restarts on Reset
+		if (cull.zeroSince < 0.0f || cull.zeroSince > _frame.timer) {
+			cull.zeroSince = _frame.timer;
+		}
+		if (_frame.timer - cull.zeroSince < MenuCull::kHoldTime) {
+			return false;
+		}
+
+		GFxOps::SetAlphaVisible(a_root, 0.0, false);
+		cull.culled = true;
+		Profiler::Count(Profiler::Counter::kCulledMenus);
+		return true;
+	}
+
+	// Hands a culled root back visible (at its 0 alpha) when control of the menu is relinquished.
+	template <class M, class V>
+	void Applier<M, V>::RestoreCulledMenu(M* a_movie, std::string_view a_menuName)
+	{
+		const auto it = _menuCulling.find(a_menuName);
+		if (it == _menuCulling.end() || !it->second.culled) {
+			return;
+		}
+
+		V root;
+		if (GFxOps::GetVariable(a_movie, &root, "_root")) {
+			GFxOps::SetVisible(root, true);
+		}
+		it->second = MenuCull{};
+	}
+
+	// ==========================================
+	// Native Tweening and Write Contention
+	// ==========================================
+
+	// Returns true while Scaleform owns the clip's alpha for the current fade; the caller then skips its own write.
+	// a_frameAlpha is the value the C++ path would write this frame. Any override of the channel (menus, snaps)
+	// makes it differ from the channel and returns control to the C++ path.
+	template <class M, class V>
+	bool Applier<M, V>::TryNativeTween(M* a_movie, V& a_clip, std::string_view a_key, int a_mode, double a_frameAlpha, bool a_managesVisibility)
+	{
+		if (!_frame.nativeTweens) {
+			return false;
+		}
+
+		auto it = _tweens.find(a_key);
+		if (it == _tweens.end()) {
+			it = _tweens.emplace(std::string(a_key), TweenTrack{}).first;
+		}
+		auto& track = it->second;
+		if (track.unsupported) {
+			return false;
+		}
+
+		const auto channel = GetFadeChannel(a_mode);
+		const bool fading = channel &&
+		                    std::abs(a_frameAlpha - channel->current) <= 0.01 &&
+		                    std::abs(channel->end - channel->current) > 0.01f;
+
+		if (!fading) {
+			if (track.running) {
+				GFxOps::EndTween(a_clip);
+				track.running = false;
+			}
+			return false;
+		}
+
+		// Tween in flight towards the same end target
+		if (track.running && std::abs(track.end - channel->end) <= 0.01) {
+			return true;
+		}
+
+		// New fade or interrupted one: hand the remaining distance over at the channel's speed
+		const float speed = channel->end > channel->current ? _frame.fadeInSpeed : _frame.fadeOutSpeed;
+		const double seconds = std::abs(channel->end - channel->current) / std::max(speed * 60.0f, 1.0f);
+
+		if (a_managesVisibility && channel->end > 0.01f) {
+			GFxOps::SetVisible(a_clip, true);
+		}
+
+		if (!GFxOps::TweenAlpha(a_movie, a_clip, channel->end, seconds)) {
+			track.unsupported = true;
+			return false;
+		}
+
+		track.end = channel->end;
+		track.running = true;
+		Profiler::Count(Profiler::Counter::kNativeTweenHandoffs);
+		return true;
+	}
+
+	// Called before an alpha write, with the value read back this frame. Returns false while a contended element
+	// is backing off. Only elements that are about to be written are looked up: a clip that needed no write since
+	// our last one kept our value, which counts as a clean observation.
+	template <class M, class V>
+	bool Applier<M, V>::BeginAlphaWrite(std::string_view a_key, double a_readAlpha, double a_alpha, bool a_allowBackoff)
+	{
+		auto it = _contention.find(a_key);
+		if (it == _contention.end()) {
+			it = _contention.emplace(std::string(a_key), Contention{}).first;
+		}
+		auto& c = it->second;
+
+		if (c.shadow >= 0.0) {
+			const bool overwritten = c.shadowFrame + 1 == _applyFrame && std::abs(a_readAlpha - c.shadow) > Contention::kTolerance;
+			c.history = (c.history << 1) | (overwritten ? 1u : 0u);
+			c.shadow = -1.0;
+
+			const int overwrites = std::popcount(c.history);
+			const bool contended = overwrites >= Contention::kThreshold;
+			if (contended && !c.hinted) {
+				logger::info("[Contention] '{}' is also driven by another source ({} of the last {} writes overwritten). Consider setting it to Ignored.",
+					a_key, overwrites, Contention::kWindow);
+				c.hinted = true;
+			}
+			c.contended = contended;
+		}
+
+		if (c.contended && a_allowBackoff) {
+			if (_frame.timer < c.nextWriteAt && c.nextWriteAt - _frame.timer <= Contention::kBackoffInterval) {
+				return false;
+			}
+			c.nextWriteAt = _frame.timer + Contention::kBackoffInterval;
+		}
+
+		c.shadow = a_alpha;
+		c.shadowFrame = _applyFrame;
+		return true;
+	}
+
+	template <class M, class V>
+	void Applier<M, V>::DumpContention() const
+	{
+		std::vector<std::pair<std::string_view, int>> entries;
+		for (const auto& [key, c] : _contention) {
+			if (const int overwrites = std::popcount(c.history); overwrites > 0) {
+				entries.emplace_back(key, overwrites);
+			}
+		}
+		std::ranges::sort(entries, [](const auto& a_lhs, const auto& a_rhs) { return a_lhs.second > a_rhs.second; });
+
+		logger::info("=== WRITE CONTENTION ({} elements) ===", entries.size());
+		for (const auto& [key, overwrites] : entries) {
+			const auto& c = _contention.find(key)->second;
+			logger::info("{:>3}/{} overwritten{} : {}", overwrites, Contention::kWindow, c.contended ? " [contended]" : "", key);
+		}
+	}
+}
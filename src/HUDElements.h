@@ -8,6 +8,7 @@ namespace HUDElements
 		const char* label;               // Localization Key (e.g., "$fzIH_ElemHealth")
 		std::vector<const char*> paths;  // Flash paths (e.g., "_root...Health")
 		bool isCrosshair;                // Special flag for contextual logic
+		const char* parent = nullptr;    // Common parent of the clips (alpha can be coalesced, see ParentMembers)
 	};
 
 	inline const std::vector<Def>& Get()
@@ -27,7 +28,7 @@ namespace HUDElements
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass.CompassCard",
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass.CompassCardAlt",
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass.CompassMask_mc"
-			}, false },
+			}, false, "_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass" },
 
 			{ "iMode_Crosshair", "$fzIH_ElemCrosshair", {
 				"_root.HUDMovieBaseInstance.Crosshair"
@@ -67,7 +68,7 @@ namespace HUDElements
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.ShoutWarningInstance",
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.ShoutMeterBarAlt",
 				"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.ShoutWarningInstanceAlt"
-			}, false },
+			}, false, "_root.HUDMovieBaseInstance.CompassShoutMeterHolder" },
 
 			{ "iMode_Stamina", "$fzIH_ElemStamina", {
 				"_root.HUDMovieBaseInstance.Stamina",
@@ -93,4 +94,104 @@ namespace HUDElements
 		};
 		return data;
 	}
+
+	// Index of an element in Get(), or Get().size() if a_id is not one of the elements above.
+	inline std::size_t IndexOf(std::string_view a_id)
+	{
+		const auto& elements = Get();
+		const auto it = std::ranges::find_if(elements, [&](const Def& a_def) { return a_id == a_def.id; });
+		return static_cast<std::size_t>(it - elements.begin());
+	}
+
+	// True if a_path lies strictly below a_parent.
+	inline bool IsBelowPath(std::string_view a_path, std::string_view a_parent)
+	{
+		return a_path.size() > a_parent.size() && a_path.starts_with(a_parent) && a_path[a_parent.size()] == '.';
+	}
+
+	// Elements coalesced onto a declared parent: the ones declaring it, and the ones whose own parent lies below it
+	// (iMode_Compass under the CompassShoutMeterHolder of iMode_ShoutMeter). Only elements whose clips take alpha
+	// alone declare a parent; the two-clip elements keep per-clip writes for their _visible and hammer handling.
+	inline const std::vector<std::size_t>& ParentMembers(std::string_view a_parent)
+	{
+		static const auto members = []() {
+			const auto& elements = Get();
+			std::unordered_map<std::string_view, std::vector<std::size_t>> result;
+			for (const auto& def : elements) {
+				if (def.parent) {
+					result.try_emplace(def.parent);
+				}
+			}
+			for (auto& [parent, list] : result) {
+				for (std::size_t i = 0; i < elements.size(); i++) {
+					if (elements[i].parent && (parent == elements[i].parent || IsBelowPath(elements[i].parent, parent))) {
+						list.push_back(i);
+					}
+				}
+			}
+			return result;
+		}();
+		static const std::vector<std::size_t> none;
+		const auto it = members.find(a_parent);
+		return it != members.end() ? it->second : none;
+	}
+
+	// Declared parents the element at a_index is coalesced onto, outermost first.
+	inline const std::vector<const char*>& ParentsOf(std::size_t a_index)
+	{
+		static const auto parents = []() {
+			const auto& elements = Get();
+			std::vector<std::vector<const char*>> result(elements.size());
+			for (const auto& def : elements) {
+				if (!def.parent) {
+					continue;
+				}
+				for (const auto member : ParentMembers(def.parent)) {
+					auto& list = result[member];
+					if (std::ranges::none_of(list, [&](const char* a_parent) { return std::string_view(a_parent) == def.parent; })) {
+						list.push_back(def.parent);
+					}
+				}
+			}
+			for (auto& list : result) {
+				std::ranges::sort(list, {}, [](const char* a_parent) { return std::strlen(a_parent); });
+			}
+			return result;
+		}();
+		return parents[a_index];
+	}
+
+	// True if a_child, a direct child of the declared a_parent, is or contains a clip of an element coalesced onto it.
+	inline bool IsCoalescedChild(std::string_view a_parent, std::string_view a_child)
+	{
+		const auto covers = [&](std::string_view a_path) {
+			if (!IsBelowPath(a_path, a_parent)) {
+				return false;
+			}
+			const auto rest = a_path.substr(a_parent.size() + 1);
+			return rest.starts_with(a_child) && (rest.size() == a_child.size() || rest[a_child.size()] == '.');
+		};
+
+		const auto& elements = Get();
+		for (const auto member : ParentMembers(a_parent)) {
+			const auto& def = elements[member];
+			if (covers(def.parent) || std::ranges::any_of(def.paths, covers)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// True if a_path is one of the hardcoded element paths above.
+	inline bool IsElementPath(std::string_view a_path)
+	{
+		static const auto paths = []() {
+			std::unordered_set<std::string_view> result;
+			for (const auto& def : Get()) {
+				result.insert(def.paths.begin(), def.paths.end());
+			}
+			return result;
+		}();
+		return paths.contains(a_path);
+	}
 }
@@ -1,82 +1,83 @@
 #include "Compat.h"
 #include "Events.h"
+#include "FadeEngine.h"
+#include "GFxOps.h"
+#include "HUDApply.h"
 #include "HUDElements.h"
 #include "HUDManager.h"
 #include "MCMGen.h"
+#include "PluginAPI.h"
+#include "Profiler.h"
+#include "ScriptOverrides.h"
 #include "Settings.h"
+#include "Trace.h"
 #include "Utils.h"
+#include "WidgetDiscovery.h"
 
 // ==========================================
-	// Utility Classes
-	// ==========================================
+// Apply Host
+// ==========================================
 
-namespace
+// Settings and plugin API state read by the apply path (HUDApply::Host).
+struct HUDManager::ApplyHost
 {
-	// Aggressively forces any DisplayObject found to be visible and at 100 alpha (or max opacity).
-	// Used to fix vanilla enchantment charge meter visibility issues, required for unlabeled children.
-	class VisibilityHammer
+	const HUDManager& manager;
+	const Settings& settings;
+
+	bool IsElementClaimed(std::size_t a_index) const
 	{
-		public:
-			VisibilityHammer(bool a_forceVisible = false, int a_depth = 1) :
-				_forceVisible(a_forceVisible),
-				_depth(a_depth)
-			{}
-
-			void Visit(const char* a_name, const RE::GFxValue& a_val)
-			{
-				if (!a_val.IsDisplayObject() || !_forceVisible) {
-					return;
-				}
-
-				// Optimization: Precompute lower name in thread_local buffer
-				thread_local std::string lowerName;
-				lowerName.assign(a_name ? a_name : "unnamed");
-				std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-
-				RE::GFxValue::DisplayInfo d;
-				// We need mutable access to call GetDisplayInfo
-				auto& obj = const_cast<RE::GFxValue&>(a_val);
-
-				if (obj.GetDisplayInfo(&d)) {
-					bool changed = false;
-					if (!d.GetVisible()) {
-						d.SetVisible(true);
-						changed = true;
-					}
-
-					// Protect penalty bars: low-health/survival blinking uses these names.
-					if (lowerName.find("flash") != std::string::npos ||
-						lowerName.find("blink") != std::string::npos ||
-						lowerName.find("penalty") != std::string::npos) {
-						// Is Animated, skip alpha force
-					} else {
-						// Force 100 alpha to skip vanilla fade-ins while ScaleX handles draining.
-						if (d.GetAlpha() < 100.0) {
-							d.SetAlpha(100.0);
-							changed = true;
-						}
-					}
-
-					if (changed) {
-						obj.SetDisplayInfo(d);
-					}
-				}
-
-				// Recurse to handle nested clips (e.g. ChargeMeter_mc).
-				if (_depth > 0) {
-					VisibilityHammer childHammer(_forceVisible, _depth - 1);
-
-					obj.VisitMembers([&childHammer](const char* name, const RE::GFxValue& val) {
-						childHammer.Visit(name, val);
-					});
-				}
-			}
+		return a_index < manager._claimedElements.size() && manager._claimedElements[a_index];
+	}
 
-			private:
-				bool _forceVisible;
-				int _depth;
-	};
-}
+	// A script override replaces the configured mode of every clip
+	int GetElementMode(std::size_t a_index, std::string_view a_path) const
+	{
+		const int overrideMode = manager.GetElementOverride(a_index);
+		return overrideMode >= 0 ? overrideMode : settings.GetWidgetMode(a_path);
+	}
+
+	int GetWidgetMode(std::string_view a_path) const { return manager.ResolveMode(a_path); }
+
+	// Discovered before its plugin registered it (pushed after the HUD pass), or claimed by another HUD controller
+	bool IsWidgetSkipped(std::string_view a_path) const
+	{
+		return (!manager._apiClips.empty() && manager._apiClips.contains(a_path)) ||
+		       (!manager._claimedPaths.empty() && manager._claimedPaths.contains(a_path));
+	}
+
+	const auto& GetWidgetPaths() const { return settings.GetSubWidgetPaths(); }
+	std::uint32_t GetSourceGeneration() const { return settings.GetSourceGeneration(); }
+	std::uint32_t GetSourceGeneration(std::string_view a_path) const { return settings.GetSourceGeneration(a_path); }
+	const std::string& GetWidgetSource(std::string_view a_path) const { return settings.GetWidgetSource(a_path); }
+};
+
+// ==========================================
+// Discovery Sink
+// ==========================================
+
+// Settings, plugin API and URL patterns behind a widget scan (WidgetDiscovery::Sink).
+struct HUDManager::DiscoverySink
+{
+	Settings& settings;
+	PluginAPI& api;
+	bool scansHUDBase;
+
+	bool IsBlockedMember(std::string_view a_name) const { return Utils::IsBlockedMemberName(a_name); }
+
+	WidgetDiscovery::UrlKind ClassifyUrl(std::string_view a_url) const
+	{
+		const auto categories = Utils::MatchPatterns(a_url);
+		if (categories & Utils::kIgnoredUrl) {
+			return WidgetDiscovery::UrlKind::kIgnored;
+		}
+		return (categories & Utils::kVanillaHUDUrl) ? WidgetDiscovery::UrlKind::kVanillaHUD : WidgetDiscovery::UrlKind::kExternal;
+	}
+
+	bool IsRegisteredClip(std::string_view a_path) const { return api.IsRegisteredClip(a_path); }
+	bool BindMovie(std::string_view a_menuName, std::string_view a_url) { return api.BindMovie(a_menuName, a_url); }
+	bool AddDiscoveredPath(std::string_view a_path, std::string_view a_source) { return settings.AddDiscoveredPath(a_path, a_source); }
+	bool ScansHUDBase() const { return scansHUDBase; }
+};
 
 // ==========================================
 // Hooks
@@ -86,6 +87,8 @@ struct HUDMenuAdvanceMovieHook
 {
 	static void thunk(RE::HUDMenu* a_this, float a_interval, std::uint32_t a_currentTime)
 	{
+		Profiler::ScopedTimer timer(Profiler::Stage::kAdvanceMovie);
+
 		func(a_this, a_interval, a_currentTime);
 
 		// If the simulation is frozen (e.g. 'tfc 1'), inject our own delta so we're still able to control HUD
@@ -95,6 +98,8 @@ struct HUDMenuAdvanceMovieHook
 		}
 
 		HUDManager::GetSingleton()->Update(effectiveDelta);
+
+		Profiler::EndFrame();
 	}
 	static inline REL::Relocation<decltype(thunk)> func;
 	static constexpr std::size_t size = 0x05;
@@ -104,6 +109,7 @@ struct StealthMeterHook
 {
 	static char thunk(RE::StealthMeter* a_this, int64_t a2, int64_t a3, int64_t a4)
 	{
+		Profiler::ScopedTimer timer(Profiler::Stage::kStealthMeterHook);
 		auto result = func(a_this, a2, a3, a4);
 		// Minimal task: store the detection level for the main update loop to poll
 		HUDManager::GetSingleton()->UpdateDetectionLevel(static_cast<float>(a_this->unk88));
@@ -127,40 +133,36 @@ void HUDManager::InstallHooks()
 
 	_installed = true;
 
-	// Initial state load and snap (Hard Reset)
-	Reset(true);
+	// Initial state load and snap (Hard Reset).
+	// Settings were already parsed by the startup preload thread.
+	Reset(true, false);
 
 	logger::info("HUDManager hooks installed. StartVisible: {}", _userWantsVisible);
 }
 
-void HUDManager::Reset(bool a_refreshUserPreference)
+void HUDManager::Reset(bool a_refreshUserPreference, bool a_reloadSettings)
 {
 	auto settings = Settings::GetSingleton();
-	settings->Load();
+	if (a_reloadSettings) {
+		settings->Load();
+	}
 
 	// Overwrite the toggle state on startup or save load
 	if (a_refreshUserPreference) {
 		_userWantsVisible = settings->IsStartVisible();
 	}
 
-	_wasHidden = true;
-	_currentAlpha = 0.0f;
-	_targetAlpha = 0.0f;
-	_ctxAlpha = 0.0f;
-	_ctxSneakAlpha = 0.0f;
-	_enchantAlphaL = 0.0f;
-	_enchantAlphaR = 0.0f;
-	_interiorAlpha = 0.0f;
-	_exteriorAlpha = 0.0f;
-	_combatAlpha = 0.0f;
-	_notInCombatAlpha = 0.0f;
-	_weaponAlpha = 0.0f;
-	_lockedOnAlpha = 0.0f;
+	_fade = FadeEngine::State{};
+	Trace::RecordEvent(Trace::kReset);
+
+	_apply.RestartTimer(_timer);
 	_timer = 0.0f;
 	_scanTimer = 0.0f;
 	_displayTimer = 0.0f;
 	_lastDetectionLevel = 0.0f;
-	_lastShoutMeterFixTime = 0.0f;
+	for (auto& widget : _apiWidgets) {
+		widget.retryAt = 0.0f;
+	}
 
 	// Call Update with 0 delta to calculate state and snap UI immediately.
 	// This eliminates delay/flicker when coming out of load screens or menus.
@@ -172,7 +174,14 @@ void HUDManager::ResetSession()
 	_isRuntime = false;
 	_hasScanned = false;
 	_hasInitializedConfig = false;
+	_apply.ResetSession();
+	for (auto& widget : _apiWidgets) {
+		widget.target = RE::GFxValue();
+		widget.movie = RE::GPtr<RE::GFxMovieView>();
+		widget.retryAt = 0.0f;
+	}
 	MCMGen::ResetSessionFlag();  // Clear "NEW FOUND" flag on actual relaunch
+	MCMGen::InvalidateSourceCache();
 }
 
 void HUDManager::StartRuntime()
@@ -245,6 +254,13 @@ void HUDManager::OnButtonDown()
 {
 	const auto settings = Settings::GetSingleton();
 
+	Trace::RecordEvent(Trace::kToggleDown);
+
+	if (settings->IsDumpPerfStatsEnabled()) {
+		Profiler::DumpSummary();
+		_apply.DumpContention();
+	}
+
 	if (settings->IsDumpHUDEnabled()) {
 		SKSE::GetTaskInterface()->AddUITask([this]() {
 			DumpHUDStructure();
@@ -270,6 +286,8 @@ void HUDManager::OnButtonDown()
 
 void HUDManager::OnButtonUp()
 {
+	Trace::RecordEvent(Trace::kToggleUp);
+
 	if (Settings::GetSingleton()->IsHoldMode()) {
 		_userWantsVisible = false;
 		_displayTimer = 0.0f;
@@ -287,7 +305,11 @@ void HUDManager::UpdateDetectionLevel(float a_level)
 
 void HUDManager::Update(float a_delta)
 {
+	Profiler::ScopedTimer timer(Profiler::Stage::kUpdate);
+
+	// Early returns are still recorded so a replay sees every frame (Trace::kSkipped/kDisabled)
 	if (!_installed) {
+		Trace::RecordEarlyReturn(a_delta, Trace::kSkipped);
 		return;
 	}
 
@@ -297,21 +319,34 @@ void HUDManager::Update(float a_delta)
 	const auto settings = Settings::GetSingleton();
 
 	if (!player || !ui) {
+		Trace::RecordEarlyReturn(a_delta, Trace::kSkipped);
 		return;
 	}
 
-	// TESGlobal in esp file to relinquish HUD control
-	if (compat->IsImmersiveHUDDisabled()) {
+	compat->PollExternalControl();
+
+	// Script overrides that steer the fade state itself
+	const auto overrides = ScriptOverrides::GetSingleton();
+	if (const auto generation = overrides->GetGeneration(); generation != _updateOverrideGeneration) {
+		_updateOverrideGeneration = generation;
+		_hudOverride = overrides->GetMode(ScriptOverrides::kHUDElementId);
+		_stealthOverride = overrides->GetMode("iMode_StealthMeter");
+	}
+
+	// TESGlobal in esp file or script override to relinquish HUD control
+	_hudDisabled = compat->IsImmersiveHUDDisabled() || _hudOverride == Settings::kHidden;
+	if (_hudDisabled) {
 		// Release SmoothCam control if we had it
 		if (compat->g_SmoothCam) {
 			compat->ManageSmoothCamCrosshairControl(false);
 			compat->ManageSmoothCamStealthControl(false);
 		}
 
-		if (!_wasHidden) {
-			_wasHidden = true;
+		if (!_fade.wasHidden) {
+			_fade.wasHidden = true;
 			SKSE::GetTaskInterface()->AddUITask([this]() { ApplyAlphaToHUD(0.0f); });
 		}
+		Trace::RecordEarlyReturn(a_delta, Trace::kDisabled);
 		return;
 	}
 
@@ -324,6 +359,14 @@ void HUDManager::Update(float a_delta)
 		}
 	}
 
+	// Script visibility push: shown like a toggle without changing the player's toggle state
+	if (const auto push = overrides->TakeVisibilityPush()) {
+		_pushedVisibleTimer = *push;
+	}
+	if (_pushedVisibleTimer > 0.0f) {
+		_pushedVisibleTimer = std::max(_pushedVisibleTimer - a_delta, 0.0f);
+	}
+
 	// Periodic scan
 	if (a_delta > 0.0f) {
 		_scanTimer += a_delta;
@@ -342,266 +385,104 @@ void HUDManager::Update(float a_delta)
 		if (ui->GetMenu("HUD Menu")) {
 			ScanIfReady();
 		} else {
+			Trace::RecordEarlyReturn(a_delta, Trace::kSkipped);
 			return;
 		}
 	}
 
 	const bool shouldHide = ShouldHideHUD();
 
-	// Cache immediate responsive states
-	const bool isInterior = player->GetParentCell() ? player->GetParentCell()->IsInteriorCell() : false;
-	const bool isInCombat = player->IsInCombat();
-	const bool isWeaponDrawn = compat->IsPlayerWeaponDrawn();
-	const bool isSneaking = player->IsSneaking();
-	const bool isLockedOn = compat->IsTDMActive();
-	const bool isSmoothCam = compat->IsSmoothCamActive();
-	const bool isTDM = compat->IsTDMActive();
-	const bool isBTPS = compat->IsBTPSActive();
+	// Sample everything the fade math depends on
+	FadeEngine::Inputs inputs;
+	inputs.delta = a_delta;
+	inputs.detectionLevel = _lastDetectionLevel;
+	inputs.userWantsVisible = _userWantsVisible || _pushedVisibleTimer > 0.0f;
+	inputs.shouldHide = shouldHide;
+	inputs.isInterior = player->GetParentCell() ? player->GetParentCell()->IsInteriorCell() : false;
+	inputs.isInCombat = player->IsInCombat();
+	inputs.isWeaponDrawn = compat->IsPlayerWeaponDrawn();
+	inputs.isSneaking = player->IsSneaking();
+	// A hidden stealth meter override acts like g_DisableSneak; other modes take manual authority
+	inputs.isSneakAllowed = compat->IsSneakAllowed() && _stealthOverride != Settings::kHidden;
+	inputs.isLockedOn = compat->IsTDMActive();
+	inputs.isSmoothCam = compat->IsSmoothCamActive();
+	inputs.isTDM = compat->IsTDMActive();
+	inputs.isBTPS = compat->IsBTPSActive();
+	// Action: Aiming a Bow, Casting an Aimed Spell.
+	inputs.isActionActive = compat->IsPlayerCasting(player) || compat->IsPlayerAttacking(player);
+	// Look: Hovering over a valid interactable object.
+	inputs.isLookActive = compat->IsCrosshairTargetValid();
+	inputs.hasLeftEnchant = compat->HasEnchantedWeapon(true);
+	inputs.hasRightEnchant = compat->HasEnchantedWeapon(false);
 
 	// Opacity Configuration
-	const float hudMax = settings->GetHUDOpacityMax();
-	const float hudMin = settings->GetHUDOpacityMin();
-	const float ctxMax = settings->GetContextOpacityMax();
-	const float ctxMin = settings->GetContextOpacityMin();
-
-	bool shouldBeVisible = _userWantsVisible;
-	if (!shouldBeVisible) {
-		if ((settings->IsAlwaysShowInCombat() && isInCombat) ||
-			(settings->IsAlwaysShowWeaponDrawn() && isWeaponDrawn)) {
-			shouldBeVisible = true;
-		}
+	_fadeConfig.hudMax = settings->GetHUDOpacityMax();
+	_fadeConfig.hudMin = settings->GetHUDOpacityMin();
+	_fadeConfig.ctxMax = settings->GetContextOpacityMax();
+	_fadeConfig.ctxMin = settings->GetContextOpacityMin();
+	_fadeConfig.fadeInSpeed = settings->GetFadeInSpeed();
+	_fadeConfig.fadeOutSpeed = settings->GetFadeOutSpeed();
+	_fadeConfig.alwaysShowInCombat = settings->IsAlwaysShowInCombat();
+	_fadeConfig.alwaysShowWeaponDrawn = settings->IsAlwaysShowWeaponDrawn();
+	_fadeConfig.crosshairEnabled = settings->GetCrosshairSettings().enabled;
+	_fadeConfig.crosshairHideWhileAiming = settings->GetCrosshairSettings().hideWhileAiming;
+	_fadeConfig.crosshairHideWhileSneaking = settings->GetCrosshairSettings().hideWhileSneaking;
+	_fadeConfig.sneakMeterEnabled = settings->GetSneakMeterSettings().enabled && _stealthOverride < 0;
+	_fadeConfig.detectionClaimed = _detectionClaimed;
+
+	// The stealth meter mode is only consulted while sneaking under manual authority
+	if (inputs.isSneaking && !_fadeConfig.sneakMeterEnabled) {
+		_fadeConfig.stealthMeterMode = _stealthOverride >= 0 ? _stealthOverride : settings->GetWidgetMode("_root.HUDMovieBaseInstance.StealthMeterInstance");
 	}
-	_targetAlpha = shouldBeVisible ? hudMax : hudMin;
-
-	// Per-element state targets helper
-	auto getTarget = [&](bool active) { return active ? hudMax : hudMin; };
 
-	// Per-element state targets for fancy linear fading
-	float targetInterior = getTarget(isInterior);
-	float targetExterior = getTarget(!isInterior);
-	float targetCombat = getTarget(isInCombat);
-	float targetNotInCombat = getTarget(!isInCombat);
-	float targetWeapon = getTarget(isWeaponDrawn);
-	float targetLockedOn = getTarget(isLockedOn);
-
-	// Calculate Contextual States
-	// Action: Aiming a Bow, Casting an Aimed Spell.
-	bool isActionActive = compat->IsPlayerCasting(player) || compat->IsPlayerAttacking(player);
-	// Look: Hovering over a valid interactable object.
-	bool isLookActive = compat->IsCrosshairTargetValid() && !isBTPS;
-
-	// Crosshair Target Alpha
-	float targetCtx = ctxMin;
-	bool blockSmoothCam = false;
-
-	if (settings->GetCrosshairSettings().enabled) {
-		bool isHiddenByAiming = settings->GetCrosshairSettings().hideWhileAiming && isActionActive;
-		bool isHiddenBySneaking = settings->GetCrosshairSettings().hideWhileSneaking && isSneaking;
-
-		// Visibility Authority: Merge contextual states.
-		bool shouldDrawCrosshair = (isActionActive || isLookActive);
-
-		// SmoothCam Block Logic:
-		// We block SmoothCam if we want to hide it explicitly (aiming), or if there's no reason to draw at all.
-		// We DO NOT block SmoothCam just because we are sneaking (since it draws its arc/3D crosshair in worldspace).
-		blockSmoothCam = isHiddenByAiming || !shouldDrawCrosshair;
-
-		// Alpha Calculation for 2D HUD Crosshair:
-		if (isHiddenByAiming || isHiddenBySneaking) {
-			targetCtx = 0.0f;
-		} else if (shouldDrawCrosshair) {
-			if (isTDM) {
-				// TDM handles rendering; vanilla is suppressed
-				targetCtx = 0.0f;
-			} else {
-				// Target 100% for active use/SmoothCam, 50% for passive interaction
-				if (isActionActive || isSmoothCam) {
-					targetCtx = ctxMax;
-				} else {
-					targetCtx = std::max(ctxMin, ctxMax * 0.5f);
-				}
-			}
-		} else {
-			targetCtx = ctxMin;
-		}
-	} else {
-		// If Contextual Crosshair is disabled in settings, link it to the global toggle
-		targetCtx = _targetAlpha;
-		blockSmoothCam = (targetCtx <= 0.01f);
-	}
+	const auto targets = FadeEngine::ComputeTargets(_fade, inputs, _fadeConfig);
+	_fadeTargets = targets;
 
 	// SmoothCam API: Request control (block) to hide, release (unblock) to draw
-	if (isSmoothCam && !shouldHide) {
-		compat->ManageSmoothCamCrosshairControl(blockSmoothCam);
-	}
-
-	// Sneak Meter Target Alpha
-	float targetSneak = 0.0f;
-	float sneakFadeSpeed = settings->GetFadeOutSpeed();
-	if (isSneaking && compat->IsSneakAllowed()) {
-		if (settings->GetSneakMeterSettings().enabled) {
-			// Contextual Authority: detection level math mixed with global toggle state
-			float detectionAlpha = _lastDetectionLevel * 0.85f;
-
-			// Detection Meter Compatibility:
-			// If installed, hide vanilla meter unless we are aiming (Contextual Crosshair logic).
-			if (compat->IsDetectionMeterInstalled()) {
-				detectionAlpha = isActionActive ? 100.0f : 0.0f;
-			}
-
-			targetSneak = std::max(detectionAlpha, _currentAlpha);
-
-			// Normalize raw detection (0-100) to a 0.0-1.0 scalar.
-			float scalar = std::clamp(targetSneak / 100.0f, 0.0f, 1.0f);
-
-			// Map the scalar to the Context Opacity Range [Min, Max].
-			targetSneak = ctxMin + (scalar * (ctxMax - ctxMin));
-
-			// Determine context speed
-			sneakFadeSpeed = (targetSneak > _ctxSneakAlpha) ? settings->GetFadeInSpeed() : settings->GetFadeOutSpeed();
-
-		} else {
-			// Manual Authority: follow linear state synchronization trackers
-			int widgetMode = settings->GetWidgetMode("_root.HUDMovieBaseInstance.StealthMeterInstance");
-			switch (widgetMode) {
-			case Settings::kVisible:
-				targetSneak = hudMax;
-				break;
-			case Settings::kInterior:
-				targetSneak = targetInterior;
-				break;
-			case Settings::kExterior:
-				targetSneak = targetExterior;
-				break;
-			case Settings::kInCombat:
-				targetSneak = targetCombat;
-				break;
-			case Settings::kNotInCombat:
-				targetSneak = targetNotInCombat;
-				break;
-			case Settings::kWeaponDrawn:
-				targetSneak = targetWeapon;
-				break;
-			case Settings::kHidden:
-				targetSneak = 0.0f;
-				break;
-			case Settings::kIgnored:
-				targetSneak = 100.0f;
-				break;
-			default:
-				targetSneak = _currentAlpha;
-				break;  // kImmersive
-			}
-			sneakFadeSpeed = (targetSneak > _ctxSneakAlpha) ? settings->GetFadeInSpeed() : settings->GetFadeOutSpeed();
-		}
-	} else {
-		// Player stood up or globally disabled: target hard 0
-		targetSneak = 0.0f;
-		sneakFadeSpeed = 16.0f;  // Fast-fade exit
-	}
-
-	if (isSmoothCam && !shouldHide) {
-		compat->ManageSmoothCamStealthControl(targetSneak <= 0.01f);
+	if (inputs.isSmoothCam && !shouldHide) {
+		compat->ManageSmoothCamCrosshairControl(targets.blockSmoothCam);
+		compat->ManageSmoothCamStealthControl(targets.sneak <= 0.01f);
 	}
 
-	// Enchantment Target Logic
-	const bool weaponsActive = isWeaponDrawn;
-	const bool leftEnch = compat->HasEnchantedWeapon(true);
-	const bool rightEnch = compat->HasEnchantedWeapon(false);
+	// SmoothCam is drawing its own crosshair; the engine forces our crosshair alpha to 0 so we don't blip on shot release
+	inputs.smoothCamOwnsCrosshair = inputs.isSmoothCam && !compat->HasSmoothCamCrosshairControl();
 
-	float targetEnL = (weaponsActive && leftEnch) ? hudMax : hudMin;
-	float targetEnR = (weaponsActive && rightEnch) ? hudMax : hudMin;
+	Trace::RecordFrame(inputs, _fadeConfig);
 
-	// Dual-wield handshaking: forces synchronous fading regardless of equipment delay.
-	if (weaponsActive && leftEnch && rightEnch) {
-		float highest = std::max(_enchantAlphaL, _enchantAlphaR);
-		_enchantAlphaL = highest;
-		_enchantAlphaR = highest;
-	}
-
-	// 2. Handle Hidden State & Transitions
+	// Handle Hidden State & Transitions
 	if (shouldHide && a_delta > 0.0f) {
-		_wasHidden = true;
+		_fade.wasHidden = true;
 		compat->ManageSmoothCamCrosshairControl(true);
 		compat->ManageSmoothCamStealthControl(true);
 		SKSE::GetTaskInterface()->AddUITask([this]() { ApplyAlphaToHUD(0.0f); });
 		return;
 	}
 
-	// Snap to target instantly when coming out of a menu or loading to match vanilla behaviour
-	if (_wasHidden) {
-		_currentAlpha = _targetAlpha;
-		_enchantAlphaL = targetEnL;
-		_enchantAlphaR = targetEnR;
-		_interiorAlpha = targetInterior;
-		_exteriorAlpha = targetExterior;
-		_combatAlpha = targetCombat;
-		_notInCombatAlpha = targetNotInCombat;
-		_weaponAlpha = targetWeapon;
-		_lockedOnAlpha = targetLockedOn;
-		_ctxAlpha = targetCtx;
-		_ctxSneakAlpha = targetSneak;
-		_wasHidden = false;
-	}
+	// Snap after a hidden period, then step every channel (stepping is skipped if a_delta is 0)
+	FadeEngine::Advance(_fade, targets, inputs, _fadeConfig);
 
-	// 3. Mixed Math Calculations (Skip if a_delta is 0)
 	if (a_delta > 0.0f) {
-		const float speedIn = settings->GetFadeInSpeed();
-		const float speedOut = settings->GetFadeOutSpeed();
-		const float changeIn = speedIn * (a_delta * 60.0f);
-		const float changeOut = speedOut * (a_delta * 60.0f);
-
-		// Helper lambda for consistent linear transitions
-		auto UpdateLinear = [&](float& a_currentAlpha, float a_targetAlpha) {
-			float change = (a_currentAlpha < a_targetAlpha) ? changeIn : changeOut;
-
-			if (std::abs(a_currentAlpha - a_targetAlpha) <= change) {
-				a_currentAlpha = a_targetAlpha;
-			} else if (a_currentAlpha < a_targetAlpha) {
-				a_currentAlpha += change;
-			} else {
-				a_currentAlpha -= change;
-			}
-		};
-
-		// Global HUD & State Conditions: Linear Math (Vanilla Feel)
-		UpdateLinear(_currentAlpha, _targetAlpha);
-		UpdateLinear(_enchantAlphaL, targetEnL);
-		UpdateLinear(_enchantAlphaR, targetEnR);
-		UpdateLinear(_interiorAlpha, targetInterior);
-		UpdateLinear(_exteriorAlpha, targetExterior);
-		UpdateLinear(_combatAlpha, targetCombat);
-		UpdateLinear(_notInCombatAlpha, targetNotInCombat);
-		UpdateLinear(_weaponAlpha, targetWeapon);
-		UpdateLinear(_lockedOnAlpha, targetLockedOn);
-
-		// Crosshair: Lerp Math (Smooth Feel)
-		if (isSmoothCam && !compat->HasSmoothCamCrosshairControl()) {
-			// SmoothCam is drawing its own crosshair; force our internal alpha to 0 so we don't blip on shot release
-			_ctxAlpha = 0.0f;
-		} else {
-			float ctxSpeed = (targetCtx > _ctxAlpha) ? speedIn : speedOut;
-			_ctxAlpha = std::lerp(_ctxAlpha, targetCtx, a_delta * ctxSpeed);
-			if (std::abs(_ctxAlpha - targetCtx) < 0.1f) {
-				_ctxAlpha = targetCtx;
-			}
-		}
-
-		// Stealth Meter: Mixed Math depending on mode
-		if (settings->GetSneakMeterSettings().enabled || !isSneaking) {
-			_ctxSneakAlpha = std::lerp(_ctxSneakAlpha, targetSneak, a_delta * sneakFadeSpeed);
-			if (std::abs(_ctxSneakAlpha - targetSneak) < 0.1f) {
-				_ctxSneakAlpha = targetSneak;
-			}
-		} else {
-			UpdateLinear(_ctxSneakAlpha, targetSneak);
-		}
-
 		_prevDelta = a_delta;
 		_timer += _prevDelta;
 	}
 
-	ApplyAlphaToHUD(_currentAlpha);
+	ApplyAlphaToHUD(_fade.currentAlpha);
+
+	// Per-fade write totals of the global channel
+	if (Profiler::g_enabled.load(std::memory_order_relaxed)) {
+		const bool fading = std::abs(_fade.currentAlpha - _fade.targetAlpha) > 0.01f;
+		if (fading || _fadeWrites.active) {
+			_fadeWrites.writes += Profiler::GetFrameCount(Profiler::Counter::kAlphaWrites);
+			_fadeWrites.frames++;
+		}
+		if (fading) {
+			_fadeWrites.active = true;
+		} else if (_fadeWrites.active) {
+			logger::info("[Perf] Fade to {:.1f}: {} alpha writes over {} frames (step {:.2f})",
+				_fade.targetAlpha, _fadeWrites.writes, _fadeWrites.frames, settings->GetAlphaStep());
+			_fadeWrites = FadeWriteStats{};
+		}
+	}
 }
 
 // ==========================================
@@ -610,13 +491,15 @@ void HUDManager::Update(float a_delta)
 
 bool HUDManager::ShouldHideHUD()
 {
+	Profiler::ScopedTimer timer(Profiler::Stage::kShouldHideHUD);
+
 	auto ui = RE::UI::GetSingleton();
 	if (!ui) {
 		return false;
 	}
 
-	// 1. Check if we're disabled by global
-	if (Compat::GetSingleton()->IsImmersiveHUDDisabled()) {
+	// 1. Check if we're disabled by global or script override
+	if (_hudDisabled) {
 		return true;
 	}
 
@@ -638,142 +521,10 @@ bool HUDManager::ShouldHideHUD()
 	return false;
 }
 
-// ==========================================
-//  Health/Magicka/Stamina Meter Helpers
-// ==========================================
-
-// Depth 0 is critical: protects Survival penalties and resource blinking from freezing.
-void HUDManager::EnforceHMSMeterVisible(RE::GFxValue& a_parent, bool a_forcePermanent)
-{
-	if (a_parent.IsObject()) {
-		VisibilityHammer hammer(a_forcePermanent, 0);
-		a_parent.VisitMembers([&](const char* name, const RE::GFxValue& val) {
-			hammer.Visit(name, val);
-		});
-	}
-}
-
-// Depth 1 is critical: reaches ChargeMeter_mc to kill vanilla auto-hide logic.
-void HUDManager::EnforceEnchantMeterVisible(RE::GFxValue& a_parent)
-{
-	if (a_parent.IsObject()) {
-		VisibilityHammer hammer(true, 1);
-		a_parent.VisitMembers([&](const char* name, const RE::GFxValue& val) {
-			hammer.Visit(name, val);
-		});
-	}
-}
-
-// ==========================================
-// Enchantment Charge Meter Helpers
-// ==========================================
-
-bool HUDManager::IsEnchantmentElement(const char* a_elementId, bool& a_isLeft, bool& a_isRight, bool& a_isSkyHUD) const
-{
-	a_isLeft = (strcmp(a_elementId, "iMode_EnchantLeft") == 0);
-	a_isRight = (strcmp(a_elementId, "iMode_EnchantRight") == 0);
-	a_isSkyHUD = (strcmp(a_elementId, "iMode_EnchantCombined") == 0);
-
-	return a_isLeft || a_isRight || a_isSkyHUD;
-}
-
-// kIgnored block: simulates vanilla hide-when-full while fixing the reappear bug.
-float HUDManager::CalculateEnchantmentIgnoredAlpha(bool a_isEnchantLeft,
-	bool a_isEnchantSkyHUD, bool a_menuOpen, float a_alphaL, float a_alphaR) const
-{
-	const auto compat = Compat::GetSingleton();
-
-	if (a_isEnchantSkyHUD) {
-		return std::max(a_alphaL, a_alphaR);
-	} else {
-		bool full = a_isEnchantLeft ? compat->IsEnchantmentFull(true) : compat->IsEnchantmentFull(false);
-		float tracked = a_isEnchantLeft ? a_alphaL : a_alphaR;
-		return (a_menuOpen || full) ? 0.0f : tracked;
-	}
-}
-
-// Helper that handles visibility logic for a single SkyHUD sub-meter
-void HUDManager::ApplySkyHUDSubMeter(RE::GFxValue& a_parent, const char* a_memberName,
-	bool a_shouldBeVisible, bool a_callHammer)
-{
-	RE::GFxValue sub;
-	if (a_parent.GetMember(a_memberName, &sub)) {
-		RE::GFxValue::DisplayInfo s;
-		if (sub.GetDisplayInfo(&s)) {
-			s.SetVisible(a_shouldBeVisible);
-			s.SetAlpha(a_shouldBeVisible ? 100.0 : 0.0);
-			sub.SetDisplayInfo(s);
-		}
-		if (a_shouldBeVisible && a_callHammer) {
-			EnforceEnchantMeterVisible(sub);
-		}
-	}
-}
-
-// Unified method that handles both IgnoredMode and Hammer cases
-void HUDManager::ApplySkyHUDEnchantment(RE::GFxValue& a_elem, float a_alphaL, float a_alphaR,
-	float a_managedAlpha, int a_mode, bool a_isIgnoredMode)
-{
-	const auto compat = Compat::GetSingleton();
-
-	bool lVal, rVal;
-
-	if (a_isIgnoredMode) {
-		// IgnoredMode: check fullness state
-		bool lFull = compat->IsEnchantmentFull(true);
-		bool rFull = compat->IsEnchantmentFull(false);
-		lVal = (a_alphaL > 0.01f) && !lFull;
-		rVal = (a_alphaR > 0.01f) && !rFull;
-	} else {
-		// Hammer mode: check weapon drawn state and mode
-		bool drawn = compat->IsPlayerWeaponDrawn();
-		lVal = drawn && compat->HasEnchantedWeapon(true);
-		rVal = drawn && compat->HasEnchantedWeapon(false);
-
-		if (a_mode == Settings::kImmersive && a_managedAlpha < 0.1f) {
-			lVal = false;
-			rVal = false;
-		}
-	}
-
-	// Apply to all three sub-meters using helper
-	ApplySkyHUDSubMeter(a_elem, "ChargeMeterFrameAlt", lVal || rVal, true);
-	ApplySkyHUDSubMeter(a_elem, "ChargeMeterLeftAlt", lVal, true);
-	ApplySkyHUDSubMeter(a_elem, "ChargeMeterRightAlt", rVal, true);
-}
-
-double HUDManager::CalculateEnchantmentTargetAlpha(bool a_isEnchantLeft,
-	bool a_isEnchantSkyHUD, int a_mode, float a_alphaL, float a_alphaR, double a_managedAlpha) const
-{
-	float tracked = a_isEnchantSkyHUD ? std::max(a_alphaL, a_alphaR) : (a_isEnchantLeft ? a_alphaL : a_alphaR);
-
-	if (a_mode == Settings::kVisible) {
-		return tracked;
-	} else {
-		return std::min(tracked, static_cast<float>(a_managedAlpha));
-	}
-}
-
 // ==========================================
 // Scanning Helpers
 // ==========================================
 
-void HUDManager::ScanForContainers(RE::GFxMovieView* a_movie, int& a_foundCount, bool& a_changes)
-{
-	if (!a_movie) {
-		return;
-	}
-	RE::GFxValue root;
-	if (!a_movie->GetVariable(&root, "_root")) {
-		return;
-	}
-
-	Utils::ContainerDiscoveryVisitor visitor(a_foundCount, a_changes, "_root");
-	root.VisitMembers([&](const char* name, const RE::GFxValue& val) {
-		visitor.Visit(name, val);
-	});
-}
-
 void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRuntime)
 {
 	auto* ui = RE::UI::GetSingleton();
@@ -781,20 +532,29 @@ void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRu
 		return;
 	}
 
+	Profiler::ScopedTimer scanTimer(Profiler::Stage::kWidgetScan);
+
 	bool changes = false;
 	int externalCount = 0;
-	int containerCount = 0;
 	auto* settings = Settings::GetSingleton();
+	auto* api = PluginAPI::GetSingleton();
+	DiscoverySink sink{ *settings, *api, !Compat::GetSingleton()->IsInpaSekiroCombatLoaded() };
+	WidgetDiscovery::Result containers;
 
 	auto hud = ui->GetMenu("HUD Menu");
 	RE::GFxMovieView* hudMovie = (hud && hud->uiMovie) ? hud->uiMovie.get() : nullptr;
 
+	// Reused across menus and clips: only the first URLs and paths of a scan allocate
+	std::string url;
+	std::string decodedUrl;
+	std::string path;
+
 	// Scan External Menus
 	for (auto& [name, entry] : ui->menuMap) {
 		if (!entry.menu || !entry.menu->uiMovie) {
 			continue;
 		}
-		std::string menuName(name.c_str());
+		const std::string_view menuName(name.c_str());
 
 		// Explicitly exclude Fader Menu here to preserve vanilla fade timing.
 		if (menuName == "HUD Menu" || menuName == "Fader Menu" || Utils::IsSystemMenu(menuName)) {
@@ -804,29 +564,33 @@ void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRu
 			continue;
 		}
 
+		// Registered through the plugin API: controlled from the registration, never discovered
+		if (api->IsRegisteredMenu(menuName)) {
+			continue;
+		}
+
 		// Interactive Menus (Pruning Logic)
 		if (Utils::IsInteractiveMenu(entry.menu.get())) {
 			Utils::LogMenuFlags(menuName, entry.menu.get());
 
 			// REGISTER AS INTERACTIVE SOURCE
 			// This allows MCMGen to prune it even if the menu is closed later.
-			std::string url = Utils::GetMenuURL(entry.menu->uiMovie);
-			Utils::RegisterInteractiveSource(Utils::UrlDecode(url));
+			Utils::GetMenuURL(entry.menu->uiMovie.get(), url);
+			Utils::UrlDecode(url, decodedUrl);
+			Utils::RegisterInteractiveSource(decodedUrl);
 
 			// Force a config check once per session for this menu
 			// so that if it was previously in the config, it gets removed.
-			static std::unordered_set<std::string> prunedSessionList;
-			if (!prunedSessionList.contains(menuName)) {
+			if (!_prunedInteractiveMenus.contains(menuName)) {
 				changes = true;
-				prunedSessionList.insert(menuName);
+				_prunedInteractiveMenus.emplace(menuName);
 			}
 
 			continue;
 		}
 
 		// Standard External Widget Discovery
-		std::string url = Utils::GetMenuURL(entry.menu->uiMovie);
-		if (settings->AddDiscoveredPath(menuName, url)) {
+		if (WidgetDiscovery::ScanMenu<RE::GFxMovieView, RE::GFxValue>(menuName, entry.menu->uiMovie.get(), url, sink)) {
 			changes = true;
 			externalCount++;
 			Utils::LogMenuFlags(menuName, entry.menu.get());
@@ -838,26 +602,22 @@ void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRu
 	bool skyUIContainerFound = false;
 
 	if (hudMovie) {
-		if (a_deepScan) {
-			ScanForContainers(hudMovie, containerCount, changes);
-		} else {
-			RE::GFxValue root;
-			if (hudMovie->GetVariable(&root, "_root")) {
-				RE::GFxValue widgetContainer;
-				if (root.GetMember("WidgetContainer", &widgetContainer)) {
-					Utils::ScanArrayContainer("_root.WidgetContainer", widgetContainer, containerCount, changes);
-				}
-			}
-		}
-
 		// Explicitly verify if the SkyUI "WidgetContainer" member exists.
 		// We use this flag specifically to control the MCMGen pruning logic.
-		// If we relied on 'containerCount', other mods could trigger it, causing SkyUI widgets
+		// If we relied on 'containers.found', other mods could trigger it, causing SkyUI widgets
 		// to be pruned before they have loaded.
-		RE::GFxValue rootVal, wcVal;
-		if (hudMovie->GetVariable(&rootVal, "_root") && rootVal.GetMember("WidgetContainer", &wcVal)) {
+		RE::GFxValue root, widgetContainer;
+		if (hudMovie->GetVariable(&root, "_root") && root.GetMember("WidgetContainer", &widgetContainer)) {
 			skyUIContainerFound = true;
 		}
+
+		if (a_deepScan) {
+			WidgetDiscovery::ScanForContainers<RE::GFxMovieView, RE::GFxValue>(hudMovie, path, sink, containers);
+		} else if (skyUIContainerFound) {
+			path.assign("_root.WidgetContainer");
+			WidgetDiscovery::ScanArrayContainer(path, widgetContainer, sink, containers);
+		}
+		changes |= containers.changes;
 	}
 
 	// Only mark populated if the ACTUAL SkyUI container is found.
@@ -866,6 +626,22 @@ void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRu
 		_widgetsPopulated = true;
 	}
 
+	scanTimer.Stop();
+
+	// New content may have added clips that were absent before
+	if (changes) {
+		_apply.InvalidateLayout();
+	}
+
+	// Startup fast path: at the main menu, last launch's config stays valid while nothing it depends on changed.
+	// Regeneration is deferred until a scan reports a real change.
+	const bool isMainMenuScan = !a_deepScan && !a_isRuntime;
+	if (isMainMenuScan && !changes && !a_forceUpdate && !_hasInitializedConfig && settings->IsLaunchFingerprintCurrent()) {
+		_hasInitializedConfig = true;
+		logger::info("Launch fingerprint unchanged. Skipping main menu config generation.");
+		return;
+	}
+
 	// Only proceed to update config.json if something actually changed.
 	if (changes || a_forceUpdate || !_hasInitializedConfig) {
 		Settings::GetSingleton()->Load();
@@ -880,9 +656,9 @@ void HUDManager::ScanForWidgets(bool a_forceUpdate, bool a_deepScan, bool a_isRu
 
 		// Only log if we found new *user* content (External/Widgets).
 		// Silently handle vanilla internal updates to avoid log spam when counts are 0.
-		if (changes && (externalCount > 0 || containerCount > 0)) {
+		if (changes && (externalCount > 0 || containers.found > 0)) {
 			logger::info("Config updated [Runtime={}]. Found {} external, {} internal.",
-				a_isRuntime, externalCount, containerCount);
+				a_isRuntime, externalCount, containers.found);
 		}
 	}
 }
@@ -925,507 +701,374 @@ void HUDManager::DumpHUDStructure()
 }
 
 // ==========================================
-// Ignored Visibility Helper
+// HUD Application
 // ==========================================
 
-void HUDManager::EnforceIgnoredVisibility(RE::GFxValue& a_target)
+void HUDManager::ApplyHUDMenuSpecifics(RE::GPtr<RE::GFxMovieView> a_movie, float a_globalAlpha, bool a_menuOpen, bool a_isConsoleOpen)
 {
-	RE::GFxValue::DisplayInfo dInfo;
-	if (a_target.GetDisplayInfo(&dInfo)) {
-		bool changed = false;
-
-		// 1. Ensure the element is flagged as Visible
-		if (!dInfo.GetVisible()) {
-			dInfo.SetVisible(true);
-			changed = true;
-		}
+	// A reloaded HUD movie may use a different layout
+	if (a_movie != _elementCacheMovie) {
+		_apply.InvalidateLayout();
+		_elementCacheMovie = a_movie;
+	}
 
-		// 2. Alpha Correction
-		// If a widget is effectively invisible (Alpha ~0) despite being flagged "Visible",
-		// force it to 100. We use a low threshold to avoid overriding intended
-		// partial transparency (e.g., a widget that is naturally 50% opacity).
-		if (dInfo.GetAlpha() < 1.0) {
-			dInfo.SetAlpha(100.0);
-			changed = true;
-		}
+	_apply.ApplyHUD(a_movie.get(), ApplyHost{ *this, *Settings::GetSingleton() });
 
-		if (changed) {
-			a_target.SetDisplayInfo(dInfo);
+	for (auto& widget : _apiWidgets) {
+		if (widget.registration.type == PluginAPI::TargetType::Clip) {
+			PushApiWidget(widget, a_movie, a_globalAlpha, a_menuOpen, a_isConsoleOpen);
 		}
 	}
 }
 
-// ==========================================
-// HUD Application
-// ==========================================
+// Channel a mode's alpha is stepped on, or nullopt for modes with a fixed alpha.
+std::optional<FadeEngine::Channel> HUDManager::GetFadeChannel(int a_mode, bool a_isCrosshair) const
+{
+	return FadeEngine::GetChannel(_fade, _fadeTargets, a_mode, a_isCrosshair);
+}
 
-void HUDManager::ApplyHUDMenuSpecifics(RE::GPtr<RE::GFxMovieView> a_movie, float a_globalAlpha)
+// Output quantization (fAlphaStep): mid-fade alphas snap to the step so a write only goes out when the
+// quantized value changes. The channel's end target, 0 and fixed-mode alphas are always written exactly.
+// The math lives in FadeEngine::QuantizeAlpha so tests/FadeEngineTests.cpp can run it on the host.
+double HUDManager::QuantizeAlpha(double a_alpha, const std::optional<FadeEngine::Channel>& a_channel) const
 {
-	const auto settings = Settings::GetSingleton();
-	const auto compat = Compat::GetSingleton();
-	const auto player = RE::PlayerCharacter::GetSingleton();
-	const auto ui = RE::UI::GetSingleton();
+	if (!a_channel) {
+		return a_alpha;
+	}
+	return FadeEngine::QuantizeAlpha(a_alpha, Settings::GetSingleton()->GetAlphaStep(), a_channel->end);
+}
 
-	const bool menuOpen = ShouldHideHUD();
-	const bool isConsoleOpen = ui && ui->IsMenuOpen(RE::Console::MENU_NAME);
-
-	const float hudMax = settings->GetHUDOpacityMax();
-
-	// Management of vanilla elements; target 0 alpha while menus are open to respect engine hiding.
-	const float managedAlpha = menuOpen ? 0.0f : a_globalAlpha;
-	const float alphaL = menuOpen ? 0.0f : _enchantAlphaL;
-	const float alphaR = menuOpen ? 0.0f : _enchantAlphaR;
-	const float interiorAlpha = menuOpen ? 0.0f : _interiorAlpha;
-	const float exteriorAlpha = menuOpen ? 0.0f : _exteriorAlpha;
-	const float combatAlpha = menuOpen ? 0.0f : _combatAlpha;
-	const float notInCombatAlpha = menuOpen ? 0.0f : _notInCombatAlpha;
-	const float weaponAlpha = menuOpen ? 0.0f : _weaponAlpha;
-	const float lockedOnAlpha = menuOpen ? 0.0f : _lockedOnAlpha;
-
-	// Immediate state checks for Visibility Hammer logic
-	const bool isSneaking = player && player->IsSneaking();
-	const bool isSmoothCam = compat->IsSmoothCamActive();
-	const bool hasSmoothCamCrosshairControl = compat->HasSmoothCamCrosshairControl();
-
-	// Local set to track paths processed in this frame and prevent growth leaks
-	std::unordered_set<std::string> processedPaths;
-
-	for (const auto& def : HUDElements::Get()) {
-		bool isCompass = (strcmp(def.id, "iMode_Compass") == 0);
-		bool isShoutMeter = (strcmp(def.id, "iMode_ShoutMeter") == 0);
-		bool isStealthMeter = (strcmp(def.id, "iMode_StealthMeter") == 0);
-		bool isHealth = (strcmp(def.id, "iMode_Health") == 0);
-		bool isMagicka = (strcmp(def.id, "iMode_Magicka") == 0);
-		bool isStamina = (strcmp(def.id, "iMode_Stamina") == 0);
-		bool isTemperature = (strcmp(def.id, "iMode_Temperature") == 0);
-
-		// INPA SEKIRO FIX: Completely skip stamina handling if Inpa is managing it
-		if (isStamina && compat->IsInpaSekiroCombatLoaded()) {
-			continue;
+// Copies the plugin API registrations when they changed. Widgets keep their resolved target and pushed
+// values across copies; unregistered or retargeted ones are handed back at full alpha.
+void HUDManager::SyncPluginAPI()
+{
+	const auto api = PluginAPI::GetSingleton();
+	const auto generation = api->GetGeneration();
+	if (generation == _apiGeneration) {
+		return;
+	}
+	_apiGeneration = generation;
+
+	std::vector<PluginAPI::Widget> registrations;
+	std::vector<PluginAPI::Claim> claims;
+	api->Snapshot(registrations, _apiSubscribers, claims);
+
+	std::vector<ApiWidget> widgets;
+	widgets.reserve(registrations.size());
+	std::vector<bool> kept(_apiWidgets.size(), false);
+
+	for (auto& registration : registrations) {
+		ApiWidget widget;
+		for (std::size_t i = 0; i < _apiWidgets.size(); i++) {
+			const auto& old = _apiWidgets[i].registration;
+			if (!kept[i] && old.id == registration.id && old.type == registration.type &&
+				old.target == registration.target && old.boundMenu == registration.boundMenu) {
+				widget = std::move(_apiWidgets[i]);
+				kept[i] = true;
+				break;
+			}
 		}
+		widget.registration = std::move(registration);
+		widgets.push_back(std::move(widget));
+	}
 
-		bool isEnchantLeft, isEnchantRight, isEnchantSkyHUD;
-		bool isEnchantElement = IsEnchantmentElement(def.id, isEnchantLeft, isEnchantRight, isEnchantSkyHUD);
-		bool isResourceBar = isHealth || isMagicka || isStamina;
-		bool isCrosshair = def.isCrosshair;
-
-		for (std::string_view path : def.paths) {
-			processedPaths.insert(std::string(path));
+	for (std::size_t i = 0; i < _apiWidgets.size(); i++) {
+		auto& old = _apiWidgets[i];
+		if (!kept[i] && old.movie && old.target.IsDisplayObject()) {
+			const bool isClip = old.registration.type == PluginAPI::TargetType::Clip;
+			GFxOps::SetAlphaVisible(old.target, 100.0, isClip ? std::optional<bool>(true) : std::nullopt);
+		}
+	}
 
-			int mode = settings->GetWidgetMode(std::string(path));
-			RE::GFxValue elem;
-			if (!a_movie->GetVariable(&elem, path.data()) || !elem.IsDisplayObject()) {
-				continue;
+	_apiWidgets = std::move(widgets);
+	_apiMenus.clear();
+	_apiClips.clear();
+	for (std::size_t i = 0; i < _apiWidgets.size(); i++) {
+		const auto& registration = _apiWidgets[i].registration;
+		switch (registration.type) {
+		case PluginAPI::TargetType::Menu:
+			_apiMenus.emplace(registration.target, i);
+			break;
+		case PluginAPI::TargetType::Movie:
+			if (!registration.boundMenu.empty()) {
+				_apiMenus.emplace(registration.boundMenu, i);
 			}
+			break;
+		case PluginAPI::TargetType::Clip:
+			_apiClips.insert(registration.target);
+			break;
+		}
+	}
 
-			// We need display info to determine if we should even attempt Z-Order fixing
-			RE::GFxValue::DisplayInfo dInfo;
-			if (!elem.GetDisplayInfo(&dInfo)) {
-				continue;
-			}
+	// Every subscriber receives the current value on the next publish
+	_apiPublished.fill(-1.0f);
+
+	// Ownership: newly claimed elements are handed over before their first skipped frame
+	const auto& elements = HUDElements::Get();
+	std::vector<bool> claimedElements(elements.size(), false);
+	decltype(_claimedPaths) claimedPaths;
+	bool detectionClaimed = false;
+
+	for (auto& claim : claims) {
+		const auto def = std::ranges::find_if(elements, [&](const HUDElements::Def& a_def) { return claim.elementId == a_def.id; });
+		if (def != elements.end()) {
+			claimedElements[static_cast<std::size_t>(def - elements.begin())] = true;
+		} else if (claim.elementId == ImmersiveHUDAPI::DetectionElementId) {
+			detectionClaimed = true;
+		} else {
+			claimedPaths.insert(std::move(claim.elementId));
+		}
+	}
 
-			// Shout Meter Z-Order Fix for Infinity UI/Compass Navigation Overhaul
-			// We ensure the visible shout meter stays on top of the compass.
-			// The timer prevents checking every single frame, but aggressive enough to catch updates.
-			// We only fix elements that are currently VISIBLE, otherwise we might
-			// swap a hidden vanilla meter with the compass and mess up the hierarchy.
-			if (isShoutMeter && dInfo.GetVisible()) {
-				if (_timer - _lastShoutMeterFixTime > 2.0f) {
-					// Only update the timer on the very first element we process in this frame
-					_lastShoutMeterFixTime = _timer;
-
-					RE::GFxValue parent;
-					RE::GFxValue compass;
-					if (elem.GetMember("_parent", &parent) && parent.GetMember("Compass", &compass) && compass.IsDisplayObject()) {
-						RE::GFxValue shoutDepthVal, compassDepthVal;
-						elem.Invoke("getDepth", &shoutDepthVal, nullptr, 0);
-						compass.Invoke("getDepth", &compassDepthVal, nullptr, 0);
-
-						if (shoutDepthVal.IsNumber() && compassDepthVal.IsNumber()) {
-							double sDepth = shoutDepthVal.GetNumber();
-							double cDepth = compassDepthVal.GetNumber();
-
-							// If Shout is below Compass, Swap them.
-							if (sDepth < cDepth) {
-								RE::GFxValue args[] = { compass };
-								elem.Invoke("swapDepths", nullptr, args, 1);
-								logger::info("Fixed Shout Meter Z-Order. [Shout: {} < Compass: {}]", sDepth, cDepth);
-							}
-						}
-					}
-				}
-			}
+	for (std::size_t i = 0; i < elements.size(); i++) {
+		if (claimedElements[i] && (i >= _claimedElements.size() || !_claimedElements[i])) {
+			HandOverElement(elements[i]);
+		}
+	}
+	for (const auto& path : claimedPaths) {
+		if (!_claimedPaths.contains(path)) {
+			HandOverPath(path);
+		}
+	}
 
-			// SkyHUD alt charge: hide separate left/right meters completely
-			if ((compat->IsSkyHUDAltChargeEnabled() && (isEnchantLeft || isEnchantRight)) ||
-				(!compat->IsSkyHUDAltChargeEnabled() && isEnchantSkyHUD)) {
-				dInfo.SetVisible(false);
-				dInfo.SetAlpha(0.0f);
-				elem.SetDisplayInfo(dInfo);
-				continue;
-			}
+	_claimedElements = std::move(claimedElements);
+	_claimedPaths = std::move(claimedPaths);
+	_detectionClaimed = detectionClaimed;
+}
 
-			// TESGlobal in esp ensures compass is always hidden if set.
-			if (isCompass && !compat->IsCompassAllowed()) {
-				dInfo.SetAlpha(0.0f);
-				elem.SetDisplayInfo(dInfo);
-				continue;
-			}
+// Restores every clip of a vanilla element to full alpha and visible, as the engine left it.
+void HUDManager::HandOverElement(const HUDElements::Def& a_def)
+{
+	_apply.HandOverElement(_elementCacheMovie.get(), a_def);
+}
 
-			// Stealth Meter Handling (Unified Logic)
-			if (isStealthMeter) {
-				// Managed/Contextual Authority
-				float finalAlpha = _ctxSneakAlpha;
-
-				// Apply Pulse logic (Ensures vanilla mode still breathes when detected)
-				if (settings->GetSneakMeterSettings().enabled && isSneaking && _lastDetectionLevel > 0.1f && finalAlpha > 0.01f) {
-					// Hardcoded constants for sin/pi
-					constexpr float kPulseRange = 0.05f;
-					constexpr float kPulseFreq = 0.05f;
-					constexpr float kTwoPi = 6.2831853f;
-
-					auto detectionFreq = (_lastDetectionLevel / 200.0f) + 0.5f;
-					auto pulse = (kPulseRange * std::sin(kTwoPi * detectionFreq * kPulseFreq * 0.25f * _timer)) + (1.0f - kPulseRange);
-					finalAlpha *= std::min(static_cast<float>(pulse), 1.0f);
-				}
-
-				double targetSneakAlpha = finalAlpha;
-				bool sneakVisible = (targetSneakAlpha > 0.1f) && !menuOpen;
-
-				dInfo.SetVisible(sneakVisible);
-				dInfo.SetAlpha(targetSneakAlpha);
-				elem.SetDisplayInfo(dInfo);
-
-				// Clip Injection: override eye/text clips
-				const char* subPaths[] = { "SneakAnimInstance", "SneakTextHolder" };
-				for (auto p : subPaths) {
-					RE::GFxValue sub;
-					if (elem.GetMember(p, &sub) && sub.IsDisplayObject()) {
-						RE::GFxValue::DisplayInfo sd;
-						if (sub.GetDisplayInfo(&sd)) {
-							sd.SetVisible(sneakVisible);
-							sd.SetAlpha(targetSneakAlpha);
-							sub.SetDisplayInfo(sd);
-						}
-					}
-				}
-				continue;
-			}
+// Same for a dynamic widget (HUD clip path) or an external menu root.
+void HUDManager::HandOverPath(std::string_view a_path)
+{
+	const std::string path(a_path);
+	RE::GFxMovieView* movie = _elementCacheMovie.get();
+	const char* clipPath = path.c_str();
+
+	if (const auto ui = RE::UI::GetSingleton(); ui) {
+		if (const auto menu = ui->GetMenu(path); menu && menu->uiMovie) {
+			movie = menu->uiMovie.get();
+			clipPath = "_root";
+		}
+	}
 
-			// Enchantment kIgnored block
-			if (mode == Settings::kIgnored && isEnchantElement) {
-				float target = CalculateEnchantmentIgnoredAlpha(isEnchantLeft, isEnchantSkyHUD, menuOpen, alphaL, alphaR);
-				if (isEnchantSkyHUD) {
-					ApplySkyHUDEnchantment(elem, alphaL, alphaR, 0.0f, 0, true);
-				}
-				dInfo.SetVisible(target > 0.01);
-				dInfo.SetAlpha(target);
-				elem.SetDisplayInfo(dInfo);
-				if (target > 0.1 && !isEnchantSkyHUD) {
-					EnforceEnchantMeterVisible(elem);
-				}
-				continue;
-			}
+	_apply.HandOverPath(movie, clipPath, a_path);
+}
 
-			// Handle reset for other ignored elements
-			if (mode == Settings::kIgnored) {
-				// For Compass/ShoutMeter, we must respect the external "Visible" state (Vanilla vs Alt).
-				// If it's hidden, it's likely the inactive variant. Don't force it to show.
-				if ((isCompass || isShoutMeter) && !dInfo.GetVisible()) {
-					continue;
-				}
-
-				if (!dInfo.GetVisible() || dInfo.GetAlpha() < 100.0) {
-					// Only force Visible=True if it's NOT a compass/shout element
-					if (!isCompass && !isShoutMeter) {
-						dInfo.SetVisible(true);
-					}
-					dInfo.SetAlpha(100.0);
-					elem.SetDisplayInfo(dInfo);
-				}
-				continue;
-			}
+// Alpha a mode shows this frame. Zero for every mode while the HUD is hidden by menus.
+double HUDManager::GetModeAlpha(int a_mode, float a_globalAlpha, bool a_menuOpen) const
+{
+	if (a_menuOpen || a_mode == Settings::kHidden || a_mode == Settings::kIgnored) {
+		return 0.0;
+	}
+	if (a_mode == Settings::kVisible) {
+		return Settings::GetSingleton()->GetHUDOpacityMax();
+	}
+	if (a_mode == Settings::kImmersive) {
+		return a_globalAlpha;
+	}
 
-			bool shouldBeVisible = true;
-			double targetAlpha = managedAlpha;
-
-			if (mode == Settings::kHidden) {
-				shouldBeVisible = false;
-				targetAlpha = 0.0;
-			} else if (mode == Settings::kInterior) {
-				targetAlpha = interiorAlpha;
-				shouldBeVisible = (interiorAlpha > 0.01) && !menuOpen;
-			} else if (mode == Settings::kExterior) {
-				targetAlpha = exteriorAlpha;
-				shouldBeVisible = (exteriorAlpha > 0.01) && !menuOpen;
-			} else if (mode == Settings::kInCombat) {
-				targetAlpha = combatAlpha;
-				shouldBeVisible = (combatAlpha > 0.01) && !menuOpen;
-			} else if (mode == Settings::kNotInCombat) {
-				targetAlpha = notInCombatAlpha;
-				shouldBeVisible = (notInCombatAlpha > 0.01) && !menuOpen;
-			} else if (mode == Settings::kWeaponDrawn) {
-				targetAlpha = weaponAlpha;
-				shouldBeVisible = (weaponAlpha > 0.01) && !menuOpen;
-			} else if (mode == Settings::kLockedOn) {
-				targetAlpha = lockedOnAlpha;
-				shouldBeVisible = (lockedOnAlpha > 0.01) && !menuOpen;
-			} else if (isEnchantElement) {
-				targetAlpha = CalculateEnchantmentTargetAlpha(isEnchantLeft, isEnchantSkyHUD, mode, alphaL, alphaR, managedAlpha);
-				shouldBeVisible = (targetAlpha > 0.01);
-			} else if (mode == Settings::kVisible) {
-				shouldBeVisible = !menuOpen;
-				targetAlpha = menuOpen ? 0.0 : hudMax;
-			} else {
-				if (isCrosshair) {
-					float ctxBased = (menuOpen ? 0.0f : _ctxAlpha);
-					targetAlpha = ctxBased;
-					shouldBeVisible = (targetAlpha > 0.0);
-				} else {
-					targetAlpha = managedAlpha;
-					shouldBeVisible = (targetAlpha > 0.01) && !menuOpen;
-				}
-			}
+	const auto channel = GetFadeChannel(a_mode);
+	return channel ? channel->current : a_globalAlpha;
+}
 
-			// For Compass AND Shout Meter sub-components, we MUST NOT touch the _visible property.
-			// SkyHUD hides the vanilla frame and shows the Alt frame via _visible.
-			// If we force SetVisible(true), we show both. We rely on Alpha to hide.
-			bool changed = false;
+void HUDManager::PushApiWidget(ApiWidget& a_widget, const RE::GPtr<RE::GFxMovieView>& a_movie, float a_globalAlpha,
+	bool a_menuOpen, bool a_isConsoleOpen)
+{
+	const int mode = a_widget.registration.mode;
+	if (mode == Settings::kIgnored || !a_movie) {
+		return;
+	}
 
-			// Check API owner: If we DO NOT have control, SmoothCam manages the alpha & visibility.
-			bool skipCrosshairEnforcement = isCrosshair && isSmoothCam && !hasSmoothCamCrosshairControl;
+	// Menus active: relinquish control like discovered widgets, and push again once they close
+	if (a_menuOpen && mode != Settings::kHidden && !a_isConsoleOpen) {
+		a_widget.pushedAlpha = -1.0;
+		a_widget.pushedVisible = -1;
+		return;
+	}
 
-			if (!isCompass && !isShoutMeter) {
-				if (!skipCrosshairEnforcement && dInfo.GetVisible() != shouldBeVisible) {
-					dInfo.SetVisible(shouldBeVisible);
-					changed = true;
-				}
-			}
+	const bool isClip = a_widget.registration.type == PluginAPI::TargetType::Clip;
 
-			if (!skipCrosshairEnforcement && std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01) {
-				dInfo.SetAlpha(targetAlpha);
-				changed = true;
-			}
+	if (a_movie != a_widget.movie || !a_widget.target.IsDisplayObject()) {
+		if (_timer < a_widget.retryAt) {
+			return;
+		}
+		const char* path = isClip ? a_widget.registration.target.c_str() : "_root";
+		if (!GFxOps::GetVariable(a_movie.get(), &a_widget.target, path) || !a_widget.target.IsDisplayObject()) {
+			a_widget.target = RE::GFxValue();
+			a_widget.retryAt = _timer + ApiWidget::kRetryInterval;
+			Profiler::Count(Profiler::Counter::kFailedLookups);
+			return;
+		}
+		a_widget.movie = a_movie;
+		a_widget.pushedAlpha = -1.0;
+		a_widget.pushedVisible = -1;
+	}
 
-			if (changed) {
-				elem.SetDisplayInfo(dInfo);
-			}
+	const double alpha = QuantizeAlpha(GetModeAlpha(mode, a_globalAlpha, false), GetFadeChannel(mode));
 
-			// Visibility Hammer logic: Override engine hiding
-			if (shouldBeVisible && (targetAlpha > 0.1 || _wasHidden)) {
-				if (isResourceBar) {
-					// Pass true if the mode is Immersive/Visible to override "hide when full"
-					bool forceOverride = (mode == Settings::kVisible || mode == Settings::kImmersive ||
-										  mode == Settings::kInterior || mode == Settings::kExterior ||
-										  mode == Settings::kInCombat || mode == Settings::kNotInCombat ||
-										  mode == Settings::kWeaponDrawn || mode == Settings::kLockedOn);
-					EnforceHMSMeterVisible(elem, forceOverride);
-				} else if (isTemperature) {
-					// Ensure the Temperature Meter CONTAINER stays visible even if the game wants to hide it.
-					// We verify current state first to avoid flickering caused by snapping Alpha.
-					RE::GFxValue::DisplayInfo tempInfo;
-					if (elem.GetDisplayInfo(&tempInfo)) {
-						if (!tempInfo.GetVisible()) {
-							tempInfo.SetVisible(true);
-							elem.SetDisplayInfo(tempInfo);
-						}
-					}
-				} else if (isEnchantSkyHUD) {
-					ApplySkyHUDEnchantment(elem, 0.0f, 0.0f, static_cast<float>(targetAlpha), mode, false);
-				} else if (isEnchantLeft || isEnchantRight) {
-					EnforceEnchantMeterVisible(elem);
-				}
-			}
+	std::optional<double> alphaWrite;
+	std::optional<bool> visibleWrite;
+	if (std::abs(a_widget.pushedAlpha - alpha) > 0.01) {
+		alphaWrite = alpha;
+	}
+	// Menus only receive alpha, as for discovered external menus
+	if (isClip) {
+		const bool visible = HUDApply::ApplyVisibleHysteresis(alpha > 0.01, a_widget.pushedVisible != 0, alpha, 0.01);
+		if (a_widget.pushedVisible != static_cast<std::int8_t>(visible)) {
+			visibleWrite = visible;
 		}
 	}
 
-	const auto& pathSet = settings->GetSubWidgetPaths();
-	for (const auto& path : pathSet) {
-		if (processedPaths.contains(path) ||
-			path == "_root.HUDMovieBaseInstance.StealthMeterInstance") {
-			continue;
-		}
+	if (!alphaWrite && !visibleWrite) {
+		return;
+	}
 
-		if (path.find("markerData") != std::string::npos ||
-			path.find("widgetLoaderContainer") != std::string::npos) {
-			continue;
-		}
+	// A failed write means the clip is gone: resolve it again
+	if (!GFxOps::SetAlphaVisible(a_widget.target, alphaWrite, visibleWrite)) {
+		a_widget.target = RE::GFxValue();
+		return;
+	}
+	a_widget.pushedAlpha = alpha;
+	if (visibleWrite) {
+		a_widget.pushedVisible = static_cast<std::int8_t>(*visibleWrite);
+	}
+}
 
-		RE::GFxValue elem;
-		if (!a_movie->GetVariable(&elem, path.c_str()) || !elem.IsDisplayObject()) {
+// Publishes the alpha of every channel for API queries and calls the subscribers whose channel changed.
+void HUDManager::PublishChannels(float a_globalAlpha, bool a_menuOpen)
+{
+	std::array<float, PluginAPI::kChannelCount> alphas{};
+	for (std::size_t i = 0; i < alphas.size(); i++) {
+		const int mode = static_cast<int>(i);
+		alphas[i] = static_cast<float>(QuantizeAlpha(GetModeAlpha(mode, a_globalAlpha, a_menuOpen), GetFadeChannel(mode)));
+	}
+	PluginAPI::GetSingleton()->Publish(alphas, !a_menuOpen && a_globalAlpha > 0.01f, _userWantsVisible);
+
+	for (std::size_t i = 0; i < alphas.size(); i++) {
+		if (_apiSubscribers[i].empty() || std::abs(alphas[i] - _apiPublished[i]) <= 0.01f) {
 			continue;
 		}
-
-		// RUNTIME VERIFICATION (Fix for SkyUI WidgetContainer Indices)
-		// Only control widgets if the currently loaded Source matches what we cached.
-		if (!_verifiedPaths.contains(path)) {
-			RE::GFxValue urlVal;
-			if (elem.GetMember("_url", &urlVal) && urlVal.IsString()) {
-				std::string rawUrl = urlVal.GetString();
-				std::string decodedUrl = Utils::UrlDecode(rawUrl);
-				std::string expectedUrl = settings->GetWidgetSource(path);
-
-				if (decodedUrl == expectedUrl) {
-					_verifiedPaths.insert(path);
-				} else {
-					// MISMATCH! Index X has changed owners.
-					// Do not control it. Wait for the Scanner to update Settings.
-					continue;
-				}
-			} else {
-				continue;
-			}
+		_apiPublished[i] = alphas[i];
+		for (const auto& subscriber : _apiSubscribers[i]) {
+			subscriber.callback(static_cast<ImmersiveHUDAPI::Channel>(i), alphas[i], subscriber.userData);
 		}
+	}
+}
+
+void HUDManager::SyncScriptOverrides()
+{
+	const auto overrides = ScriptOverrides::GetSingleton();
+	const auto generation = overrides->GetGeneration();
+	if (generation == _overrideGeneration) {
+		return;
+	}
+	_overrideGeneration = generation;
 
-		int mode = settings->GetWidgetMode(path);
+	std::vector<std::pair<std::string, int>> modes;
+	overrides->Snapshot(modes);
 
-		// Menus active: relinquish control of dynamic widgets to allow 3rd party function.
-		// Important for mod-added system menus, and widgets open during vanilla menus.
-		if (menuOpen && mode != Settings::kHidden && !isConsoleOpen) {
-			continue;
-		}
+	const auto& elements = HUDElements::Get();
+	_elementOverrides.assign(elements.size(), -1);
+	_pathOverrides.clear();
 
-		// Handle passive ignore for dynamic widgets.
-		if (mode == Settings::kIgnored) {
-			EnforceIgnoredVisibility(elem);
+	for (auto& [id, mode] : modes) {
+		if (id == ScriptOverrides::kHUDElementId) {
 			continue;
 		}
-
-		RE::GFxValue::DisplayInfo dInfo;
-		elem.GetDisplayInfo(&dInfo);
-
-		bool shouldBeVisible = true;
-		double targetAlpha = managedAlpha;
-
-		if (mode == Settings::kHidden) {
-			shouldBeVisible = false;
-			targetAlpha = 0.0;
-		} else if (mode == Settings::kVisible) {
-			shouldBeVisible = true;
-			targetAlpha = hudMax;
-		} else if (mode == Settings::kInterior) {
-			shouldBeVisible = (interiorAlpha > 0.01);
-			targetAlpha = interiorAlpha;
-		} else if (mode == Settings::kExterior) {
-			shouldBeVisible = (exteriorAlpha > 0.01);
-			targetAlpha = exteriorAlpha;
-		} else if (mode == Settings::kInCombat) {
-			shouldBeVisible = (combatAlpha > 0.01);
-			targetAlpha = combatAlpha;
-		} else if (mode == Settings::kNotInCombat) {
-			shouldBeVisible = (notInCombatAlpha > 0.01);
-			targetAlpha = notInCombatAlpha;
-		} else if (mode == Settings::kWeaponDrawn) {
-			shouldBeVisible = (weaponAlpha > 0.01);
-			targetAlpha = weaponAlpha;
-		} else if (mode == Settings::kLockedOn) {
-			shouldBeVisible = (lockedOnAlpha > 0.01);
-			targetAlpha = lockedOnAlpha;
+		if (const auto index = HUDElements::IndexOf(id); index < elements.size()) {
+			_elementOverrides[index] = mode;
 		} else {
-			shouldBeVisible = (managedAlpha > 0.01f);
-			targetAlpha = managedAlpha;
-		}
-
-		bool changed = false;
-		if (dInfo.GetVisible() != shouldBeVisible) {
-			dInfo.SetVisible(shouldBeVisible);
-			changed = true;
-		}
-		if (std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01) {
-			dInfo.SetAlpha(targetAlpha);
-			changed = true;
+			_pathOverrides.emplace(std::move(id), mode);
 		}
+	}
+}
 
-		if (changed) {
-			elem.SetDisplayInfo(dInfo);
+int HUDManager::ResolveMode(std::string_view a_path) const
+{
+	if (!_pathOverrides.empty()) {
+		if (const auto it = _pathOverrides.find(a_path); it != _pathOverrides.end()) {
+			return it->second;
 		}
 	}
+	return Settings::GetSingleton()->GetWidgetMode(a_path);
 }
 
 void HUDManager::ApplyAlphaToHUD(float a_alpha)
 {
+	Profiler::ScopedTimer timer(Profiler::Stage::kApplyAlpha);
+
+	SyncPluginAPI();
+	SyncScriptOverrides();
+
 	const auto ui = RE::UI::GetSingleton();
 	const auto settings = Settings::GetSingleton();
 	if (!ui) {
 		return;
 	}
 
-	const bool menuOpen = ShouldHideHUD();
-	const bool isConsoleOpen = ui->IsMenuOpen(RE::Console::MENU_NAME);
+	const auto compat = Compat::GetSingleton();
+	const auto player = RE::PlayerCharacter::GetSingleton();
 
-	// Use already calculated fading alphas
-	const float interiorAlpha = menuOpen ? 0.0f : _interiorAlpha;
-	const float exteriorAlpha = menuOpen ? 0.0f : _exteriorAlpha;
-	const float combatAlpha = menuOpen ? 0.0f : _combatAlpha;
-	const float weaponAlpha = menuOpen ? 0.0f : _weaponAlpha;
-	const float notInCombatAlpha = menuOpen ? 0.0f : _notInCombatAlpha;
-	const float lockedOnAlpha = menuOpen ? 0.0f : _lockedOnAlpha;
-	const float hudMax = settings->GetHUDOpacityMax();
+	HUDApply::Frame frame;
+	frame.timer = _timer;
+	frame.globalAlpha = a_alpha;
+	frame.fade = _fade;
+	frame.targets = _fadeTargets;
+	frame.fadeInSpeed = _fadeConfig.fadeInSpeed;
+	frame.fadeOutSpeed = _fadeConfig.fadeOutSpeed;
+	frame.hudMax = settings->GetHUDOpacityMax();
+	frame.alphaStep = settings->GetAlphaStep();
+	frame.detectionLevel = _lastDetectionLevel;
+	frame.nativeTweens = settings->IsNativeTweensEnabled();
+	frame.sneakMeterEnabled = settings->GetSneakMeterSettings().enabled;
+	frame.menuOpen = ShouldHideHUD();
+	frame.consoleOpen = ui->IsMenuOpen(RE::Console::MENU_NAME);
+	frame.isSneaking = player && player->IsSneaking();
+	frame.compassAllowed = compat->IsCompassAllowed();
+	frame.skyHUDAltCharge = compat->IsSkyHUDAltChargeEnabled();
+	frame.inpaSekiro = compat->IsInpaSekiroCombatLoaded();
+	frame.smoothCam = compat->IsSmoothCamActive();
+	frame.smoothCamCrosshairControl = compat->HasSmoothCamCrosshairControl();
+	frame.weaponDrawn = compat->IsPlayerWeaponDrawn();
+	frame.enchantedLeft = compat->HasEnchantedWeapon(true);
+	frame.enchantedRight = compat->HasEnchantedWeapon(false);
+	frame.enchantFullLeft = compat->IsEnchantmentFull(true);
+	frame.enchantFullRight = compat->IsEnchantmentFull(false);
+	_apply.BeginFrame(frame);
 
 	for (auto& [name, entry] : ui->menuMap) {
 		if (!entry.menu || !entry.menu->uiMovie) {
 			continue;
 		}
-		std::string menuNameStr(name.c_str());
-		if (menuNameStr == "HUD Menu") {
-			ApplyHUDMenuSpecifics(entry.menu->uiMovie, a_alpha);
-			continue;
-		}
-
-		if (menuNameStr == "Fader Menu" || Utils::IsSystemMenu(menuNameStr) || Utils::IsInteractiveMenu(entry.menu.get())) {
-			continue;
-		}
-
-		if (Utils::IsInteractiveMenu(entry.menu.get())) {
+		const std::string_view menuName(name.c_str());
+		if (menuName == "HUD Menu") {
+			ApplyHUDMenuSpecifics(entry.menu->uiMovie, a_alpha, frame.menuOpen, frame.consoleOpen);
 			continue;
 		}
 
-		int mode = settings->GetWidgetMode(menuNameStr);
-
-		// Menus active: relinquish control of external menus.
-		// Important for mod-added system menus, and widgets open during vanilla menus.
-		if (menuOpen && mode != Settings::kHidden && !isConsoleOpen) {
+		if (menuName == "Fader Menu" || Utils::IsSystemMenu(menuName) || Utils::IsInteractiveMenu(entry.menu.get())) {
 			continue;
 		}
 
-		RE::GFxValue root;
-		if (!entry.menu->uiMovie->GetVariable(&root, "_root")) {
-			continue;
+		if (!_apiMenus.empty()) {
+			if (const auto api = _apiMenus.find(menuName); api != _apiMenus.end()) {
+				PushApiWidget(_apiWidgets[api->second], entry.menu->uiMovie, a_alpha, frame.menuOpen, frame.consoleOpen);
+				continue;
+			}
 		}
 
-		// Handle passive ignore for external menus.
-		if (mode == Settings::kIgnored) {
-			EnforceIgnoredVisibility(root);
+		// Claimed by another HUD controller through the plugin API
+		if (!_claimedPaths.empty() && _claimedPaths.contains(menuName)) {
 			continue;
 		}
 
-		// For other modes, we set the target alpha blindly
-		RE::GFxValue::DisplayInfo dInfo;
-		root.GetDisplayInfo(&dInfo);
-
-		double targetAlpha = a_alpha;
-
-		if (mode == Settings::kVisible) {
-			targetAlpha = hudMax;
-		} else if (mode == Settings::kHidden) {
-			targetAlpha = 0.0;
-		} else if (mode == Settings::kInterior) {
-			targetAlpha = interiorAlpha;
-		} else if (mode == Settings::kExterior) {
-			targetAlpha = exteriorAlpha;
-		} else if (mode == Settings::kInCombat) {
-			targetAlpha = combatAlpha;
-		} else if (mode == Settings::kNotInCombat) {
-			targetAlpha = notInCombatAlpha;
-		} else if (mode == Settings::kWeaponDrawn) {
-			targetAlpha = weaponAlpha;
-		} else if (mode == Settings::kLockedOn) {
-			targetAlpha = lockedOnAlpha;
-		}
-
-		if (std::abs(dInfo.GetAlpha() - targetAlpha) > 0.01) {
-			dInfo.SetAlpha(targetAlpha);
-			root.SetDisplayInfo(dInfo);
-		}
+		_apply.ApplyMenu(entry.menu->uiMovie.get(), menuName, ResolveMode(menuName));
 	}
+
+	PublishChannels(a_alpha, frame.menuOpen);
 }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "FadeEngine.h"
+#include "HUDApply.h"
+#include "HUDElements.h"
+#include "PluginAPI.h"
+#include "Utils.h"
+
 class HUDManager : public ISingleton<HUDManager>
 {
 public:
 	// Initialization and Hooks
 	void InstallHooks();
-	void Reset(bool a_refreshUserPreference = false);
+	void Reset(bool a_refreshUserPreference = false, bool a_reloadSettings = true);
 	void StartRuntime();
 
 	// Widget Scanning and Discovery
@@ -31,26 +37,29 @@ public:
 private:
 	// Alpha Application Logic
 	void ApplyAlphaToHUD(float a_globalAlpha);
-	void ApplyHUDMenuSpecifics(RE::GPtr<RE::GFxMovieView> a_movie, float a_globalAlpha);
-
-	// Enchantment Bar Helper Functions
-	bool IsEnchantmentElement(const char* a_elementId, bool& a_isLeft, bool& a_isRight, bool& a_isSkyHUD) const;
-	float CalculateEnchantmentIgnoredAlpha(bool a_isEnchantLeft,
-		bool a_isEnchantSkyHUD, bool a_menuOpen, float a_alphaL, float a_alphaR) const;
-	void ApplySkyHUDSubMeter(RE::GFxValue& a_parent, const char* a_memberName,
-		bool a_shouldBeVisible, bool a_callHammer);
-	void ApplySkyHUDEnchantment(RE::GFxValue& a_elem, float a_alphaL, float a_alphaR,
-		float a_managedAlpha, int a_mode, bool a_isIgnoredMode);
-	double CalculateEnchantmentTargetAlpha(bool a_isEnchantLeft,
-		bool a_isEnchantSkyHUD, int a_mode, float a_alphaL, float a_alphaR, double a_managedAlpha) const;
-
-	// Child Visibility Enforcement
-	void EnforceHMSMeterVisible(RE::GFxValue& a_parent, bool a_forcePermanent = false);
-	void EnforceEnchantMeterVisible(RE::GFxValue& a_parent);
-	void EnforceIgnoredVisibility(RE::GFxValue& a_target);
+	void ApplyHUDMenuSpecifics(RE::GPtr<RE::GFxMovieView> a_movie, float a_globalAlpha, bool a_menuOpen, bool a_isConsoleOpen);
+
+	// Fading
+	std::optional<FadeEngine::Channel> GetFadeChannel(int a_mode, bool a_isCrosshair = false) const;
+	double QuantizeAlpha(double a_alpha, const std::optional<FadeEngine::Channel>& a_channel) const;
+
+	// Plugin API
+	struct ApiWidget;
+	void SyncPluginAPI();
+	void HandOverElement(const HUDElements::Def& a_def);
+	void HandOverPath(std::string_view a_path);
+	double GetModeAlpha(int a_mode, float a_globalAlpha, bool a_menuOpen) const;
+	void PushApiWidget(ApiWidget& a_widget, const RE::GPtr<RE::GFxMovieView>& a_movie, float a_globalAlpha,
+		bool a_menuOpen, bool a_isConsoleOpen);
+	void PublishChannels(float a_globalAlpha, bool a_menuOpen);
+
+	// Script Overrides
+	void SyncScriptOverrides();
+	int ResolveMode(std::string_view a_path) const;
+	int GetElementOverride(std::size_t a_index) const { return a_index < _elementOverrides.size() ? _elementOverrides[a_index] : -1; }
 
 	// Internal Scanning Logic
-	void ScanForContainers(RE::GFxMovieView* a_movie, int& a_foundCount, bool& a_changes);
+	struct DiscoverySink;
 
 	// Debugging
 	void DumpHUDStructure();
@@ -59,36 +68,82 @@ private:
 	bool _userWantsVisible = false;
 	bool _installed = false;
 	bool _hasScanned = false;
-	bool _wasHidden = false;
 	std::atomic_bool _isScanPending = false;
 	bool _isSkyHUDActive = false;
 	bool _widgetsPopulated = false;
 	bool _isRuntime = false;
 	bool _hasInitializedConfig = false;
+	// Interactive menus that already forced one config check for pruning (kept for the process lifetime)
+	std::unordered_set<std::string, Utils::TransparentStringHash, std::equal_to<>> _prunedInteractiveMenus;
+
+	// Movie the element caches were built against. Held so cached handles never outlive it.
+	RE::GPtr<RE::GFxMovieView> _elementCacheMovie;
 
-	// Runtime Verification
-	std::unordered_set<std::string> _verifiedPaths;
+	// Per-frame alpha application (HUDApply), fed by ApplyAlphaToHUD. Declared after the movie it caches handles of.
+	struct ApplyHost;
+	HUDApply::Applier<RE::GFxMovieView, RE::GFxValue> _apply;
 
 	// Alpha Transition Values
-	float _currentAlpha = 0.0f;
-	float _targetAlpha = 0.0f;
-	float _ctxAlpha = 0.0f;
-	float _ctxSneakAlpha = 0.0f;
-	float _enchantAlphaL = 0.0f;
-	float _enchantAlphaR = 0.0f;
-	float _interiorAlpha = 0.0f;
-	float _exteriorAlpha = 0.0f;
-	float _combatAlpha = 0.0f;
-	float _notInCombatAlpha = 0.0f;
-	float _weaponAlpha = 0.0f;
-	float _lockedOnAlpha = 0.0f;
+	FadeEngine::State _fade;
+	FadeEngine::Config _fadeConfig;
+	FadeEngine::Targets _fadeTargets;
+
+	// Plugin API Widgets
+	// Copied from PluginAPI when its generation changes. Registered widgets are never read back: the
+	// last pushed values are kept here and a write only goes out when the target differs from them.
+	struct ApiWidget
+	{
+		static constexpr float kRetryInterval = 1.0f;
+
+		PluginAPI::Widget registration;
+		RE::GFxValue target;                // Menu _root or HUD clip
+		RE::GPtr<RE::GFxMovieView> movie;  // Movie the target was resolved in
+		double pushedAlpha = -1.0;          // -1: nothing pushed yet
+		std::int8_t pushedVisible = -1;
+		float retryAt = 0.0f;  // _timer value of the next lookup after the target failed to resolve
+	};
+	std::vector<ApiWidget> _apiWidgets;
+	std::unordered_map<std::string, std::size_t, Utils::TransparentStringHash, std::equal_to<>> _apiMenus;  // Menu name -> _apiWidgets index
+	std::unordered_set<std::string, Utils::TransparentStringHash, std::equal_to<>> _apiClips;
+	PluginAPI::Subscribers _apiSubscribers;
+	std::array<float, PluginAPI::kChannelCount> _apiPublished{};
+	std::uint32_t _apiGeneration = 0;
+
+	// Element Ownership
+	// Elements claimed by other HUD controllers through the plugin API. Claimed elements are skipped
+	// before any lookup; the detection pseudo element replaces the Detection Meter DLL check.
+	std::vector<bool> _claimedElements;  // Indexed like HUDElements::Get()
+	std::unordered_set<std::string, Utils::TransparentStringHash, std::equal_to<>> _claimedPaths;  // Widget paths and menu names
+	bool _detectionClaimed = false;
+
+	// Script Overrides
+	// Winning ScriptOverrides modes, copied when their generation changes. The globals from ImmersiveHUD.esp
+	// are still honored as a fallback, read once per frame by Compat.
+	// UI thread (ApplyAlphaToHUD):
+	std::vector<int> _elementOverrides;  // Indexed like HUDElements::Get(), -1 without override
+	std::unordered_map<std::string, int, Utils::TransparentStringHash, std::equal_to<>> _pathOverrides;  // Widget paths and menu names
+	std::uint32_t _overrideGeneration = 0;
+	// Update:
+	int _hudOverride = -1;
+	int _stealthOverride = -1;
+	std::uint32_t _updateOverrideGeneration = 0;
+	float _pushedVisibleTimer = 0.0f;  // PushVisibility countdown
+	bool _hudDisabled = false;         // g_DisableiHUD or a winning hidden "HUD" override
+
+	// Alpha writes per managed fade (bDumpPerfStats)
+	struct FadeWriteStats
+	{
+		std::uint32_t writes = 0;
+		std::uint32_t frames = 0;
+		bool active = false;
+	};
+	FadeWriteStats _fadeWrites;
 
 	// Delta and Timer Tracking
 	float _prevDelta = 0.0f;
 	float _timer = 0.0f;
 	float _scanTimer = 0.0f;
 	float _displayTimer = 0.0f;
-	float _lastShoutMeterFixTime = 0.0f;
 
 	// Stealth State Tracker
 	float _lastDetectionLevel = 0.0f;
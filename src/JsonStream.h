@@ -0,0 +1,115 @@
+#pragma once
+
+// Emits JSON text directly, matching the byte layout of json::dump(2)
+// (2-space indent, objects in key order, no trailing newline).
+// Used by MCMGen to stream generated pages without building them as json values first.
+class JsonStream
+{
+public:
+	explicit JsonStream(std::string& a_out) :
+		_out(a_out)
+	{}
+
+	void Open(char a_bracket)
+	{
+		_out += a_bracket;
+		_indent += 2;
+		_first = true;
+	}
+
+	void Close(char a_bracket)
+	{
+		_indent -= 2;
+		// Empty containers stay on one line ("[]", "{}")
+		if (!_first) {
+			NewLine();
+		}
+		_out += a_bracket;
+		_first = false;
+	}
+
+	void Key(std::string_view a_key)
+	{
+		Separator();
+		String(a_key);
+		_out += ": ";
+	}
+
+	void Element() { Separator(); }
+
+	void String(std::string_view a_value)
+	{
+		_out += '"';
+		for (char c : a_value) {
+			switch (c) {
+			case '"':
+				_out += "\\\"";
+				break;
+			case '\\':
+				_out += "\\\\";
+				break;
+			case '\b':
+				_out += "\\b";
+				break;
+			case '\f':
+				_out += "\\f";
+				break;
+			case '\n':
+				_out += "\\n";
+				break;
+			case '\r':
+				_out += "\\r";
+				break;
+			case '\t':
+				_out += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					// Remaining control characters as lowercase \u00xx, like nlohmann
+					constexpr std::string_view kHex = "0123456789abcdef";
+					_out += "\\u00";
+					_out += kHex[static_cast<unsigned char>(c) >> 4];
+					_out += kHex[static_cast<unsigned char>(c) & 0xF];
+				} else {
+					_out += c;
+				}
+				break;
+			}
+		}
+		_out += '"';
+	}
+
+	void Raw(std::string_view a_value) { _out += a_value; }
+
+	// Hand-authored content is serialized by nlohmann and re-indented to the current depth.
+	void Value(const json& a_value)
+	{
+		const std::string text = a_value.dump(2);
+		for (char c : text) {
+			_out += c;
+			if (c == '\n') {
+				_out.append(_indent, ' ');
+			}
+		}
+	}
+
+private:
+	void Separator()
+	{
+		if (!_first) {
+			_out += ',';
+		}
+		NewLine();
+		_first = false;
+	}
+
+	void NewLine()
+	{
+		_out += '\n';
+		_out.append(_indent, ' ');
+	}
+
+	std::string& _out;
+	int _indent = 0;
+	bool _first = true;
+};
@@ -0,0 +1,171 @@
+#include "MCMConfig.h"
+#include "JsonStream.h"
+#include "StringKernels.h"
+
+namespace MCMConfig
+{
+	namespace
+	{
+		// Construct in alphabetical order to match MCM Helper output structure
+		void WriteEnum(JsonStream& a_json, const Entry& a_entry, std::span<const std::string_view> a_options)
+		{
+			a_json.Element();
+			a_json.Open('{');
+			a_json.Key("help");
+			a_json.String(a_entry.help);
+			a_json.Key("id");
+			a_json.String(a_entry.id);
+			a_json.Key("text");
+			a_json.String(a_entry.text);
+			a_json.Key("type");
+			a_json.String("enum");
+			a_json.Key("valueOptions");
+			a_json.Open('{');
+			a_json.Key("defaultValue");
+			a_json.Raw("1");
+			a_json.Key("options");
+			a_json.Open('[');
+			for (const auto& option : a_options) {
+				a_json.Element();
+				a_json.String(option);
+			}
+			a_json.Close(']');
+			a_json.Key("sourceType");
+			a_json.String("ModSettingInt");
+			a_json.Close('}');
+			a_json.Close('}');
+		}
+
+		// Extract "meter" from "Interface/skyui/meter.swf".
+		std::string ExtractFilename(std::string_view a_path)
+		{
+			if (a_path.empty()) {
+				return "";
+			}
+
+			// Work with view first to identify bounds
+			std::string_view p = a_path;
+
+			// 1. Handle directory separators
+			// find_last_of handles both / and \ so manual replacement is not needed
+			size_t lastSlash = p.find_last_of("/\\");
+			if (lastSlash != std::string_view::npos) {
+				p = p.substr(lastSlash + 1);
+			}
+
+			// 2. Handle extensions
+			size_t lastDot = p.rfind('.');
+			if (lastDot != std::string_view::npos) {
+				p = p.substr(0, lastDot);
+			}
+
+			if (p.empty()) {
+				return "";
+			}
+
+			// 3. Construct result and fix case
+			std::string result(p);
+
+			// Only fix purely lowercase strings.
+			bool hasUpper = std::any_of(result.begin(), result.end(), [](unsigned char c) {
+				return std::isupper(c);
+			});
+
+			if (!hasUpper) {
+				result[0] = static_cast<char>(toupper(static_cast<unsigned char>(result[0])));
+			}
+
+			return result;
+		}
+
+		void WriteGeneratedContent(JsonStream& a_json, std::string_view a_statusId, std::string_view a_status,
+			const auto& a_entries, std::span<const std::string_view> a_options)
+		{
+			a_json.Open('[');
+
+			a_json.Element();
+			a_json.Open('{');
+			a_json.Key("id");
+			a_json.String(a_statusId);
+			a_json.Key("text");
+			a_json.String(a_status);
+			a_json.Key("type");
+			a_json.String("text");
+			a_json.Close('}');
+
+			a_json.Element();
+			a_json.Open('{');
+			a_json.Key("type");
+			a_json.String("header");
+			a_json.Close('}');
+
+			for (const auto& entry : a_entries) {
+				WriteEnum(a_json, entry, a_options);
+			}
+
+			a_json.Close(']');
+		}
+	}
+
+	std::string GetWidgetDisplayName(std::string_view a_source)
+	{
+		// Extract the clean name from the Source URL (e.g., "meter.swf" -> "Meter").
+		// We rely on the fact that WidgetDiscovery and GetMenuURL ensure a_source is never empty.
+		std::string name = ExtractFilename(a_source);
+		return name;
+	}
+
+	std::string SanitizeName(std::string_view a_name)
+	{
+		std::string clean(a_name);
+		StringKernels::SanitizeAlnum(clean.data(), clean.size());
+		return clean;
+	}
+
+	std::string Serialize(const json& a_document, const GeneratedPages& a_pages, std::size_t a_sizeHint)
+	{
+		static const std::map<std::string, Entry> kNoWidgets;
+		const auto& widgets = a_pages.widgets ? *a_pages.widgets : kNoWidgets;
+
+		std::string out;
+		out.reserve(a_sizeHint + 1024);
+
+		JsonStream js(out);
+		js.Open('{');
+		for (const auto& [key, value] : a_document.items()) {
+			js.Key(key);
+			if (key != "pages" || !value.is_array()) {
+				js.Value(value);
+				continue;
+			}
+
+			js.Open('[');
+			for (const auto& page : value) {
+				js.Element();
+				if (!page.is_object()) {
+					js.Value(page);
+					continue;
+				}
+
+				std::string pName = page.value("pageDisplayName", "");
+
+				js.Open('{');
+				for (const auto& [pKey, pValue] : page.items()) {
+					js.Key(pKey);
+					if (pKey == "content" && pName == "$fzIH_PageElements") {
+						WriteGeneratedContent(js, "ElemStatus", a_pages.elementStatus, a_pages.elements, a_pages.options);
+					} else if (pKey == "content" && pName == "$fzIH_PageWidgets") {
+						WriteGeneratedContent(js, "WidStatus", a_pages.widgetStatus, widgets | std::views::values, a_pages.options);
+					} else {
+						js.Value(pValue);
+					}
+				}
+				js.Close('}');
+			}
+			js.Close(']');
+		}
+		js.Close('}');
+
+		return out;
+	}
+}
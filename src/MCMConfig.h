@@ -0,0 +1,40 @@
+#pragma once
+
+// config.json layout shared by MCMGen: the generated enum entries, their names and the streamed serializer.
+// Free of game headers so the output can be checked against json::dump(2) on the host.
+namespace MCMConfig
+{
+	// A generated MCM enum entry. Metadata is kept as fields so that
+	// rescans never have to recover it from the help text.
+	struct Entry
+	{
+		std::string id;       // MCM ID (e.g. "iMode_Meter:Widgets")
+		std::string iniKey;   // INI key (e.g. "iMode_Meter")
+		std::string text;     // Display name or localization key
+		std::string help;     // Rendered help text
+		std::string source;   // Decoded source URL ("Internal/Vanilla" for HUD elements)
+		std::string rawPath;  // Flash path or menu name of the first instance
+
+		bool operator==(const Entry&) const = default;
+	};
+
+	// Content of the two generated pages. Everything else in the document is written as authored.
+	struct GeneratedPages
+	{
+		std::string_view elementStatus;
+		std::span<const Entry> elements;  // Sorted by label
+		std::string_view widgetStatus;
+		const std::map<std::string, Entry>* widgets = nullptr;
+		std::span<const std::string_view> options;  // Mode option list of every enum
+	};
+
+	// Central logic to determine the human-readable name for the MCM: "Interface/skyui/meter.swf" -> "Meter".
+	std::string GetWidgetDisplayName(std::string_view a_source);
+
+	// Converts "_root.WidgetContainer.10" -> "_root_WidgetContainer_10" for MCM IDs and INI keys.
+	std::string SanitizeName(std::string_view a_name);
+
+	// Serializes a_document byte-for-byte like json::dump(2) would after the generated pages were
+	// rebuilt inside it, streaming their content instead. a_sizeHint pre-sizes the output.
+	std::string Serialize(const json& a_document, const GeneratedPages& a_pages, std::size_t a_sizeHint = 0);
+}
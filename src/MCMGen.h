@@ -9,4 +9,7 @@ namespace MCMGen
 
 	// Resets the session modification flag (called when transitioning to runtime)
 	void ResetSessionFlag();
+
+	// Clears cached source-file existence results (called when a new session starts)
+	void InvalidateSourceCache();
 }
@@ -0,0 +1,639 @@
+#pragma once
+
+#include "HUDElements.h"
+#include "MCMConfig.h"
+
+// The MCM generation behind MCMGen::Update: hydrates config.json and settings.ini, prunes and merges
+// discovered widgets, and writes both files back when something changed. Written against a Host and an
+// INI type like HUDApply, so the host tests run the same code over seeded temp directories
+// (tests/MCMScene.h). The game host wraps Settings, Compat, the UI and BSResource; the game INI is CSimpleIniA.
+namespace MCMUpdate
+{
+	using MCMConfig::Entry;
+
+	// The CSimpleIniA calls the update makes.
+	template <class I>
+	concept IniFile = requires(I& a_ini, const char* a_text, long a_value) {
+		a_ini.SetUnicode();
+		{ a_ini.LoadFile(a_text) } -> std::convertible_to<int>;  // Negative on failure
+		{ a_ini.GetValue(a_text, a_text, a_text) } -> std::convertible_to<const char*>;
+		{ a_ini.GetLongValue(a_text, a_text, a_value) } -> std::convertible_to<long>;
+		a_ini.SetLongValue(a_text, a_text, a_value, a_text);
+		a_ini.SaveFile(a_text);
+	};
+
+	template <class H>
+	concept Host = requires(H& a_host, std::string_view a_text, const std::string& a_string, const std::vector<std::string>& a_sources) {
+		{ a_host.GetActivePaths() } -> std::same_as<const std::set<std::string, std::less<>>&>;  // Discovered and cached paths
+		{ a_host.GetWidgetSource(a_text) } -> std::convertible_to<const std::string&>;
+		{ a_host.IsSkyUIWidgetSource(a_text) } -> std::convertible_to<bool>;
+		{ a_host.IsSystemMenu(a_text) } -> std::convertible_to<bool>;
+		{ a_host.IsInteractive(a_string, a_string) } -> std::convertible_to<bool>;  // Open interactive menu or known interactive source
+		a_host.ProbeSources(a_sources);                                              // Resolves SourceExists for the batch
+		{ a_host.SourceExists(a_string) } -> std::convertible_to<bool>;
+		{ a_host.UsesTDM() } -> std::convertible_to<bool>;
+		{ a_host.IsAltChargeEnabled() } -> std::convertible_to<bool>;
+		a_host.SaveCache();
+	};
+
+	// Mirrors the generated parts of config.json and settings.ini for the whole session.
+	// Hydrated from disk on the first Update, afterwards changes are applied as diffs.
+	template <IniFile I>
+	struct Model
+	{
+		fs::path configPath;
+		fs::path iniPath;
+
+		bool hydrated = false;
+		bool syncedWithDisk = false;  // False until the first generated output was compared to the file
+		bool needsCreation = false;   // config.json is missing or unreadable
+		bool iniLoaded = false;
+		bool iniModifiedThisSession = false;
+
+		json document;         // Full config; generated page content is streamed from the entries below
+		std::string diskText;  // Raw config.json as hydrated, released after the first comparison
+		std::size_t lastOutputSize = 0;
+		I ini;
+
+		std::vector<Entry> elements;           // Sorted by label
+		std::map<std::string, Entry> widgets;  // Keyed by MCM ID
+		std::string elementStatus;
+		std::string widgetStatus;
+	};
+
+	// What one Update wrote to config.json.
+	struct Result
+	{
+		std::size_t configBytes = 0;  // Serialized size, 0 if the config was not serialized
+		bool configWritten = false;
+	};
+
+	// Shared option lists for every generated enum.
+	// LockedOn MUST be the last item to preserve index safety for previous items.
+	// Note to self: Further options get added here, after TDM, so we maintain positioning.
+	inline constexpr std::array<std::string_view, 10> kModeOptionsTDM = {
+		"$fzIH_ModeVisible", "$fzIH_ModeImmersive", "$fzIH_ModeHidden", "$fzIH_ModeIgnored",
+		"$fzIH_ModeInterior", "$fzIH_ModeExterior", "$fzIH_ModeInCombat", "$fzIH_ModeNotInCombat",
+		"$fzIH_ModeWeaponDrawn", "$fzIH_ModeLockedOn"
+	};
+
+	// Safely add Locked On placeholder if TDM is not installed.
+	inline constexpr std::array<std::string_view, 10> kModeOptionsNoTDM = {
+		"$fzIH_ModeVisible", "$fzIH_ModeImmersive", "$fzIH_ModeHidden", "$fzIH_ModeIgnored",
+		"$fzIH_ModeInterior", "$fzIH_ModeExterior", "$fzIH_ModeInCombat", "$fzIH_ModeNotInCombat",
+		"$fzIH_ModeWeaponDrawn", "$fzIH_ModeTDMDisabled"
+	};
+
+	template <IniFile I>
+	void SmartAppendIni(Model<I>& a_model, const std::vector<std::string>& a_newKeys, const char* a_section)
+	{
+		if (a_newKeys.empty()) {
+			return;
+		}
+
+		bool changed = false;
+
+		for (const auto& key : a_newKeys) {
+			if (a_model.ini.GetValue(a_section, key.c_str(), nullptr) == nullptr) {
+				a_model.ini.SetLongValue(a_section, key.c_str(), 1, nullptr);
+				changed = true;
+			}
+		}
+
+		if (changed) {
+			a_model.ini.SaveFile(a_model.iniPath.string().c_str());
+			a_model.iniModifiedThisSession = true;
+		}
+	}
+
+	// Legacy recovery: configs written before the model existed only carry
+	// their metadata inside the help text ("Source: [URL]\nID: [PATH]").
+	inline void ParseHelpMetadata(const std::string& a_help, std::string& a_source, std::string& a_rawPath)
+	{
+		a_source = "Unknown";
+		a_rawPath.clear();
+
+		// Parse "Source: [URL]"
+		size_t srcPos = a_help.find("Source: ");
+		if (srcPos != std::string::npos) {
+			size_t endSrc = a_help.find('\n', srcPos);
+			if (endSrc != std::string::npos) {
+				a_source = a_help.substr(srcPos + 8, endSrc - (srcPos + 8));
+			} else {
+				a_source = a_help.substr(srcPos + 8);
+			}
+		}
+
+		// Parse "ID: [PATH]"
+		size_t idPos = a_help.find("ID: ");
+		if (idPos != std::string::npos) {
+			a_rawPath = a_help.substr(idPos + 4);
+			if (a_rawPath.find('\n') != std::string::npos) {
+				a_rawPath = a_rawPath.substr(0, a_rawPath.find('\n'));
+			}
+		}
+	}
+
+	inline std::string GetStatusText(const json& a_content)
+	{
+		if (!a_content.empty() && a_content[0].contains("text")) {
+			return a_content[0]["text"].get<std::string>();
+		}
+		return "";
+	}
+
+	// Loads config.json and settings.ini once per session.
+	template <IniFile I>
+	void HydrateModel(Model<I>& a_model)
+	{
+		if (a_model.hydrated) {
+			return;
+		}
+		a_model.hydrated = true;
+
+		a_model.ini.SetUnicode();
+		a_model.iniLoaded = (a_model.ini.LoadFile(a_model.iniPath.string().c_str()) >= 0);
+
+		if (fs::exists(a_model.configPath)) {
+			try {
+				std::ifstream inFile(a_model.configPath, std::ios::binary);
+				a_model.diskText.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+				a_model.document = json::parse(a_model.diskText);
+			} catch (...) {
+				a_model.document = json();
+			}
+		}
+
+		if (!a_model.document.is_object() || !a_model.document.contains("pages")) {
+			a_model.document = json::object();
+			a_model.needsCreation = true;
+		}
+
+		if (!a_model.document["pages"].is_array()) {
+			a_model.document["pages"] = json::array();
+		}
+
+		for (json& page : a_model.document["pages"]) {
+			if (!page.is_object()) {
+				continue;
+			}
+
+			std::string pName = page.value("pageDisplayName", "");
+			if (pName != "$fzIH_PageElements" && pName != "$fzIH_PageWidgets") {
+				continue;
+			}
+
+			// Generated pages always carry content, even if the file lost it.
+			if (!page.contains("content") || !page["content"].is_array()) {
+				page["content"] = json::array();
+			}
+
+			const bool isElements = (pName == "$fzIH_PageElements");
+			if (isElements) {
+				a_model.elementStatus = GetStatusText(page["content"]);
+			} else {
+				a_model.widgetStatus = GetStatusText(page["content"]);
+			}
+
+			for (const json& item : page["content"]) {
+				if (!item.contains("help") || !item.contains("id")) {
+					continue;
+				}
+
+				Entry entry;
+				entry.id = item["id"].get<std::string>();  // e.g. "iMode_Foo:Widgets"
+				entry.iniKey = entry.id.substr(0, entry.id.find(':'));
+				entry.text = item.value("text", "");
+				entry.help = item["help"].get<std::string>();
+				ParseHelpMetadata(entry.help, entry.source, entry.rawPath);
+
+				// Elements keep the file order (sorted by label) so an unchanged page compares equal
+				if (isElements) {
+					a_model.elements.push_back(std::move(entry));
+				} else if (!entry.rawPath.empty()) {
+					a_model.widgets[entry.id] = std::move(entry);
+				}
+			}
+		}
+
+		logger::info("MCM model hydrated: {} element entries, {} widget entries.", a_model.elements.size(), a_model.widgets.size());
+	}
+
+	// Serializes the stored document, streaming the generated pages straight from the model.
+	template <IniFile I>
+	std::string SerializeConfig(Model<I>& a_model, bool a_usesTDM)
+	{
+		MCMConfig::GeneratedPages pages;
+		pages.elementStatus = a_model.elementStatus;
+		pages.elements = a_model.elements;
+		pages.widgetStatus = a_model.widgetStatus;
+		pages.widgets = &a_model.widgets;
+		pages.options = a_usesTDM ? std::span<const std::string_view>(kModeOptionsTDM) :
+		                            std::span<const std::string_view>(kModeOptionsNoTDM);
+
+		std::string out = MCMConfig::Serialize(a_model.document, pages, a_model.lastOutputSize);
+		a_model.lastOutputSize = out.size();
+		return out;
+	}
+
+	struct WidgetInfo
+	{
+		std::string rawPath;
+		std::string source;
+		std::string prettyName;
+	};
+
+	// Helper to track settings that might be lost due to ID changes
+	struct OrphanSetting
+	{
+		std::string id;
+		std::string source;
+		long value;
+	};
+
+	// ==========================================
+	// Main Update Loop
+	// ==========================================
+
+	// a_isRuntime: Controls status text (New Found vs Registered) to prevent stale messages.
+	// a_widgetsPopulated: If false, skips pruning of widget-container elements.
+	template <IniFile I, Host H>
+	Result Update(Model<I>& a_model, H& a_host, bool a_isRuntime, bool a_widgetsPopulated)
+	{
+		Result result;
+
+		try {
+			// 1. Load Model (disk access happens only once per session)
+			HydrateModel(a_model);
+
+			auto& ini = a_model.ini;
+			const bool iniLoaded = a_model.iniLoaded;
+			bool iniDirty = false;
+			std::vector<std::string> newIniKeysWidgets;
+			std::vector<std::string> newIniKeysElements;
+
+			// 2. Prepare Data Sets
+			std::map<std::string, std::string> allPaths;
+
+			// Track IDs present in the previous session's JSON
+			std::unordered_set<std::string> previousJsonIDs;
+			// Track Sources present in the previous session's JSON (to detect index shifts)
+			std::unordered_set<std::string> previousJsonSources;
+			// Track Source -> IDs relationship from JSON to suppress "Index Shift" spam for multi-instance widgets
+			std::map<std::string, std::vector<std::string>> previousJsonSourceToIDs;
+
+			// Harvest potential orphans (current settings in the JSON)
+			// We map Source -> List of Orphans
+			std::map<std::string, std::vector<OrphanSetting>> potentialOrphans;
+
+			// Lookup set for Hardcoded/Vanilla paths to prevent flagging them as "New"
+			std::unordered_set<std::string> hardcodedVanillaPaths;
+			for (const auto& def : HUDElements::Get()) {
+				for (const auto& p : def.paths) {
+					hardcodedVanillaPaths.insert(p);
+				}
+			}
+
+			// Grab currently active paths from memory
+			const auto& activePaths = a_host.GetActivePaths();
+
+			// Source Collision Prep:
+			// Build a set of all Source Files currently loaded in memory.
+			std::unordered_set<std::string> activeSources;
+			for (const auto& path : activePaths) {
+				activeSources.insert(a_host.GetWidgetSource(path));
+			}
+
+			// Entries whose source is not loaded at all; resolved in one batch after the loop.
+			std::vector<std::pair<std::string, std::string>> pendingProbes;
+
+			// 3. Recover & Prune Existing Entries
+			for (const auto& [idStr, entry] : a_model.widgets) {
+				const std::string& rawID = entry.rawPath;
+				const std::string& sourceStr = entry.source;
+
+				previousJsonIDs.insert(rawID);
+				// Register the source so we know this mod was already installed
+				previousJsonSources.insert(sourceStr);
+				// Map Source to ID for anchor detection
+				previousJsonSourceToIDs[sourceStr].push_back(rawID);
+
+				// Harvest Orphan Candidate
+				long val = ini.GetLongValue("Widgets", entry.iniKey.c_str(), -1);
+
+				// Only store if it's a valid, non-default setting (1=Immersive is default)
+				if (val != -1 && val != 1) {
+					potentialOrphans[sourceStr].push_back({ rawID, sourceStr, val });
+				}
+
+				// Heuristic: Is this a SkyUI widget? 💁🦋
+				bool isWidget = a_host.IsSkyUIWidgetSource(sourceStr);
+
+				// Pruning Guard: SkyUI widgets are late-loading.
+				// During Initial Scans (before the HUD Menu loads), the WidgetContainer is empty.
+				// We must skip pruning these specific IDs until we are in Runtime and know the container is populated.
+				// Otherwise, installed widgets would be wrongly flagged as uninstalled and removed from the config.
+				if (isWidget && !a_widgetsPopulated) {
+					allPaths[rawID] = sourceStr;
+					continue;
+				}
+
+				// Check Validity:
+				bool isVanilla = hardcodedVanillaPaths.contains(rawID);
+				bool existsInMemory = activePaths.contains(rawID);
+
+				// Identify if this is a System Menu that should be pruned (e.g. Fader Menu)
+				// Fader Menu is explicitly checked because Utils::IsSystemMenu excludes it for logic reasons elsewhere.
+				bool isSystemMenu = (rawID == "Fader Menu" || a_host.IsSystemMenu(rawID));
+
+				// Source Collision Logic:
+				// If the source file is currently loaded in memory (activeSources),
+				// BUT this specific ID (rawID) is NOT in memory, it implies this ID is stale.
+				// This catches:
+				// 1. SkyUI Widget Position Jostling (WidgetContainer.5 moved to WidgetContainer.3)
+				// 2. Versioned IDs (Menu_v1 replaced by Menu_v2)
+				bool isStaleID = !existsInMemory && activeSources.contains(sourceStr);
+
+				bool isInteractivePrune = !existsInMemory && a_host.IsInteractive(rawID, sourceStr);
+
+				bool shouldKeep = false;
+
+				if (existsInMemory || isVanilla) {
+					shouldKeep = true;
+				} else if (isSystemMenu) {
+					shouldKeep = false;
+					logger::info("Pruning system menu from config: {}", rawID);
+				} else if (isInteractivePrune) {
+					shouldKeep = false;
+					logger::info("Pruning interactive menu from config: {}", rawID);
+				} else if (isStaleID) {
+					// It's definitely dead. The file is loaded elsewhere, so this specific ID is invalid.
+					shouldKeep = false;
+				} else {
+					// The source isn't loaded at all (Menu is closed).
+					// Fall back to physical file check via BSResources, batched below.
+					pendingProbes.emplace_back(rawID, sourceStr);
+					continue;
+				}
+
+				if (shouldKeep) {
+					allPaths[rawID] = sourceStr;
+				} else {
+					logger::info("Pruning uninstalled widget: {} [Source: {}]", rawID, sourceStr);
+				}
+			}
+
+			if (!pendingProbes.empty()) {
+				std::vector<std::string> probeSources;
+				probeSources.reserve(pendingProbes.size());
+				for (const auto& [rawID, sourceStr] : pendingProbes) {
+					probeSources.push_back(sourceStr);
+				}
+				a_host.ProbeSources(probeSources);
+
+				for (const auto& [rawID, sourceStr] : pendingProbes) {
+					if (a_host.SourceExists(sourceStr)) {
+						allPaths[rawID] = sourceStr;
+					} else {
+						logger::info("Pruning uninstalled widget: {} [Source: {}]", rawID, sourceStr);
+					}
+				}
+			}
+
+			// 4. Merge New Discoveries
+			bool foundNewWidgetInJson = false;
+
+			for (const auto& path : activePaths) {
+				std::string src = a_host.GetWidgetSource(path);
+
+				// If we are at the Main Menu (!a_widgetsPopulated), SkyUI widgets cannot physically exist.
+				// Any entries appearing in memPaths are leftovers from the INI cache.
+				// We must ignore them to prevent false "New Found" flags due to index shifting.
+				bool isSkyUIWidget = (path.find("_root.WidgetContainer.") != std::string::npos);
+				if (isSkyUIWidget && !a_widgetsPopulated) {
+					continue;
+				}
+
+				allPaths[path] = src;
+
+				// Detection Logic: Was this widget missing from the previous config?
+				if (!previousJsonIDs.contains(path)) {
+					if (hardcodedVanillaPaths.contains(path)) {
+						continue;
+					}
+
+					// Check if the Source was already present (Index Shift vs New Mod).
+					if (previousJsonSources.contains(src)) {
+						// Index Shift or Additional Instance Logic:
+						// If the Source file is known, we check if at least one ID from the JSON for this source
+						// is currently active in memory. If an anchor exists, this is just a multi-instance widget.
+						bool hasAnchor = false;
+						if (auto it = previousJsonSourceToIDs.find(src); it != previousJsonSourceToIDs.end()) {
+							for (const auto& oldID : it->second) {
+								if (activePaths.contains(oldID)) {
+									// Double check source match to prevent collisions with generic names
+									if (a_host.GetWidgetSource(oldID) == src) {
+										hasAnchor = true;
+										break;
+									}
+								}
+							}
+						}
+
+						if (hasAnchor) {
+							// Mod is already known and grouped; this is just another instance (e.g. Clock instance #2).
+							// We silence this to prevent log spam.
+						} else {
+							// All previous IDs for this source are gone, but the source is now at a new ID.
+							// This is a legitimate shift (e.g. version update or SkyUI re-ordering).
+							logger::info("Widget index shift detected: {} [Source: {}]. Updating config without status change.", path, src);
+						}
+					} else {
+						logger::info("New widget detected: {} [Source: {}]", path, src);
+						foundNewWidgetInJson = true;
+					}
+				}
+			}
+
+			// 5. Generate Content for "HUD Elements" Page
+			std::vector<Entry> newElements;
+			std::unordered_set<std::string> processedPaths;
+
+			bool altChargeActive = a_host.IsAltChargeEnabled();
+
+			for (const auto& def : HUDElements::Get()) {
+				std::string iniKey = def.id;
+				std::string help = "Source: Internal/Vanilla\nID: ";
+
+				if (!def.paths.empty()) {
+					help += def.paths[0];
+				}
+
+				// Conditional: show combined only if alt charge active, otherwise left/right
+				if (altChargeActive) {
+					if (iniKey == "iMode_EnchantLeft" || iniKey == "iMode_EnchantRight") {
+						continue;
+					}
+				} else {
+					if (iniKey == "iMode_EnchantCombined") {
+						continue;
+					}
+				}
+
+				if (iniLoaded) {
+					if (ini.GetValue("HUDElements", iniKey.c_str(), nullptr) == nullptr) {
+						newIniKeysElements.push_back(iniKey);
+					}
+				} else {
+					newIniKeysElements.push_back(iniKey);
+				}
+
+				newElements.push_back({ iniKey + ":HUDElements", iniKey, def.label, help,
+					"Internal/Vanilla", def.paths.empty() ? "" : def.paths[0] });
+
+				for (const auto& p : def.paths) {
+					processedPaths.insert(p);
+				}
+			}
+
+			std::sort(newElements.begin(), newElements.end(), [](const Entry& a, const Entry& b) {
+				return a.text < b.text;
+			});
+
+			// 6. Generate Content for "Widgets" Page (Dynamic)
+			std::map<std::string, std::vector<WidgetInfo>> groupedWidgets;
+			for (const auto& [path, source] : allPaths) {
+				if (processedPaths.contains(path)) {
+					continue;
+				}
+				std::string pretty = MCMConfig::GetWidgetDisplayName(source);
+				groupedWidgets[pretty].push_back({ path, source, pretty });
+			}
+
+			std::map<std::string, Entry> newWidgets;
+			for (auto& [prettyBase, widgets] : groupedWidgets) {
+				// We only take the first instance for the MCM setting to avoid clutter
+				const auto& w = widgets[0];
+				std::string displayName = prettyBase;
+				std::string safeID = MCMConfig::SanitizeName(displayName);
+				std::string finalID = "iMode_" + safeID + ":Widgets";
+				std::string iniKey = "iMode_" + safeID;
+
+				std::string help = "Source: " + w.source + "\nID: " + w.rawPath;
+				if (widgets.size() > 1) {
+					help += "\n(+ " + std::to_string(widgets.size() - 1) + " other instances)";
+				}
+
+				bool existsInIni = iniLoaded && (ini.GetValue("Widgets", iniKey.c_str(), nullptr) != nullptr);
+
+				if (!existsInIni) {
+					// SETTING MIGRATION:
+					// If this is a new key, check if we have a valid orphan for this source.
+					// Since we are grouping instances now, we take the first available orphan value.
+					auto& orphans = potentialOrphans[w.source];
+					long migratedValue = -1;
+					if (!orphans.empty()) {
+						migratedValue = orphans[0].value;
+						orphans.clear();  // Clear orphans for this source to prevent reuse
+					}
+					if (migratedValue != -1) {
+						ini.SetLongValue("Widgets", iniKey.c_str(), migratedValue, nullptr);
+						logger::info("Migrated setting for {}: {} -> {}", displayName, w.source, migratedValue);
+						existsInIni = true;
+						iniDirty = true;
+					}
+				}
+				if (!existsInIni) {
+					newIniKeysWidgets.push_back(iniKey);
+				}
+
+				newWidgets[finalID] = { finalID, iniKey, displayName, help, w.source, w.rawPath };
+			}
+
+			// 7. Calculate Status Flags
+			// If new content is discovered during Initial/Mid Scans (!Runtime),
+			// we flag the session to display the "Restart Required" warning.
+			// Once Runtime is set (post-Mid Scan), we stop triggering this flag
+			// as the MCM page cannot visually update, which would lead to stale messages.
+			if (!a_isRuntime) {
+				if (!newIniKeysElements.empty() || !newIniKeysWidgets.empty() || foundNewWidgetInJson) {
+					a_model.iniModifiedThisSession = true;
+				}
+			}
+
+			// Show restart warning ONLY during non-runtime scans where new content was found
+			// Runtime scans always show "registered" count since MCM can't update anyway
+			bool showRestartWarning = !a_isRuntime && a_model.iniModifiedThisSession;
+
+			// For Elements, we always show the count. The list is static/hardcoded.
+			std::string newElementStatus = "<font color='#00FF00'>Status: " +
+			                               std::to_string(newElements.size()) + " HUD Elements registered.</font>";
+
+			std::string newWidgetStatus;
+			if (showRestartWarning) {
+				newWidgetStatus = "$fzIH_WidgetNewFound";
+			} else {
+				newWidgetStatus = "<font color='#00FF00'>Status: " +
+				                  std::to_string(newWidgets.size()) + " widgets registered.</font>";
+			}
+
+			// 8. Diff Against Model
+			bool statusChanged = (newElementStatus != a_model.elementStatus) || (newWidgetStatus != a_model.widgetStatus);
+			bool entriesChanged = (newElements != a_model.elements) || (newWidgets != a_model.widgets);
+
+			a_model.elements = std::move(newElements);
+			a_model.widgets = std::move(newWidgets);
+			a_model.elementStatus = std::move(newElementStatus);
+			a_model.widgetStatus = std::move(newWidgetStatus);
+
+			// 9. Write to Disk
+			// Only write if the model changed OR if we have meaningful changes OR status changed.
+			// The first pass of a session also compares against the file, which may predate this build.
+			bool contentChanged = !newIniKeysElements.empty() || !newIniKeysWidgets.empty() || foundNewWidgetInJson;
+			bool shouldWrite = entriesChanged || contentChanged || statusChanged || a_model.needsCreation;
+
+			std::string output;
+			if (!a_model.syncedWithDisk) {
+				output = SerializeConfig(a_model, a_host.UsesTDM());
+				shouldWrite = shouldWrite || (output != a_model.diskText);
+				a_model.diskText.clear();
+				a_model.diskText.shrink_to_fit();
+				a_model.syncedWithDisk = true;
+			} else if (shouldWrite) {
+				output = SerializeConfig(a_model, a_host.UsesTDM());
+			}
+			result.configBytes = output.size();
+
+			if (shouldWrite) {
+				std::ofstream outFile(a_model.configPath, std::ios::binary | std::ios::trunc);
+				if (outFile.is_open()) {
+					outFile.write(output.data(), static_cast<std::streamsize>(output.size()));
+					outFile.close();
+					a_model.needsCreation = false;
+					result.configWritten = true;
+				}
+			}
+
+			if (iniLoaded || !fs::exists(a_model.iniPath)) {
+				SmartAppendIni(a_model, newIniKeysWidgets, "Widgets");
+				SmartAppendIni(a_model, newIniKeysElements, "HUDElements");
+
+				if (iniDirty || !iniLoaded) {
+					ini.SaveFile(a_model.iniPath.string().c_str());
+				}
+
+				// The in-memory INI now mirrors the file on disk.
+				a_model.iniLoaded = true;
+			}
+
+			// 10. Update Cache (Anti-Flicker)
+			// Persist the discovered paths to the INI so next session
+			// we can target them immediately on load.
+			a_host.SaveCache();
+
+		} catch (...) {
+			logger::error("Failed to update MCM JSON");
+		}
+		return result;
+	}
+}
@@ -0,0 +1,53 @@
+#include "Papyrus.h"
+#include "PluginAPI.h"
+#include "ScriptOverrides.h"
+
+namespace Papyrus
+{
+	namespace
+	{
+		constexpr auto kScriptName = "ImmersiveHUD"sv;
+
+		std::int32_t SetElementOverride(RE::StaticFunctionTag*, RE::BSFixedString a_elementId, std::int32_t a_mode, std::int32_t a_priority)
+		{
+			const auto handle = ScriptOverrides::GetSingleton()->Push(a_elementId.c_str(), a_mode, a_priority);
+			if (handle == 0) {
+				logger::warn("Papyrus: Rejected override of '{}' with mode {}", a_elementId.c_str(), a_mode);
+			}
+			return handle;
+		}
+
+		bool ClearElementOverride(RE::StaticFunctionTag*, std::int32_t a_handle)
+		{
+			return ScriptOverrides::GetSingleton()->Pop(a_handle);
+		}
+
+		void PushVisibility(RE::StaticFunctionTag*, std::int32_t a_milliseconds)
+		{
+			ScriptOverrides::GetSingleton()->PushVisibility(a_milliseconds);
+		}
+
+		float GetAlpha(RE::StaticFunctionTag*, std::int32_t a_channel)
+		{
+			if (a_channel < 0 || static_cast<std::size_t>(a_channel) >= PluginAPI::kChannelCount) {
+				return 0.0f;
+			}
+			return PluginAPI::GetSingleton()->GetChannelAlpha(static_cast<PluginAPI::Channel>(a_channel));
+		}
+	}
+
+	bool Register(RE::BSScript::IVirtualMachine* a_vm)
+	{
+		if (!a_vm) {
+			return false;
+		}
+
+		a_vm->RegisterFunction("SetElementOverride"sv, kScriptName, SetElementOverride);
+		a_vm->RegisterFunction("ClearElementOverride"sv, kScriptName, ClearElementOverride);
+		a_vm->RegisterFunction("PushVisibility"sv, kScriptName, PushVisibility);
+		a_vm->RegisterFunction("GetAlpha"sv, kScriptName, GetAlpha, true);
+
+		logger::info("Registered Papyrus natives for {}", kScriptName);
+		return true;
+	}
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Native functions of the ImmersiveHUD Papyrus script (Data/Source/Scripts/ImmersiveHUD.psc).
+namespace Papyrus
+{
+	bool Register(RE::BSScript::IVirtualMachine* a_vm);
+}
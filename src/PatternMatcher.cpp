@@ -0,0 +1,118 @@
+#include "PatternMatcher.h"
+
+namespace
+{
+	constexpr unsigned char FoldCase(unsigned char a_c)
+	{
+		return (a_c >= 'A' && a_c <= 'Z') ? static_cast<unsigned char>(a_c | 0x20) : a_c;
+	}
+}
+
+bool PatternMatcher::Add(std::string_view a_pattern, std::uint32_t a_category, Anchor a_anchor)
+{
+	if (a_pattern.empty() || a_category == 0) {
+		return false;
+	}
+
+	std::int32_t state = 0;
+	for (char c : a_pattern) {
+		const auto uc = _ignoreCase ? FoldCase(static_cast<unsigned char>(c)) : static_cast<unsigned char>(c);
+		if (uc < 0x20 || uc > 0x7E) {
+			return false;
+		}
+
+		if (_nodes[state].next[uc] < 0) {
+			_nodes[state].next[uc] = static_cast<std::int32_t>(_nodes.size());
+			Node child;
+			child.depth = _nodes[state].depth + 1;
+			_nodes.push_back(child);
+		}
+		state = _nodes[state].next[uc];
+	}
+
+	switch (a_anchor) {
+	case Anchor::kAnywhere:
+		_nodes[state].anywhere |= a_category;
+		break;
+	case Anchor::kPrefix:
+		_nodes[state].prefix |= a_category;
+		break;
+	case Anchor::kExact:
+		_nodes[state].exact |= a_category;
+		break;
+	}
+
+	_patternCount++;
+	_built = false;
+	return true;
+}
+
+void PatternMatcher::Build()
+{
+	// Breadth-first: resolve suffix links and fill missing transitions so Match never backtracks.
+	std::vector<std::int32_t> link(_nodes.size(), 0);
+	std::vector<std::int32_t> queue;
+	queue.reserve(_nodes.size());
+
+	for (std::size_t c = 0; c < kAlphabet; c++) {
+		auto& target = _nodes[0].next[c];
+		if (target < 0) {
+			target = 0;
+		} else {
+			link[target] = 0;
+			queue.push_back(target);
+		}
+	}
+
+	for (std::size_t head = 0; head < queue.size(); head++) {
+		const auto state = queue[head];
+		_nodes[state].anywhere |= _nodes[link[state]].anywhere;
+
+		for (std::size_t c = 0; c < kAlphabet; c++) {
+			const auto fallback = _nodes[link[state]].next[c];
+			auto& target = _nodes[state].next[c];
+			if (target < 0) {
+				target = fallback;
+			} else {
+				link[target] = fallback;
+				queue.push_back(target);
+			}
+		}
+	}
+
+	_built = true;
+}
+
+std::uint32_t PatternMatcher::Match(std::string_view a_text) const
+{
+	if (!_built) {
+		return 0;
+	}
+
+	std::uint32_t result = 0;
+	std::size_t state = 0;
+	std::uint32_t consumed = 0;
+
+	for (char c : a_text) {
+		const auto uc = _ignoreCase ? FoldCase(static_cast<unsigned char>(c)) : static_cast<unsigned char>(c);
+		consumed++;
+
+		// Non-ASCII bytes never appear in patterns: restart from the root
+		state = uc < kAlphabet ? static_cast<std::size_t>(_nodes[state].next[uc]) : 0;
+
+		const auto& node = _nodes[state];
+		result |= node.anywhere;
+
+		// The state spells the whole input so far only while no mismatch has occurred
+		if (node.depth == consumed) {
+			result |= node.prefix;
+		}
+	}
+
+	const auto& last = _nodes[state];
+	if (last.depth == consumed) {
+		result |= last.exact;
+	}
+
+	return result;
+}
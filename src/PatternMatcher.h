@@ -0,0 +1,48 @@
+#pragma once
+
+// Multi-pattern matcher (Aho-Corasick compiled to a DFA over ASCII), case-insensitive by default.
+// Every pattern carries a category bit. Match() evaluates all patterns in one pass over
+// the input, without copying it, and returns the categories that matched.
+class PatternMatcher
+{
+public:
+	enum class Anchor : std::uint8_t
+	{
+		kAnywhere,  // Substring
+		kPrefix,    // Input starts with the pattern
+		kExact      // Input equals the pattern
+	};
+
+	explicit PatternMatcher(bool a_ignoreCase = true) :
+		_ignoreCase(a_ignoreCase)
+	{}
+
+	// Patterns must be printable ASCII. Returns false if the pattern was rejected.
+	bool Add(std::string_view a_pattern, std::uint32_t a_category, Anchor a_anchor = Anchor::kAnywhere);
+
+	// Compiles the added patterns. Must be called before Match.
+	void Build();
+
+	[[nodiscard]] std::uint32_t Match(std::string_view a_text) const;
+
+	[[nodiscard]] std::size_t GetPatternCount() const { return _patternCount; }
+
+private:
+	static constexpr std::size_t kAlphabet = 128;
+
+	struct Node
+	{
+		std::array<std::int32_t, kAlphabet> next;
+		std::uint32_t depth = 0;
+		std::uint32_t anywhere = 0;  // Substring categories ending here, merged along suffix links
+		std::uint32_t prefix = 0;    // Prefix categories of the pattern spelled by this node
+		std::uint32_t exact = 0;     // Exact categories of the pattern spelled by this node
+
+		Node() { next.fill(-1); }
+	};
+
+	std::vector<Node> _nodes = std::vector<Node>(1);  // Root
+	std::size_t _patternCount = 0;
+	bool _ignoreCase = true;
+	bool _built = false;
+};
@@ -0,0 +1,310 @@
+#include "PluginAPI.h"
+#include "Settings.h"
+#include "StringKernels.h"
+
+static_assert(static_cast<int>(ImmersiveHUDAPI::Channel::Ignored) == Settings::kIgnored);
+static_assert(static_cast<int>(ImmersiveHUDAPI::Channel::LockedOn) == Settings::kLockedOn);
+static_assert(ImmersiveHUDAPI::ChannelCount == Settings::kLockedOn + 1);
+
+void PluginAPI::HandleMessage(SKSE::MessagingInterface::Message* a_msg)
+{
+	using namespace ImmersiveHUDAPI;
+
+	// SKSE's own notifications arrive here too: only well-formed commands are answered
+	if (!a_msg || a_msg->type != 0 || a_msg->dataLen != sizeof(PluginCommand) || !a_msg->data) {
+		return;
+	}
+
+	const auto cmd = static_cast<const PluginCommand*>(a_msg->data);
+	if (cmd->header != PluginCommand{}.header || cmd->type != PluginCommand::Type::RequestInterface || !cmd->commandStructure) {
+		return;
+	}
+
+	const auto request = static_cast<const InterfaceRequest*>(cmd->commandStructure);
+	const char* sender = a_msg->sender ? a_msg->sender : "unknown";
+
+	InterfaceContainer container;
+	PluginResponse response;
+	if (request->interfaceVersion == InterfaceVersion::V1 || request->interfaceVersion == InterfaceVersion::V2) {
+		if (request->interfaceVersion == InterfaceVersion::V1) {
+			container.interfaceInstance = static_cast<IVImmersiveHUD1*>(GetSingleton());
+		} else {
+			container.interfaceInstance = static_cast<IVImmersiveHUD2*>(GetSingleton());
+		}
+		container.interfaceVersion = request->interfaceVersion;
+		response.type = PluginResponse::Type::InterfaceProvider;
+		response.responseData = &container;
+		logger::info("Plugin API: Provided interface V{} to {}", static_cast<int>(request->interfaceVersion) + 1, sender);
+	} else {
+		response.type = PluginResponse::Type::Error;
+		logger::warn("Plugin API: {} requested unknown interface version {}", sender, static_cast<int>(request->interfaceVersion));
+	}
+
+	SKSE::GetMessagingInterface()->Dispatch(0, &response, sizeof(PluginResponse), a_msg->sender);
+}
+
+bool PluginAPI::IsValidName(const char* a_name)
+{
+	return a_name && *a_name && StringKernels::IsPrintableAscii(a_name);
+}
+
+PluginAPI::Widget* PluginAPI::FindWidget(std::string_view a_id)
+{
+	const auto it = std::ranges::find(_widgets, a_id, &Widget::id);
+	return it != _widgets.end() ? &*it : nullptr;
+}
+
+PluginAPI::APIResult PluginAPI::RegisterWidget(const char* a_id, TargetType a_type, const char* a_target, Channel a_channel) noexcept
+{
+	if (!IsValidName(a_id) || !IsValidName(a_target) || static_cast<std::size_t>(a_channel) >= kChannelCount) {
+		return APIResult::InvalidArgument;
+	}
+	if (a_type == TargetType::Clip && !std::string_view(a_target).starts_with("_root.")) {
+		return APIResult::InvalidArgument;
+	}
+
+	std::scoped_lock guard(_lock);
+	if (FindWidget(a_id)) {
+		return APIResult::AlreadyRegistered;
+	}
+
+	Widget widget{ a_id, a_type, a_target, static_cast<int>(a_channel), {} };
+	if (a_type == TargetType::Movie) {
+		StringKernels::ToLowerAscii(widget.target.data(), widget.target.size());
+	}
+	_widgets.push_back(std::move(widget));
+	_generation.fetch_add(1, std::memory_order_release);
+
+	logger::info("Plugin API: Registered widget '{}' -> {} (channel {})", a_id, a_target, static_cast<int>(a_channel));
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::UnregisterWidget(const char* a_id) noexcept
+{
+	if (!a_id) {
+		return APIResult::NotRegistered;
+	}
+
+	std::scoped_lock guard(_lock);
+	if (std::erase_if(_widgets, [&](const Widget& a_widget) { return a_widget.id == a_id; }) == 0) {
+		return APIResult::NotRegistered;
+	}
+	_generation.fetch_add(1, std::memory_order_release);
+
+	logger::info("Plugin API: Unregistered widget '{}'", a_id);
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::SetWidgetChannel(const char* a_id, Channel a_channel) noexcept
+{
+	if (static_cast<std::size_t>(a_channel) >= kChannelCount) {
+		return APIResult::InvalidArgument;
+	}
+	if (!a_id) {
+		return APIResult::NotRegistered;
+	}
+
+	std::scoped_lock guard(_lock);
+	auto widget = FindWidget(a_id);
+	if (!widget) {
+		return APIResult::NotRegistered;
+	}
+	if (widget->mode != static_cast<int>(a_channel)) {
+		widget->mode = static_cast<int>(a_channel);
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::SubscribeChannel(Channel a_channel, ImmersiveHUDAPI::AlphaCallback a_callback, void* a_userData) noexcept
+{
+	const auto index = static_cast<std::size_t>(a_channel);
+	if (!a_callback || index >= kChannelCount || a_channel == Channel::Ignored) {
+		return APIResult::InvalidArgument;
+	}
+
+	std::scoped_lock guard(_lock);
+	auto& subscribers = _subscribers[index];
+	if (std::ranges::any_of(subscribers, [&](const Subscriber& s) { return s.callback == a_callback && s.userData == a_userData; })) {
+		return APIResult::AlreadyRegistered;
+	}
+	subscribers.push_back({ a_callback, a_userData });
+	_generation.fetch_add(1, std::memory_order_release);
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::UnsubscribeChannel(Channel a_channel, ImmersiveHUDAPI::AlphaCallback a_callback, void* a_userData) noexcept
+{
+	const auto index = static_cast<std::size_t>(a_channel);
+	if (index >= kChannelCount) {
+		return APIResult::NotRegistered;
+	}
+
+	std::scoped_lock guard(_lock);
+	if (std::erase_if(_subscribers[index], [&](const Subscriber& s) { return s.callback == a_callback && s.userData == a_userData; }) == 0) {
+		return APIResult::NotRegistered;
+	}
+	_generation.fetch_add(1, std::memory_order_release);
+	return APIResult::OK;
+}
+
+float PluginAPI::GetChannelAlpha(Channel a_channel) const noexcept
+{
+	const auto index = static_cast<std::size_t>(a_channel);
+	return index < kChannelCount ? _channelAlphas[index].load(std::memory_order_relaxed) : 0.0f;
+}
+
+bool PluginAPI::IsHUDShown() const noexcept
+{
+	return _shown.load(std::memory_order_relaxed);
+}
+
+bool PluginAPI::IsToggledOn() const noexcept
+{
+	return _toggledOn.load(std::memory_order_relaxed);
+}
+
+PluginAPI::APIResult PluginAPI::ClaimElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept
+{
+	if (!IsValidName(a_elementId) || a_myPluginHandle == ImmersiveHUDAPI::NoOwner) {
+		return APIResult::InvalidArgument;
+	}
+
+	{
+		std::scoped_lock guard(_lock);
+		const auto it = std::ranges::find(_claims, std::string_view(a_elementId), &Claim::elementId);
+		if (it != _claims.end()) {
+			return it->owner == a_myPluginHandle ? APIResult::AlreadyGiven : APIResult::AlreadyTaken;
+		}
+		_claims.push_back({ a_elementId, a_myPluginHandle });
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	logger::info("Plugin API: Element '{}' claimed by plugin {}", a_elementId, a_myPluginHandle);
+	NotifyOwnership(a_elementId, a_myPluginHandle);
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::ReleaseElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept
+{
+	if (!a_elementId) {
+		return APIResult::NotOwner;
+	}
+
+	{
+		std::scoped_lock guard(_lock);
+		const auto it = std::ranges::find(_claims, std::string_view(a_elementId), &Claim::elementId);
+		if (it == _claims.end() || it->owner != a_myPluginHandle) {
+			return APIResult::NotOwner;
+		}
+		_claims.erase(it);
+		_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	logger::info("Plugin API: Element '{}' released by plugin {}", a_elementId, a_myPluginHandle);
+	NotifyOwnership(a_elementId, ImmersiveHUDAPI::NoOwner);
+	return APIResult::OK;
+}
+
+SKSE::PluginHandle PluginAPI::GetElementOwner(const char* a_elementId) const noexcept
+{
+	if (!a_elementId) {
+		return ImmersiveHUDAPI::NoOwner;
+	}
+
+	std::scoped_lock guard(_lock);
+	const auto it = std::ranges::find(_claims, std::string_view(a_elementId), &Claim::elementId);
+	return it != _claims.end() ? it->owner : ImmersiveHUDAPI::NoOwner;
+}
+
+PluginAPI::APIResult PluginAPI::RegisterOwnershipCallback(ImmersiveHUDAPI::OwnershipCallback a_callback, void* a_userData) noexcept
+{
+	if (!a_callback) {
+		return APIResult::InvalidArgument;
+	}
+
+	std::scoped_lock guard(_lock);
+	if (std::ranges::any_of(_ownershipListeners, [&](const OwnershipListener& l) { return l.callback == a_callback && l.userData == a_userData; })) {
+		return APIResult::AlreadyRegistered;
+	}
+	_ownershipListeners.push_back({ a_callback, a_userData });
+	return APIResult::OK;
+}
+
+PluginAPI::APIResult PluginAPI::UnregisterOwnershipCallback(ImmersiveHUDAPI::OwnershipCallback a_callback, void* a_userData) noexcept
+{
+	std::scoped_lock guard(_lock);
+	if (std::erase_if(_ownershipListeners, [&](const OwnershipListener& l) { return l.callback == a_callback && l.userData == a_userData; }) == 0) {
+		return APIResult::NotRegistered;
+	}
+	return APIResult::OK;
+}
+
+// Runs outside the lock so callbacks may call back into the API.
+void PluginAPI::NotifyOwnership(const char* a_elementId, SKSE::PluginHandle a_owner) const
+{
+	std::vector<OwnershipListener> listeners;
+	{
+		std::scoped_lock guard(_lock);
+		listeners = _ownershipListeners;
+	}
+	for (const auto& listener : listeners) {
+		listener.callback(a_elementId, a_owner, listener.userData);
+	}
+}
+
+void PluginAPI::Snapshot(std::vector<Widget>& a_widgets, Subscribers& a_subscribers, std::vector<Claim>& a_claims) const
+{
+	std::scoped_lock guard(_lock);
+	a_widgets = _widgets;
+	a_subscribers = _subscribers;
+	a_claims = _claims;
+}
+
+bool PluginAPI::IsRegisteredMenu(std::string_view a_menuName) const
+{
+	std::scoped_lock guard(_lock);
+	return std::ranges::any_of(_widgets, [&](const Widget& a_widget) {
+		return (a_widget.type == TargetType::Menu && a_widget.target == a_menuName) ||
+		       (a_widget.type == TargetType::Movie && a_widget.boundMenu == a_menuName);
+	});
+}
+
+bool PluginAPI::IsRegisteredClip(std::string_view a_path) const
+{
+	std::scoped_lock guard(_lock);
+	return std::ranges::any_of(_widgets, [&](const Widget& a_widget) {
+		return a_widget.type == TargetType::Clip && a_widget.target == a_path;
+	});
+}
+
+bool PluginAPI::BindMovie(std::string_view a_menuName, std::string_view a_url)
+{
+	std::scoped_lock guard(_lock);
+
+	bool bound = false;
+	for (auto& widget : _widgets) {
+		if (widget.type != TargetType::Movie || a_url.size() < widget.target.size()) {
+			continue;
+		}
+		if (StringKernels::FindNoCase(a_url.substr(a_url.size() - widget.target.size()), widget.target) != 0) {
+			continue;
+		}
+		if (widget.boundMenu != a_menuName) {
+			widget.boundMenu = a_menuName;
+			_generation.fetch_add(1, std::memory_order_release);
+			logger::info("Plugin API: Widget '{}' bound to menu {}", widget.id, a_menuName);
+		}
+		bound = true;
+	}
+	return bound;
+}
+
+void PluginAPI::Publish(const std::array<float, kChannelCount>& a_alphas, bool a_shown, bool a_toggledOn)
+{
+	for (std::size_t i = 0; i < kChannelCount; i++) {
+		_channelAlphas[i].store(a_alphas[i], std::memory_order_relaxed);
+	}
+	_shown.store(a_shown, std::memory_order_relaxed);
+	_toggledOn.store(a_toggledOn, std::memory_order_relaxed);
+}
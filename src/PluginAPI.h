@@ -0,0 +1,96 @@
+#pragma once
+
+#include "API/ImmersiveHUDAPI.h"
+
+// Provider side of API/ImmersiveHUDAPI.h.
+// Other plugins may call in from any thread; HUDManager copies the registrations on the UI thread
+// whenever the generation changes, and publishes channel alphas back after every apply.
+class PluginAPI :
+	public ImmersiveHUDAPI::IVImmersiveHUD2,
+	public ISingleton<PluginAPI>
+{
+public:
+	using APIResult = ImmersiveHUDAPI::APIResult;
+	using Channel = ImmersiveHUDAPI::Channel;
+	using TargetType = ImmersiveHUDAPI::TargetType;
+
+	static constexpr std::size_t kChannelCount = ImmersiveHUDAPI::ChannelCount;
+
+	struct Widget
+	{
+		std::string id;
+		TargetType type;
+		std::string target;     // Menu name, lowercase SWF file or clip path
+		int mode;               // Settings::WidgetMode
+		std::string boundMenu;  // Movie targets: menu currently showing the SWF, or empty
+	};
+
+	struct Subscriber
+	{
+		ImmersiveHUDAPI::AlphaCallback callback;
+		void* userData;
+	};
+	using Subscribers = std::array<std::vector<Subscriber>, kChannelCount>;
+
+	struct Claim
+	{
+		std::string elementId;
+		SKSE::PluginHandle owner;
+	};
+
+	// SKSE listener answering interface requests from other plugins
+	static void HandleMessage(SKSE::MessagingInterface::Message* a_msg);
+
+	// IVImmersiveHUD1
+	APIResult RegisterWidget(const char* a_id, TargetType a_type, const char* a_target, Channel a_channel) noexcept override;
+	APIResult UnregisterWidget(const char* a_id) noexcept override;
+	APIResult SetWidgetChannel(const char* a_id, Channel a_channel) noexcept override;
+	APIResult SubscribeChannel(Channel a_channel, ImmersiveHUDAPI::AlphaCallback a_callback, void* a_userData) noexcept override;
+	APIResult UnsubscribeChannel(Channel a_channel, ImmersiveHUDAPI::AlphaCallback a_callback, void* a_userData) noexcept override;
+	[[nodiscard]] float GetChannelAlpha(Channel a_channel) const noexcept override;
+	[[nodiscard]] bool IsHUDShown() const noexcept override;
+	[[nodiscard]] bool IsToggledOn() const noexcept override;
+
+	// IVImmersiveHUD2
+	APIResult ClaimElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept override;
+	APIResult ReleaseElement(SKSE::PluginHandle a_myPluginHandle, const char* a_elementId) noexcept override;
+	[[nodiscard]] SKSE::PluginHandle GetElementOwner(const char* a_elementId) const noexcept override;
+	APIResult RegisterOwnershipCallback(ImmersiveHUDAPI::OwnershipCallback a_callback, void* a_userData) noexcept override;
+	APIResult UnregisterOwnershipCallback(ImmersiveHUDAPI::OwnershipCallback a_callback, void* a_userData) noexcept override;
+
+	// Bumped on every registration, subscription or ownership change
+	[[nodiscard]] std::uint32_t GetGeneration() const { return _generation.load(std::memory_order_acquire); }
+	void Snapshot(std::vector<Widget>& a_widgets, Subscribers& a_subscribers, std::vector<Claim>& a_claims) const;
+
+	// Discovery skips registered targets.
+	[[nodiscard]] bool IsRegisteredMenu(std::string_view a_menuName) const;
+	[[nodiscard]] bool IsRegisteredClip(std::string_view a_path) const;
+
+	// Binds Movie registrations whose SWF matches a_url to the menu. Returns true if the menu is registered.
+	bool BindMovie(std::string_view a_menuName, std::string_view a_url);
+
+	void Publish(const std::array<float, kChannelCount>& a_alphas, bool a_shown, bool a_toggledOn);
+
+private:
+	[[nodiscard]] static bool IsValidName(const char* a_name);
+
+	Widget* FindWidget(std::string_view a_id);
+	void NotifyOwnership(const char* a_elementId, SKSE::PluginHandle a_owner) const;
+
+	struct OwnershipListener
+	{
+		ImmersiveHUDAPI::OwnershipCallback callback;
+		void* userData;
+	};
+
+	mutable std::mutex _lock;
+	std::vector<Widget> _widgets;
+	Subscribers _subscribers;
+	std::vector<Claim> _claims;
+	std::vector<OwnershipListener> _ownershipListeners;
+	std::atomic<std::uint32_t> _generation{ 1 };
+
+	std::array<std::atomic<float>, kChannelCount> _channelAlphas{};
+	std::atomic_bool _shown{ false };
+	std::atomic_bool _toggledOn{ false };
+};
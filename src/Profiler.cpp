@@ -0,0 +1,151 @@
+#include "Profiler.h"
+
+namespace Profiler
+{
+	static constexpr std::size_t kCapacity = 4096;  // Power of two, ~30s of frames at 144 Hz
+
+	static constexpr std::array<std::string_view, static_cast<std::size_t>(Stage::kTotal)> kStageNames = {
+		"AdvanceMovie",
+		"Update",
+		"ShouldHideHUD",
+		"ApplyAlphaToHUD",
+		"HUDMenu (Vanilla)",
+		"HUDMenu (Dynamic)",
+		"VisibilityHammer",
+		"StealthMeterHook",
+		"WidgetScan",
+		"MCMUpdate"
+	};
+
+	static constexpr std::array<std::string_view, static_cast<std::size_t>(Call::kTotal)> kCallNames = {
+		"GetVariable",
+		"GetMember",
+		"VisitMembers",
+		"GetDisplayInfo",
+		"SetAlphaVisible",
+		"SetMember",
+		"Invoke"
+	};
+
+	static constexpr std::array<std::string_view, static_cast<std::size_t>(Counter::kTotal)> kCounterNames = {
+		"FailedLookups",
+		"HammerChildrenWalked",
+		"NativeTweenHandoffs",
+		"CulledMenus",
+		"AlphaWrites"
+	};
+
+	struct RingBuffer
+	{
+		std::atomic_uint64_t head{ 0 };
+		std::array<std::atomic_int64_t, kCapacity> samples{};
+
+		void Push(std::int64_t a_value)
+		{
+			const auto index = head.fetch_add(1, std::memory_order_relaxed);
+			samples[index & (kCapacity - 1)].store(a_value, std::memory_order_relaxed);
+		}
+	};
+
+	static std::array<RingBuffer, static_cast<std::size_t>(Stage::kTotal)> g_buffers;
+	static std::array<RingBuffer, static_cast<std::size_t>(Call::kTotal)> g_callBuffers;
+	static std::array<RingBuffer, static_cast<std::size_t>(Counter::kTotal)> g_counterBuffers;
+
+	// Logs the distribution of one buffer. a_scale converts raw samples to the logged unit.
+	static void LogSeries(std::string_view a_name, const RingBuffer& a_buffer, double a_scale, std::vector<std::int64_t>& a_snapshot)
+	{
+		const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(a_buffer.head.load(std::memory_order_relaxed), kCapacity));
+
+		if (count == 0) {
+			logger::info("[Perf] {:<18} no samples", a_name);
+			return;
+		}
+
+		a_snapshot.clear();
+		for (std::size_t s = 0; s < count; s++) {
+			a_snapshot.push_back(a_buffer.samples[s].load(std::memory_order_relaxed));
+		}
+		std::sort(a_snapshot.begin(), a_snapshot.end());
+
+		auto percentile = [&](double a_p) {
+			auto idx = static_cast<std::size_t>(a_p * static_cast<double>(count - 1));
+			return static_cast<double>(a_snapshot[idx]) * a_scale;
+		};
+
+		double mean = static_cast<double>(std::accumulate(a_snapshot.begin(), a_snapshot.end(), std::int64_t{ 0 })) /
+		              static_cast<double>(count) * a_scale;
+
+		logger::info("[Perf] {:<18} n={:<5} mean={:8.2f} p50={:8.2f} p95={:8.2f} p99={:8.2f} max={:8.2f}",
+			a_name, count, mean, percentile(0.50), percentile(0.95), percentile(0.99),
+			static_cast<double>(a_snapshot.back()) * a_scale);
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		if (g_enabled.exchange(a_enabled) != a_enabled) {
+			Reset();
+			logger::info("Performance sampling {}.", a_enabled ? "enabled" : "disabled");
+		}
+	}
+
+	void Record(Stage a_stage, std::int64_t a_nanoseconds)
+	{
+		g_buffers[static_cast<std::size_t>(a_stage)].Push(a_nanoseconds);
+	}
+
+	void EndFrame()
+	{
+		if (!g_enabled.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		for (std::size_t i = 0; i < g_frameCalls.size(); i++) {
+			g_callBuffers[i].Push(g_frameCalls[i].exchange(0, std::memory_order_relaxed));
+		}
+		for (std::size_t i = 0; i < g_frameCounters.size(); i++) {
+			g_counterBuffers[i].Push(g_frameCounters[i].exchange(0, std::memory_order_relaxed));
+		}
+	}
+
+	void DumpSummary()
+	{
+		std::vector<std::int64_t> snapshot;
+		snapshot.reserve(kCapacity);
+
+		logger::info("=== PERFORMANCE SUMMARY (microseconds) ===");
+		for (std::size_t i = 0; i < g_buffers.size(); i++) {
+			LogSeries(kStageNames[i], g_buffers[i], 0.001, snapshot);
+		}
+
+		logger::info("=== SCALEFORM CALLS PER FRAME ===");
+		for (std::size_t i = 0; i < g_callBuffers.size(); i++) {
+			LogSeries(kCallNames[i], g_callBuffers[i], 1.0, snapshot);
+		}
+
+		logger::info("=== EVENTS PER FRAME ===");
+		for (std::size_t i = 0; i < g_counterBuffers.size(); i++) {
+			LogSeries(kCounterNames[i], g_counterBuffers[i], 1.0, snapshot);
+		}
+
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (auto& buffer : g_buffers) {
+			buffer.head.store(0, std::memory_order_relaxed);
+		}
+		for (auto& buffer : g_callBuffers) {
+			buffer.head.store(0, std::memory_order_relaxed);
+		}
+		for (auto& buffer : g_counterBuffers) {
+			buffer.head.store(0, std::memory_order_relaxed);
+		}
+		for (auto& calls : g_frameCalls) {
+			calls.store(0, std::memory_order_relaxed);
+		}
+		for (auto& count : g_frameCounters) {
+			count.store(0, std::memory_order_relaxed);
+		}
+	}
+}
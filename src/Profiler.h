@@ -0,0 +1,125 @@
+#pragma once
+
+namespace Profiler
+{
+	// Instrumented stages of the per-frame HUD path.
+	enum class Stage : std::uint32_t
+	{
+		kAdvanceMovie,      // HUDMenuAdvanceMovieHook::thunk (includes the vanilla advance)
+		kUpdate,            // HUDManager::Update
+		kShouldHideHUD,     // HUDManager::ShouldHideHUD
+		kApplyAlpha,        // HUDManager::ApplyAlphaToHUD (all menus)
+		kHUDVanilla,        // HUDApply::Applier::ApplyHUD: HUDElements section
+		kHUDDynamic,        // HUDApply::Applier::ApplyHUD: discovered widget section
+		kVisibilityHammer,  // EnforceHMSMeterVisible / EnforceEnchantMeterVisible
+		kStealthMeterHook,  // StealthMeterHook::thunk
+		kWidgetScan,        // HUDManager::ScanForWidgets (discovery only, excludes MCM generation)
+		kMCMUpdate,         // MCMGen::Update (model diff, serialization and disk writes)
+
+		kTotal
+	};
+
+	// Scaleform operations counted per frame (see GFxOps).
+	enum class Call : std::uint32_t
+	{
+		kGetVariable,
+		kGetMember,
+		kVisitMembers,
+		kGetDisplayInfo,
+		kSetAlphaVisible,  // Narrow DisplayInfo write (iAlphaWritePath = 0)
+		kSetMember,        // _alpha/_visible member write (iAlphaWritePath = 1)
+		kInvoke,
+
+		kTotal
+	};
+
+	// Other per-frame event counts.
+	enum class Counter : std::uint32_t
+	{
+		kFailedLookups,         // Element paths that failed to resolve this frame
+		kHammerChildrenWalked,  // Children re-enumerated by the Visibility Hammer
+		kNativeTweenHandoffs,   // Transitions handed to Scaleform (bNativeTweens)
+		kCulledMenus,           // External menu roots hidden by render culling
+		kAlphaWrites,           // _alpha writes sent to Scaleform
+
+		kTotal
+	};
+
+	// Samples are only taken while enabled (bDumpPerfStats).
+	// Disabled timers cost a single relaxed load and branch.
+	inline std::atomic_bool g_enabled{ false };
+
+	void SetEnabled(bool a_enabled);
+
+	// Stores a sample in the stage's fixed-size lock-free ring buffer.
+	void Record(Stage a_stage, std::int64_t a_nanoseconds);
+
+	// Counts accumulated during the current frame.
+	inline std::array<std::atomic_uint32_t, static_cast<std::size_t>(Call::kTotal)> g_frameCalls{};
+
+	inline void CountCall(Call a_call)
+	{
+		if (g_enabled.load(std::memory_order_relaxed)) {
+			g_frameCalls[static_cast<std::size_t>(a_call)].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	inline std::array<std::atomic_uint32_t, static_cast<std::size_t>(Counter::kTotal)> g_frameCounters{};
+
+	inline void Count(Counter a_counter, std::uint32_t a_amount = 1)
+	{
+		if (g_enabled.load(std::memory_order_relaxed)) {
+			g_frameCounters[static_cast<std::size_t>(a_counter)].fetch_add(a_amount, std::memory_order_relaxed);
+		}
+	}
+
+	inline std::uint32_t GetFrameCount(Call a_call)
+	{
+		return g_frameCalls[static_cast<std::size_t>(a_call)].load(std::memory_order_relaxed);
+	}
+
+	inline std::uint32_t GetFrameCount(Counter a_counter)
+	{
+		return g_frameCounters[static_cast<std::size_t>(a_counter)].load(std::memory_order_relaxed);
+	}
+
+	// Closes the current frame: moves the call and event counts into their per-frame ring buffers.
+	void EndFrame();
+
+	// Logs count/mean/p50/p95/p99/max per stage, calls and counters per frame, then clears all samples.
+	void DumpSummary();
+
+	void Reset();
+
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Stage a_stage) :
+			_stage(a_stage),
+			_active(g_enabled.load(std::memory_order_relaxed))
+		{
+			if (_active) {
+				_start = std::chrono::steady_clock::now();
+			}
+		}
+
+		~ScopedTimer() { Stop(); }
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		// Ends the measurement early (for stages that end before the enclosing scope).
+		void Stop()
+		{
+			if (_active) {
+				_active = false;
+				Record(_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count());
+			}
+		}
+
+	private:
+		Stage _stage;
+		bool _active;
+		std::chrono::steady_clock::time_point _start{};
+	};
+}
@@ -0,0 +1,92 @@
+#include "ScriptOverrides.h"
+#include "Settings.h"
+#include "StringKernels.h"
+
+std::int32_t ScriptOverrides::Push(std::string_view a_elementId, int a_mode, std::int32_t a_priority)
+{
+	if (a_elementId.empty() || !StringKernels::IsPrintableAscii(a_elementId) ||
+		a_mode < Settings::kVisible || a_mode > Settings::kLockedOn) {
+		return 0;
+	}
+
+	std::scoped_lock guard(_lock);
+
+	auto it = _stacks.find(a_elementId);
+	if (it == _stacks.end()) {
+		it = _stacks.emplace(std::string(a_elementId), std::vector<Entry>{}).first;
+	}
+
+	// Insert after every entry of equal or lower priority: among equals the newest wins
+	auto& stack = it->second;
+	const Entry entry{ _nextHandle, a_priority, a_mode };
+	const auto pos = std::ranges::upper_bound(stack, a_priority, {}, &Entry::priority);
+	stack.insert(pos, entry);
+
+	_handles.emplace(entry.handle, it->first);
+	_nextHandle = _nextHandle == std::numeric_limits<std::int32_t>::max() ? 1 : _nextHandle + 1;
+	_generation.fetch_add(1, std::memory_order_release);
+	return entry.handle;
+}
+
+bool ScriptOverrides::Pop(std::int32_t a_handle)
+{
+	std::scoped_lock guard(_lock);
+
+	const auto handle = _handles.find(a_handle);
+	if (handle == _handles.end()) {
+		return false;
+	}
+
+	const auto it = _stacks.find(handle->second);
+	if (it != _stacks.end()) {
+		std::erase_if(it->second, [&](const Entry& a_entry) { return a_entry.handle == a_handle; });
+		if (it->second.empty()) {
+			_stacks.erase(it);
+		}
+	}
+	_handles.erase(handle);
+	_generation.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+void ScriptOverrides::Clear()
+{
+	std::scoped_lock guard(_lock);
+	if (_stacks.empty()) {
+		return;
+	}
+	_stacks.clear();
+	_handles.clear();
+	_generation.fetch_add(1, std::memory_order_release);
+}
+
+void ScriptOverrides::PushVisibility(std::int32_t a_milliseconds)
+{
+	_visibilityPush.store(std::max(a_milliseconds, 0), std::memory_order_relaxed);
+}
+
+std::optional<float> ScriptOverrides::TakeVisibilityPush()
+{
+	const auto ms = _visibilityPush.exchange(-1, std::memory_order_relaxed);
+	if (ms < 0) {
+		return std::nullopt;
+	}
+	return static_cast<float>(ms) / 1000.0f;
+}
+
+int ScriptOverrides::GetMode(std::string_view a_elementId) const
+{
+	std::scoped_lock guard(_lock);
+	const auto it = _stacks.find(a_elementId);
+	return it != _stacks.end() ? it->second.back().mode : -1;
+}
+
+void ScriptOverrides::Snapshot(std::vector<std::pair<std::string, int>>& a_modes) const
+{
+	std::scoped_lock guard(_lock);
+	a_modes.clear();
+	a_modes.reserve(_stacks.size());
+	for (const auto& [id, stack] : _stacks) {
+		a_modes.emplace_back(id, stack.back().mode);
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Utils.h"
+
+// Element mode overrides pushed by scripts through the Papyrus natives (Papyrus.h).
+// Every element keeps a stack ordered by priority, so the winning override is always its last entry.
+// HUDManager copies the winners when the generation changes; per-frame evaluation is a lookup.
+// Overrides are not saved: they are dropped when a game is loaded or started.
+class ScriptOverrides : public ISingleton<ScriptOverrides>
+{
+public:
+	// Pseudo element: a winning kHidden override hides the HUD and suspends control, like g_DisableiHUD.
+	static constexpr std::string_view kHUDElementId = "HUD";
+
+	// Returns the handle of the new override, or 0 if the element id or mode is invalid.
+	std::int32_t Push(std::string_view a_elementId, int a_mode, std::int32_t a_priority);
+	bool Pop(std::int32_t a_handle);
+	void Clear();
+
+	// Shows the HUD for a_milliseconds as if toggled on (0 ends a running push). Consumed by HUDManager.
+	void PushVisibility(std::int32_t a_milliseconds);
+	[[nodiscard]] std::optional<float> TakeVisibilityPush();
+
+	[[nodiscard]] std::uint32_t GetGeneration() const { return _generation.load(std::memory_order_acquire); }
+
+	// Winning mode of an element, -1 without override
+	[[nodiscard]] int GetMode(std::string_view a_elementId) const;
+
+	// Winning mode of every element that has at least one override
+	void Snapshot(std::vector<std::pair<std::string, int>>& a_modes) const;
+
+private:
+	struct Entry
+	{
+		std::int32_t handle;
+		std::int32_t priority;
+		int mode;
+	};
+
+	mutable std::mutex _lock;
+	std::unordered_map<std::string, std::vector<Entry>, Utils::TransparentStringHash, std::equal_to<>> _stacks;
+	std::unordered_map<std::int32_t, std::string> _handles;  // Handle -> element id
+	std::int32_t _nextHandle = 1;
+	std::atomic<std::uint32_t> _generation{ 1 };
+	std::atomic<std::int32_t> _visibilityPush{ -1 };  // Milliseconds, -1 while nothing is pending
+};
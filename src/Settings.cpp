@@ -1,5 +1,10 @@
 #include "Settings.h"
+#include "GFxOps.h"
 #include "HUDElements.h"
+#include "MCMConfig.h"
+#include "Profiler.h"
+#include "StringKernels.h"
+#include "Trace.h"
 #include "Utils.h"
 
 	// -------------------------------------------------------------------------
@@ -38,6 +43,8 @@ void Settings::Load()
 	}
 
 	// Use the helper to handle file I/O logic
+	std::vector<std::string> ignoredUrls;
+
 	LoadINI(defaultPath, userPath, [&](CSimpleIniA& ini) {
 		const char* sectionHUD = "HUD";
 
@@ -55,6 +62,12 @@ void Settings::Load()
 
 		_displayDuration = static_cast<float>(ini.GetDoubleValue(sectionHUD, "fDisplayDuration", 0.0));
 		_dumpHUD = ini.GetBoolValue(sectionHUD, "bDumpHUD", false);
+		_dumpPerfStats = ini.GetBoolValue(sectionHUD, "bDumpPerfStats", false);
+		_recordTrace = ini.GetBoolValue(sectionHUD, "bRecordTrace", false);
+		_replayTrace = ini.GetBoolValue(sectionHUD, "bReplayTrace", false);
+		_alphaWritePath = static_cast<int>(ini.GetLongValue(sectionHUD, "iAlphaWritePath", 0));
+		_nativeTweens = ini.GetBoolValue(sectionHUD, "bNativeTweens", false);
+		_alphaStep = std::clamp(static_cast<float>(ini.GetDoubleValue(sectionHUD, "fAlphaStep", 1.0)), 0.0f, 10.0f);
 		_logMenuFlags = ini.GetBoolValue(sectionHUD, "bLogMenuFlags", false);
 
 		_hudOpacityMin = static_cast<float>(ini.GetDoubleValue(sectionHUD, "fHUDOpacityMin", 0.0));
@@ -67,6 +80,23 @@ void Settings::Load()
 		_crosshair.hideWhileSneaking = ini.GetBoolValue("Crosshair", "bHideWhileSneaking", false);
 		_sneakMeter.enabled = ini.GetBoolValue("SneakMeter", "bEnabled", true);
 
+		// --- User Blocklist ---
+		// Comma-separated URL fragments, e.g. "mymod/overlay.swf, otherwidget.swf"
+		ignoredUrls.clear();
+		std::string_view list = ini.GetValue("Discovery", "sIgnoredUrls", "");
+		while (!list.empty()) {
+			const auto comma = list.find(',');
+			auto item = list.substr(0, comma);
+			list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+			const auto first = item.find_first_not_of(" \t");
+			if (first == std::string_view::npos) {
+				continue;
+			}
+			item = item.substr(first, item.find_last_not_of(" \t") - first + 1);
+			ignoredUrls.emplace_back(item);
+		}
+
 		// --- Map Vanilla HUD Elements ---
 		_widgetPathToMode.clear();
 		for (const auto& def : HUDElements::Get()) {
@@ -88,6 +118,19 @@ void Settings::Load()
 		}
 	});
 
+	Profiler::SetEnabled(_dumpPerfStats);
+	Trace::SetRecording(_recordTrace);
+	GFxOps::SetAlphaWritePath(_alphaWritePath == 1 ? GFxOps::AlphaWritePath::kMember : GFxOps::AlphaWritePath::kDisplayInfo);
+
+	_resolvedModes.clear();
+
+	// The matcher is compiled once and only rebuilt when the user list changes
+	if (!_matcherBuilt || ignoredUrls != _ignoredUrls) {
+		_ignoredUrls = std::move(ignoredUrls);
+		Utils::BuildMatcher(_ignoredUrls);
+		_matcherBuilt = true;
+	}
+
 	// --- Load Path Cache ---
 	if (_subWidgetPaths.empty() && fs::exists(cachePath)) {
 		CSimpleIniA cacheIni;
@@ -100,6 +143,8 @@ void Settings::Load()
 				return;
 			}
 
+			_cachedFingerprint = cacheIni.GetValue("General", "sLaunchFingerprint", "");
+
 			CSimpleIniA::TNamesDepend cacheKeys;
 			cacheIni.GetAllKeys("PathCache", cacheKeys);
 
@@ -124,6 +169,9 @@ void Settings::SaveCache()
 
 	cacheIni.SetLongValue("General", "iCacheVersion", kCacheVersion);
 
+	_cachedFingerprint = ComputeLaunchFingerprint();
+	cacheIni.SetValue("General", "sLaunchFingerprint", _cachedFingerprint.c_str());
+
 	for (const auto& path : _subWidgetPaths) {
 		cacheIni.SetValue("PathCache", path.c_str(), GetWidgetSource(path).c_str());
 	}
@@ -131,12 +179,81 @@ void Settings::SaveCache()
 	cacheIni.SaveFile(cachePath.string().c_str());
 }
 
+// Load order, DLLs and the SkyHUD config cannot change while the game runs: hashed once per launch.
+std::uint64_t Settings::GetLaunchHash() const
+{
+	if (_launchHash) {
+		return *_launchHash;
+	}
+
+	std::uint64_t hash = Utils::HashString(Version::NAME);
+	hash = Utils::HashString(std::to_string(kCacheVersion), hash);
+
+	// 1. Load order
+	if (auto dataHandler = RE::TESDataHandler::GetSingleton()) {
+		for (const auto file : dataHandler->files) {
+			if (file) {
+				hash = Utils::HashString(file->GetFilename(), hash);
+			}
+		}
+	}
+
+	// 2. SKSE plugin DLLs (size and timestamp stand in for the version)
+	std::error_code ec;
+	std::vector<std::string> dlls;
+	for (const auto& entry : fs::directory_iterator(pluginsPath, ec)) {
+		if (!entry.is_regular_file(ec) || !string::iequals(entry.path().extension().string(), ".dll")) {
+			continue;
+		}
+		auto size = entry.file_size(ec);
+		auto time = entry.last_write_time(ec).time_since_epoch().count();
+		dlls.push_back(std::format("{}|{}|{}", entry.path().filename().string(), size, time));
+	}
+	std::sort(dlls.begin(), dlls.end());
+	for (const auto& dll : dlls) {
+		hash = Utils::HashString(dll, hash);
+	}
+
+	// 3. SkyHUD config: bAltCharge decides which enchant meters the MCM lists
+	{
+		std::ifstream file(skyhudPath, std::ios::binary);
+		std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		hash = Utils::HashString(contents, hash);
+	}
+
+	_launchHash = hash;
+	return hash;
+}
+
+// Only the generated files are read again; MCMGen rewrites them during the session.
+std::string Settings::ComputeLaunchFingerprint() const
+{
+	std::uint64_t hash = GetLaunchHash();
+
+	// Generated MCM files
+	for (const auto& path : { configPath, defaultPath }) {
+		std::ifstream file(path, std::ios::binary);
+		std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		hash = Utils::HashString(contents, hash);
+	}
+
+	return std::format("{:016X}", hash);
+}
+
+bool Settings::IsLaunchFingerprintCurrent() const
+{
+	return !_cachedFingerprint.empty() && _cachedFingerprint == ComputeLaunchFingerprint();
+}
+
 void Settings::ResetCache()
 {
 	_subWidgetPaths.clear();
 	_widgetSources.clear();
 	_widgetPathToMode.clear();
 	_dynamicWidgetModes.clear();
+	_resolvedModes.clear();
+	_sourceGenerations.clear();
+	_sourceResetGeneration = ++_sourceGeneration;
 }
 
 void Settings::SetDumpHUDEnabled(bool a_enabled)
@@ -162,31 +279,34 @@ void Settings::SetDumpHUDEnabled(bool a_enabled)
 	ini.SaveFile(userPath.string().c_str());
 }
 
-bool Settings::AddDiscoveredPath(const std::string& a_path, const std::string& a_source)
+bool Settings::AddDiscoveredPath(std::string_view a_path, std::string_view a_source)
 {
 	// Sanity check: Prevent cache corruption from garbage Scaleform names / binary memory.
 	// Valid paths (Scaleform instances and UI menu names) should be strictly standard printable ASCII.
-	for (char c : a_path) {
-		auto uc = static_cast<unsigned char>(c);
-		if (uc < 32 || uc > 126) {
-			return false;  // Reject corrupt/binary paths immediately
-		}
+	if (!StringKernels::IsPrintableAscii(a_path)) {
+		return false;  // Reject corrupt/binary paths immediately
 	}
 
 	bool changed = false;
 
 	// 1. Add path if new
 	if (!_subWidgetPaths.contains(a_path)) {
-		_subWidgetPaths.insert(a_path);
+		_subWidgetPaths.emplace(a_path);
 		changed = true;
 	}
 
 	// 2. Update Source if changed
 	// Necessary for index collision handling (e.g. if WidgetContainer.0 changes from "Meter" to "Clock")
 	if (!a_source.empty()) {
-		std::string decoded = Utils::UrlDecode(a_source);
-		if (_widgetSources[a_path] != decoded) {
-			_widgetSources[a_path] = decoded;
+		// Rescans mostly confirm known sources: decode into a reused buffer and only copy on change
+		thread_local std::string decoded;
+		Utils::UrlDecode(a_source, decoded);
+		auto it = _widgetSources.find(a_path);
+		if (it == _widgetSources.end() || it->second != decoded) {
+			const std::string path(a_path);
+			_widgetSources[path] = decoded;
+			_resolvedModes.erase(path);
+			_sourceGenerations[path] = ++_sourceGeneration;
 			changed = true;
 		}
 	}
@@ -194,13 +314,21 @@ bool Settings::AddDiscoveredPath(const std::string& a_path, const std::string& a
 	return changed;
 }
 
-std::string Settings::GetWidgetSource(const std::string& a_path) const
+const std::string& Settings::GetWidgetSource(std::string_view a_path) const
 {
+	static const std::string kUnknown = "Unknown";
+
 	auto it = _widgetSources.find(a_path);
-	return it != _widgetSources.end() ? it->second : "Unknown";
+	return it != _widgetSources.end() ? it->second : kUnknown;
+}
+
+std::uint32_t Settings::GetSourceGeneration(std::string_view a_path) const
+{
+	auto it = _sourceGenerations.find(a_path);
+	return it != _sourceGenerations.end() ? std::max(it->second, _sourceResetGeneration) : _sourceResetGeneration;
 }
 
-int Settings::GetWidgetMode(const std::string& a_rawPath) const
+int Settings::GetWidgetMode(std::string_view a_rawPath) const
 {
 	// 1. Check direct override (Vanilla elements / Static mappings)
 	auto it = _widgetPathToMode.find(a_rawPath);
@@ -208,13 +336,24 @@ int Settings::GetWidgetMode(const std::string& a_rawPath) const
 		return it->second;
 	}
 
+	if (auto cached = _resolvedModes.find(a_rawPath); cached != _resolvedModes.end()) {
+		return cached->second;
+	}
+
+	const int mode = ResolveDynamicWidgetMode(a_rawPath);
+	_resolvedModes.emplace(a_rawPath, mode);
+	return mode;
+}
+
+int Settings::ResolveDynamicWidgetMode(std::string_view a_rawPath) const
+{
 	// 2. Resolve Dynamic Source-based ID
 	// This ensures that "meter.swf" shares a setting regardless of being _root.WidgetContainer.5 or .13
-	std::string source = GetWidgetSource(a_rawPath);
+	const std::string& source = GetWidgetSource(a_rawPath);
 
 	// Generate the Stable ID
-	std::string prettyName = Utils::GetWidgetDisplayName(source);
-	std::string safeID = Utils::SanitizeName(prettyName);
+	std::string prettyName = MCMConfig::GetWidgetDisplayName(source);
+	std::string safeID = MCMConfig::SanitizeName(prettyName);
 	std::string iniKey = "iMode_" + safeID;
 
 	// 3. Look up in cached dynamic settings
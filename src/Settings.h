@@ -1,23 +1,15 @@
 #pragma once
 
+#include "Utils.h"
+#include "WidgetMode.h"
+
 class Settings : public ISingleton<Settings>
 {
 public:
 	static constexpr long kCacheVersion = 2; 
 
-	enum WidgetMode
-	{
-		kVisible = 0,
-		kImmersive = 1,
-		kHidden = 2,
-		kIgnored = 3,
-		kInterior = 4,
-		kExterior = 5,
-		kInCombat = 6,
-		kNotInCombat = 7,
-		kWeaponDrawn = 8,
-		kLockedOn = 9
-	};
+	using WidgetMode = WidgetModes::WidgetMode;
+	using enum WidgetModes::WidgetMode;
 
 	struct CrosshairSettings
 	{
@@ -36,7 +28,12 @@ public:
 	void ResetCache();
 	void SetDumpHUDEnabled(bool a_enabled);
 
-	[[nodiscard]] bool AddDiscoveredPath(const std::string& a_path, const std::string& a_source = "");
+	// Launch fingerprint: plugin list, SKSE plugin DLLs, SkyHUD config, cache version and generated MCM files.
+	// Matching the fingerprint stored by the previous launch means the main menu config is still valid.
+	[[nodiscard]] std::string ComputeLaunchFingerprint() const;
+	[[nodiscard]] bool IsLaunchFingerprintCurrent() const;
+
+	[[nodiscard]] bool AddDiscoveredPath(std::string_view a_path, std::string_view a_source = {});
 
 	[[nodiscard]] std::uint32_t GetToggleKey() const { return _toggleKey; }
 	[[nodiscard]] bool IsHoldMode() const { return _holdMode; }
@@ -47,6 +44,12 @@ public:
 	[[nodiscard]] float GetFadeOutSpeed() const { return _fadeOutSpeed; }
 	[[nodiscard]] float GetDisplayDuration() const { return _displayDuration; }
 	[[nodiscard]] bool IsDumpHUDEnabled() const { return _dumpHUD; }
+	[[nodiscard]] bool IsDumpPerfStatsEnabled() const { return _dumpPerfStats; }
+	[[nodiscard]] bool IsRecordTraceEnabled() const { return _recordTrace; }
+	[[nodiscard]] bool IsReplayTraceEnabled() const { return _replayTrace; }
+	[[nodiscard]] int GetAlphaWritePath() const { return _alphaWritePath; }
+	[[nodiscard]] bool IsNativeTweensEnabled() const { return _nativeTweens; }
+	[[nodiscard]] float GetAlphaStep() const { return _alphaStep; }
 	[[nodiscard]] bool IsMenuFlagLoggingEnabled() const { return _logMenuFlags; }
 
 	[[nodiscard]] float GetHUDOpacityMin() const { return _hudOpacityMin; }
@@ -54,10 +57,16 @@ public:
 	[[nodiscard]] float GetContextOpacityMin() const { return _contextOpacityMin; }
 	[[nodiscard]] float GetContextOpacityMax() const { return _contextOpacityMax; }
 
-	[[nodiscard]] int GetWidgetMode(const std::string& a_rawPath) const;
+	// Dynamic widget modes are resolved once per path and memoized until settings or sources change.
+	[[nodiscard]] int GetWidgetMode(std::string_view a_rawPath) const;
+
+	[[nodiscard]] const std::set<std::string, std::less<>>& GetSubWidgetPaths() const { return _subWidgetPaths; }
+	[[nodiscard]] const std::string& GetWidgetSource(std::string_view a_path) const;
 
-	[[nodiscard]] const std::set<std::string>& GetSubWidgetPaths() const { return _subWidgetPaths; }
-	[[nodiscard]] std::string GetWidgetSource(const std::string& a_path) const;
+	// Bumped whenever the scanner assigns a new source to a slot (or the cache is reset).
+	// The per-path overload returns the generation of that slot's last change.
+	[[nodiscard]] std::uint32_t GetSourceGeneration() const { return _sourceGeneration; }
+	[[nodiscard]] std::uint32_t GetSourceGeneration(std::string_view a_path) const;
 
 	[[nodiscard]] const CrosshairSettings& GetCrosshairSettings() const { return _crosshair; }
 	[[nodiscard]] const SneakMeterSettings& GetSneakMeterSettings() const { return _sneakMeter; }
@@ -67,9 +76,15 @@ private:
 
 	void LoadINI(const fs::path& a_defaultPath, const fs::path& a_userPath, INIFunc a_func);
 
+	[[nodiscard]] int ResolveDynamicWidgetMode(std::string_view a_rawPath) const;
+	[[nodiscard]] std::uint64_t GetLaunchHash() const;
+
 	const fs::path defaultPath{ "Data/MCM/Config/ImmersiveHUD/settings.ini" };
 	const fs::path userPath{ "Data/MCM/Settings/ImmersiveHUD.ini" };
 	const fs::path cachePath{ "Data/SKSE/Plugins/ImmersiveHUD_Cache.ini" };
+	const fs::path configPath{ "Data/MCM/Config/ImmersiveHUD/config.json" };
+	const fs::path pluginsPath{ "Data/SKSE/Plugins" };
+	const fs::path skyhudPath{ "Data/Interface/skyhud/skyhud.txt" };
 
 	std::uint32_t _toggleKey = 0x2D;
 	bool _holdMode = false;
@@ -80,6 +95,12 @@ private:
 	float _fadeOutSpeed = 5.0f;
 	float _displayDuration = 0.0f;
 	bool _dumpHUD = false;
+	bool _dumpPerfStats = false;
+	bool _recordTrace = false;
+	bool _replayTrace = false;
+	int _alphaWritePath = 0;
+	bool _nativeTweens = false;
+	float _alphaStep = 1.0f;
 	bool _logMenuFlags = false;
 
 	float _hudOpacityMin = 0.0f;
@@ -90,8 +111,16 @@ private:
 	CrosshairSettings _crosshair;
 	SneakMeterSettings _sneakMeter;
 
-	std::map<std::string, int> _widgetPathToMode;
+	std::map<std::string, int, std::less<>> _widgetPathToMode;
 	std::map<std::string, int> _dynamicWidgetModes;
-	std::set<std::string> _subWidgetPaths;
-	std::map<std::string, std::string> _widgetSources;
+	std::set<std::string, std::less<>> _subWidgetPaths;
+	std::map<std::string, std::string, std::less<>> _widgetSources;
+	mutable std::unordered_map<std::string, int, Utils::TransparentStringHash, std::equal_to<>> _resolvedModes;
+	std::map<std::string, std::uint32_t, std::less<>> _sourceGenerations;
+	std::uint32_t _sourceGeneration = 1;
+	std::uint32_t _sourceResetGeneration = 1;
+	std::string _cachedFingerprint;
+	mutable std::optional<std::uint64_t> _launchHash;
+	std::vector<std::string> _ignoredUrls;
+	bool _matcherBuilt = false;
 };
@@ -0,0 +1,52 @@
+#include "SourceProbe.h"
+
+#include <thread>
+
+namespace SourceProbe
+{
+	void Resolver::Probe(const std::vector<std::string>& a_sources)
+	{
+		std::vector<const std::string*> pending;
+		std::unordered_set<std::string_view> seen;
+		for (const auto& source : a_sources) {
+			if (!_cache.contains(source) && seen.insert(source).second) {
+				pending.push_back(&source);
+			}
+		}
+
+		if (pending.empty()) {
+			return;
+		}
+
+		std::vector<char> results(pending.size(), 0);
+		const std::size_t workerCount = _backend.IsThreadSafe() ? std::min(kMaxWorkers, pending.size()) : 1;
+
+		if (workerCount <= 1) {
+			for (std::size_t i = 0; i < pending.size(); i++) {
+				results[i] = _backend.Exists(*pending[i]);
+			}
+		} else {
+			std::atomic_size_t next = 0;
+			std::vector<std::jthread> workers;
+			workers.reserve(workerCount);
+			for (std::size_t w = 0; w < workerCount; w++) {
+				workers.emplace_back([&]() {
+					for (std::size_t i = next++; i < pending.size(); i = next++) {
+						results[i] = _backend.Exists(*pending[i]);
+					}
+				});
+			}
+			// jthread joins on destruction
+		}
+
+		for (std::size_t i = 0; i < pending.size(); i++) {
+			_cache.emplace(*pending[i], results[i] != 0);
+		}
+	}
+
+	bool Resolver::Exists(std::string_view a_source) const
+	{
+		const auto it = _cache.find(a_source);
+		return it != _cache.end() && it->second;
+	}
+}
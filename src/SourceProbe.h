@@ -0,0 +1,49 @@
+#pragma once
+
+#include "StringKernels.h"
+
+// Source-file existence checks for MCM pruning (MCMGen). Config entries whose source is not loaded are
+// resolved in one batch per update: deduplicated, probed once and cached for the session.
+// Builds without game headers: the game backend is BSResource (MCMGen.cpp), tests/SourceProbeTests.cpp
+// and tests/SourceProbeBench.cpp use fakes and loose files.
+namespace SourceProbe
+{
+	// Answers whether a source exists as a loose file or inside a loaded archive.
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+
+		virtual bool Exists(const std::string& a_source) = 0;
+
+		// True if Exists may run on several threads at once.
+		virtual bool IsThreadSafe() const = 0;
+	};
+
+	// Session cache in front of a Backend.
+	class Resolver
+	{
+	public:
+		static constexpr std::size_t kMaxWorkers = 4;
+
+		explicit Resolver(Backend& a_backend) :
+			_backend(a_backend)
+		{}
+
+		// Probes every uncached source of a_sources once. Thread-safe backends share the batch
+		// between up to kMaxWorkers threads; others are probed in order on the calling thread.
+		void Probe(const std::vector<std::string>& a_sources);
+
+		// Cached result of a probed source; false if it was never probed.
+		[[nodiscard]] bool Exists(std::string_view a_source) const;
+
+		// Drops every cached result (new session).
+		void Invalidate() { _cache.clear(); }
+
+		[[nodiscard]] std::size_t CachedCount() const { return _cache.size(); }
+
+	private:
+		Backend& _backend;
+		std::unordered_map<std::string, bool, StringKernels::TransparentStringHash, std::equal_to<>> _cache;
+	};
+}
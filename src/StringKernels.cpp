@@ -0,0 +1,249 @@
+#include "StringKernels.h"
+
+#if !defined(IHUD_NO_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#	define IHUD_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace StringKernels
+{
+	namespace
+	{
+		constexpr char LowerAscii(char a_c)
+		{
+			return (a_c >= 'A' && a_c <= 'Z') ? static_cast<char>(a_c | 0x20) : a_c;
+		}
+
+		constexpr bool IsAlnumAscii(char a_c)
+		{
+			return (a_c >= '0' && a_c <= '9') || (a_c >= 'A' && a_c <= 'Z') || (a_c >= 'a' && a_c <= 'z');
+		}
+
+		constexpr int HexValue(char a_c)
+		{
+			if (a_c >= '0' && a_c <= '9') {
+				return a_c - '0';
+			}
+			const char lower = static_cast<char>(a_c | 0x20);
+			if (lower >= 'a' && lower <= 'f') {
+				return lower - 'a' + 10;
+			}
+			return -1;
+		}
+
+		constexpr bool IsSpaceAscii(char a_c)
+		{
+			return a_c == ' ' || (a_c >= '\t' && a_c <= '\r');
+		}
+
+		// Reads the two bytes after a '%' the way UrlDecode's sscanf("%x") did: leading whitespace,
+		// an optional sign and as many hex digits as follow. False if there is no digit to convert.
+		bool DecodeEscape(char a_first, char a_second, char& a_out)
+		{
+			const char buffer[2] = { a_first, a_second };
+			const std::size_t size = a_first == '\0' ? 0 : (a_second == '\0' ? 1 : 2);
+
+			std::size_t pos = 0;
+			while (pos < size && IsSpaceAscii(buffer[pos])) {
+				pos++;
+			}
+			bool negative = false;
+			if (pos < size && (buffer[pos] == '+' || buffer[pos] == '-')) {
+				negative = buffer[pos] == '-';
+				pos++;
+			}
+			if (pos == size || HexValue(buffer[pos]) < 0) {
+				return false;
+			}
+
+			unsigned value = 0;
+			for (; pos < size && HexValue(buffer[pos]) >= 0; pos++) {
+				value = (value << 4) | static_cast<unsigned>(HexValue(buffer[pos]));
+			}
+			a_out = static_cast<char>(negative ? 0u - value : value);
+			return true;
+		}
+
+#ifdef IHUD_SSE2
+		// Byte-wise a_lo <= x <= a_hi for signed bytes (bytes >= 0x80 are negative and never match ASCII ranges).
+		inline __m128i InRange(__m128i a_x, char a_lo, char a_hi)
+		{
+			return _mm_and_si128(
+				_mm_cmpgt_epi8(a_x, _mm_set1_epi8(static_cast<char>(a_lo - 1))),
+				_mm_cmplt_epi8(a_x, _mm_set1_epi8(static_cast<char>(a_hi + 1))));
+		}
+
+		inline __m128i Lower16(__m128i a_x)
+		{
+			return _mm_or_si128(a_x, _mm_and_si128(InRange(a_x, 'A', 'Z'), _mm_set1_epi8(0x20)));
+		}
+
+		inline __m128i Load16(const char* a_ptr)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_ptr));
+		}
+
+		inline void Store16(char* a_ptr, __m128i a_x)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(a_ptr), a_x);
+		}
+
+		inline unsigned LowestBit(unsigned a_mask)
+		{
+			return static_cast<unsigned>(std::countr_zero(a_mask));
+		}
+#endif
+	}
+
+	void ToLowerAscii(char* a_data, std::size_t a_size)
+	{
+		std::size_t i = 0;
+#ifdef IHUD_SSE2
+		for (; i + 16 <= a_size; i += 16) {
+			Store16(a_data + i, Lower16(Load16(a_data + i)));
+		}
+#endif
+		for (; i < a_size; i++) {
+			a_data[i] = LowerAscii(a_data[i]);
+		}
+	}
+
+	bool IsPrintableAscii(std::string_view a_str)
+	{
+		const char* data = a_str.data();
+		const std::size_t size = a_str.size();
+		std::size_t i = 0;
+#ifdef IHUD_SSE2
+		for (; i + 16 <= size; i += 16) {
+			if (_mm_movemask_epi8(InRange(Load16(data + i), 0x20, 0x7E)) != 0xFFFF) {
+				return false;
+			}
+		}
+#endif
+		for (; i < size; i++) {
+			const auto uc = static_cast<unsigned char>(data[i]);
+			if (uc < 0x20 || uc > 0x7E) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::size_t FindNoCase(std::string_view a_haystack, std::string_view a_needle)
+	{
+		if (a_needle.empty()) {
+			return 0;
+		}
+		if (a_needle.size() > a_haystack.size()) {
+			return std::string_view::npos;
+		}
+
+		const char* hay = a_haystack.data();
+		const char* needle = a_needle.data();
+		const std::size_t needleSize = a_needle.size();
+		const std::size_t last = a_haystack.size() - needleSize;  // Last valid start position
+
+		auto matchesAt = [&](std::size_t a_pos) {
+			for (std::size_t k = 1; k < needleSize; k++) {
+				if (LowerAscii(hay[a_pos + k]) != needle[k]) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		std::size_t i = 0;
+#ifdef IHUD_SSE2
+		// Filter candidate starts on the first and last needle byte, 16 positions at a time.
+		const __m128i first = _mm_set1_epi8(needle[0]);
+		const __m128i tail = _mm_set1_epi8(needle[needleSize - 1]);
+		for (; i + 16 <= last + 1; i += 16) {
+			const __m128i a = Lower16(Load16(hay + i));
+			const __m128i b = Lower16(Load16(hay + i + needleSize - 1));
+			auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, tail))));
+			while (mask) {
+				const std::size_t pos = i + LowestBit(mask);
+				if (matchesAt(pos)) {
+					return pos;
+				}
+				mask &= mask - 1;
+			}
+		}
+#endif
+		for (; i <= last; i++) {
+			if (LowerAscii(hay[i]) == needle[0] && matchesAt(i)) {
+				return i;
+			}
+		}
+		return std::string_view::npos;
+	}
+
+	void SanitizeAlnum(char* a_data, std::size_t a_size)
+	{
+		std::size_t i = 0;
+#ifdef IHUD_SSE2
+		const __m128i underscore = _mm_set1_epi8('_');
+		for (; i + 16 <= a_size; i += 16) {
+			const __m128i x = Load16(a_data + i);
+			const __m128i keep = _mm_or_si128(InRange(x, '0', '9'), InRange(Lower16(x), 'a', 'z'));
+			Store16(a_data + i, _mm_or_si128(_mm_and_si128(keep, x), _mm_andnot_si128(keep, underscore)));
+		}
+#endif
+		for (; i < a_size; i++) {
+			if (!IsAlnumAscii(a_data[i])) {
+				a_data[i] = '_';
+			}
+		}
+	}
+
+	void PercentDecode(std::string_view a_src, std::string& a_out)
+	{
+		a_out.clear();
+		a_out.reserve(a_src.size());
+
+		const char* src = a_src.data();
+		const std::size_t size = a_src.size();
+		std::size_t i = 0;
+
+		while (i < size) {
+			// Copy the run of plain bytes up to the next '%' or '+' in one append.
+			std::size_t run = i;
+#ifdef IHUD_SSE2
+			const __m128i percent = _mm_set1_epi8('%');
+			const __m128i plus = _mm_set1_epi8('+');
+			for (; run + 16 <= size; run += 16) {
+				const __m128i x = Load16(src + run);
+				const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, percent), _mm_cmpeq_epi8(x, plus))));
+				if (mask) {
+					run += LowestBit(mask);
+					break;
+				}
+			}
+#endif
+			while (run < size && src[run] != '%' && src[run] != '+') {
+				run++;
+			}
+			a_out.append(src + i, run - i);
+			i = run;
+
+			if (i >= size) {
+				break;
+			}
+
+			if (src[i] == '+') {
+				a_out += ' ';
+				i++;
+				continue;
+			}
+
+			// '%': an escape always consumes both following bytes, otherwise the '%' is kept literally
+			if (char decoded; i + 2 < size && DecodeEscape(src[i + 1], src[i + 2], decoded)) {
+				a_out += decoded;
+				i += 3;
+				continue;
+			}
+			a_out += '%';
+			i++;
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// ASCII string kernels used by the discovery and apply paths.
+// SSE2 versions process 16 bytes per step; every kernel has a scalar fallback
+// (selected when SSE2 is unavailable or IHUD_NO_SIMD is defined) with identical results.
+namespace StringKernels
+{
+	// Lowercases A-Z in place. Other bytes are left untouched.
+	void ToLowerAscii(char* a_data, std::size_t a_size);
+
+	// True if every byte is printable ASCII (0x20-0x7E).
+	bool IsPrintableAscii(std::string_view a_str);
+
+	// Case-insensitive search for an already lowercase needle. Returns npos if not found.
+	std::size_t FindNoCase(std::string_view a_haystack, std::string_view a_needle);
+
+	// Replaces every byte that is not an ASCII letter or digit with '_'.
+	void SanitizeAlnum(char* a_data, std::size_t a_size);
+
+	// Percent-decodes a_src into a_out ("%2F" -> '/', '+' -> ' ').
+	// The two bytes after '%' are read like the former sscanf("%x") decoder: "% 5" and "%4G" still
+	// decode to 0x05 and 0x04, consuming both bytes. Where sscanf found no hex digit at all it appended
+	// an indeterminate value; that case, and a '%' in the last two bytes, is copied literally.
+	void PercentDecode(std::string_view a_src, std::string& a_out);
+
+	// Hash for unordered containers keyed by std::string that are queried with std::string_view.
+	struct TransparentStringHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(std::string_view a_str) const noexcept { return std::hash<std::string_view>{}(a_str); }
+	};
+}
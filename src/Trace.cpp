@@ -0,0 +1,369 @@
+#include "Trace.h"
+
+namespace Trace
+{
+	// File layout (little endian):
+	//   header: "IHTR" u32 version
+	//   'C' record: f32 hudMax hudMin ctxMax ctxMin fadeIn fadeOut, i32 stealthMeterMode, u8 config flags
+	//   'F' record: f32 delta, f32 detectionLevel, u16 input flags, u8 events
+	//               (kSkipped/kDisabled frames carry default inputs)
+	static constexpr std::array<char, 4> kMagic = { 'I', 'H', 'T', 'R' };
+	static constexpr std::uint32_t kVersion = 1;
+	static constexpr std::uint8_t kConfigTag = 'C';
+	static constexpr std::uint8_t kFrameTag = 'F';
+	static constexpr std::size_t kFlushThreshold = 64 * 1024;
+
+	// Bit order of the packed flags. Append only: reordering breaks existing traces.
+	static constexpr std::array kInputFlags = {
+		&FadeEngine::Inputs::userWantsVisible,
+		&FadeEngine::Inputs::shouldHide,
+		&FadeEngine::Inputs::isInterior,
+		&FadeEngine::Inputs::isInCombat,
+		&FadeEngine::Inputs::isWeaponDrawn,
+		&FadeEngine::Inputs::isSneaking,
+		&FadeEngine::Inputs::isSneakAllowed,
+		&FadeEngine::Inputs::isLockedOn,
+		&FadeEngine::Inputs::isSmoothCam,
+		&FadeEngine::Inputs::isTDM,
+		&FadeEngine::Inputs::isBTPS,
+		&FadeEngine::Inputs::isActionActive,
+		&FadeEngine::Inputs::isLookActive,
+		&FadeEngine::Inputs::hasLeftEnchant,
+		&FadeEngine::Inputs::hasRightEnchant,
+		&FadeEngine::Inputs::smoothCamOwnsCrosshair
+	};
+	static_assert(kInputFlags.size() <= 16);
+
+	static constexpr std::array kConfigFlags = {
+		&FadeEngine::Config::alwaysShowInCombat,
+		&FadeEngine::Config::alwaysShowWeaponDrawn,
+		&FadeEngine::Config::crosshairEnabled,
+		&FadeEngine::Config::crosshairHideWhileAiming,
+		&FadeEngine::Config::crosshairHideWhileSneaking,
+		&FadeEngine::Config::sneakMeterEnabled,
+		&FadeEngine::Config::detectionClaimed
+	};
+	static_assert(kConfigFlags.size() <= 8);
+
+	template <class T, class Flags>
+	static auto PackFlags(const T& a_value, const Flags& a_flags)
+	{
+		std::uint32_t bits = 0;
+		for (std::size_t i = 0; i < a_flags.size(); i++) {
+			if (a_value.*a_flags[i]) {
+				bits |= 1u << i;
+			}
+		}
+		return bits;
+	}
+
+	template <class T, class Flags>
+	static void UnpackFlags(T& a_value, const Flags& a_flags, std::uint32_t a_bits)
+	{
+		for (std::size_t i = 0; i < a_flags.size(); i++) {
+			a_value.*a_flags[i] = (a_bits & (1u << i)) != 0;
+		}
+	}
+
+	template <class T>
+	static void Put(std::vector<std::uint8_t>& a_buffer, T a_value)
+	{
+		const auto offset = a_buffer.size();
+		a_buffer.resize(offset + sizeof(T));
+		std::memcpy(a_buffer.data() + offset, &a_value, sizeof(T));
+	}
+
+	// Bounds-checked reader over a loaded trace.
+	class Reader
+	{
+	public:
+		explicit Reader(const std::vector<std::uint8_t>& a_data) :
+			_data(a_data)
+		{}
+
+		template <class T>
+		bool Get(T& a_value)
+		{
+			if (_data.size() - _pos < sizeof(T)) {
+				return false;
+			}
+			std::memcpy(&a_value, _data.data() + _pos, sizeof(T));
+			_pos += sizeof(T);
+			return true;
+		}
+
+		[[nodiscard]] bool AtEnd() const { return _pos >= _data.size(); }
+
+	private:
+		const std::vector<std::uint8_t>& _data;
+		std::size_t _pos = 0;
+	};
+
+	struct Recorder
+	{
+		std::mutex lock;
+		std::ofstream file;
+		std::vector<std::uint8_t> buffer;
+		std::optional<FadeEngine::Config> lastConfig;
+		std::uint64_t frames = 0;
+	};
+
+	static Recorder g_recorder;
+	static std::optional<fs::path> g_directory;
+	static std::atomic_bool g_recording{ false };
+	static std::atomic_uint8_t g_pendingEvents{ 0 };
+
+	static void FlushLocked()
+	{
+		if (g_recorder.file.is_open() && !g_recorder.buffer.empty()) {
+			g_recorder.file.write(reinterpret_cast<const char*>(g_recorder.buffer.data()), static_cast<std::streamsize>(g_recorder.buffer.size()));
+			g_recorder.file.flush();
+		}
+		g_recorder.buffer.clear();
+	}
+
+	void SetDirectory(const fs::path& a_directory)
+	{
+		std::scoped_lock guard(g_recorder.lock);
+		g_directory = a_directory;
+	}
+
+	std::optional<fs::path> GetTracePath()
+	{
+		if (!g_directory) {
+			return std::nullopt;
+		}
+		return *g_directory / "ImmersiveHUD_Trace.bin";
+	}
+
+	std::optional<fs::path> GetReplayPath()
+	{
+		if (!g_directory) {
+			return std::nullopt;
+		}
+		return *g_directory / "ImmersiveHUD_Replay.csv";
+	}
+
+	// Opened on the first recorded frame so that a startup replay can still read the previous trace.
+	static bool OpenLocked()
+	{
+		const auto path = GetTracePath();
+		if (!path) {
+			return false;
+		}
+
+		g_recorder.file.open(*path, std::ios::binary | std::ios::trunc);
+		if (!g_recorder.file.is_open()) {
+			logger::error("Failed to open trace file: {}", path->string());
+			return false;
+		}
+
+		g_recorder.buffer.clear();
+		g_recorder.buffer.reserve(kFlushThreshold + 64);
+		g_recorder.buffer.insert(g_recorder.buffer.end(), kMagic.begin(), kMagic.end());
+		Put(g_recorder.buffer, kVersion);
+		g_recorder.lastConfig.reset();
+		g_recorder.frames = 0;
+
+		logger::info("Trace recording started: {}", path->string());
+		return true;
+	}
+
+	void SetRecording(bool a_enabled)
+	{
+		std::scoped_lock guard(g_recorder.lock);
+
+		if (g_recording.exchange(a_enabled) == a_enabled) {
+			return;
+		}
+
+		g_pendingEvents = 0;
+
+		if (!a_enabled && g_recorder.file.is_open()) {
+			FlushLocked();
+			g_recorder.file.close();
+			logger::info("Trace recording stopped after {} frames.", g_recorder.frames);
+		}
+	}
+
+	bool IsRecording()
+	{
+		return g_recording.load(std::memory_order_relaxed);
+	}
+
+	void RecordEvent(Event a_event)
+	{
+		if (IsRecording()) {
+			g_pendingEvents.fetch_or(a_event, std::memory_order_relaxed);
+		}
+	}
+
+	static void PutFrameLocked(const FadeEngine::Inputs& a_inputs, std::uint8_t a_events)
+	{
+		auto& buffer = g_recorder.buffer;
+		Put(buffer, kFrameTag);
+		Put(buffer, a_inputs.delta);
+		Put(buffer, a_inputs.detectionLevel);
+		Put(buffer, static_cast<std::uint16_t>(PackFlags(a_inputs, kInputFlags)));
+		Put(buffer, static_cast<std::uint8_t>(g_pendingEvents.exchange(0, std::memory_order_relaxed) | a_events));
+		g_recorder.frames++;
+
+		if (buffer.size() >= kFlushThreshold) {
+			FlushLocked();
+		}
+	}
+
+	void RecordFrame(const FadeEngine::Inputs& a_inputs, const FadeEngine::Config& a_config)
+	{
+		if (!IsRecording()) {
+			return;
+		}
+
+		std::scoped_lock guard(g_recorder.lock);
+		if (!g_recorder.file.is_open() && !OpenLocked()) {
+			g_recording = false;
+			return;
+		}
+
+		auto& buffer = g_recorder.buffer;
+
+		if (!g_recorder.lastConfig || !(*g_recorder.lastConfig == a_config)) {
+			Put(buffer, kConfigTag);
+			Put(buffer, a_config.hudMax);
+			Put(buffer, a_config.hudMin);
+			Put(buffer, a_config.ctxMax);
+			Put(buffer, a_config.ctxMin);
+			Put(buffer, a_config.fadeInSpeed);
+			Put(buffer, a_config.fadeOutSpeed);
+			Put(buffer, static_cast<std::int32_t>(a_config.stealthMeterMode));
+			Put(buffer, static_cast<std::uint8_t>(PackFlags(a_config, kConfigFlags)));
+			g_recorder.lastConfig = a_config;
+		}
+
+		PutFrameLocked(a_inputs, 0);
+	}
+
+	void RecordEarlyReturn(float a_delta, Event a_reason)
+	{
+		if (!IsRecording()) {
+			return;
+		}
+
+		std::scoped_lock guard(g_recorder.lock);
+		if (!g_recorder.file.is_open() && !OpenLocked()) {
+			g_recording = false;
+			return;
+		}
+
+		FadeEngine::Inputs inputs;
+		inputs.delta = a_delta;
+		PutFrameLocked(inputs, a_reason);
+	}
+
+	void Flush()
+	{
+		std::scoped_lock guard(g_recorder.lock);
+		FlushLocked();
+	}
+
+	bool Replay(const fs::path& a_trace, const fs::path& a_output)
+	{
+		std::ifstream in(a_trace, std::ios::binary);
+		if (!in.is_open()) {
+			logger::warn("Trace replay: cannot open {}", a_trace.string());
+			return false;
+		}
+		const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+		Reader reader(data);
+		std::array<char, 4> magic{};
+		std::uint32_t version = 0;
+		if (!reader.Get(magic) || magic != kMagic || !reader.Get(version) || version != kVersion) {
+			logger::warn("Trace replay: {} is not a version {} trace", a_trace.string(), kVersion);
+			return false;
+		}
+
+		FadeEngine::Config config;
+		FadeEngine::State state;
+		std::string csv = "frame,delta,events,hidden,hud,interior,exterior,combat,notInCombat,weapon,lockedOn,enchantL,enchantR,crosshair,sneak,costNs\n";
+		std::uint64_t frame = 0;
+		std::int64_t totalNs = 0;
+		std::int64_t maxNs = 0;
+
+		while (!reader.AtEnd()) {
+			std::uint8_t tag = 0;
+			reader.Get(tag);
+
+			if (tag == kConfigTag) {
+				std::int32_t mode = 0;
+				std::uint8_t bits = 0;
+				if (!reader.Get(config.hudMax) || !reader.Get(config.hudMin) || !reader.Get(config.ctxMax) ||
+					!reader.Get(config.ctxMin) || !reader.Get(config.fadeInSpeed) || !reader.Get(config.fadeOutSpeed) ||
+					!reader.Get(mode) || !reader.Get(bits)) {
+					break;
+				}
+				config.stealthMeterMode = mode;
+				UnpackFlags(config, kConfigFlags, bits);
+				continue;
+			}
+
+			if (tag != kFrameTag) {
+				logger::warn("Trace replay: unknown record tag {} after frame {}", tag, frame);
+				break;
+			}
+
+			FadeEngine::Inputs inputs;
+			std::uint16_t bits = 0;
+			std::uint8_t events = 0;
+			if (!reader.Get(inputs.delta) || !reader.Get(inputs.detectionLevel) || !reader.Get(bits) || !reader.Get(events)) {
+				break;
+			}
+			UnpackFlags(inputs, kInputFlags, bits);
+
+			if (events & kReset) {
+				state = FadeEngine::State{};
+			}
+
+			// Mirrors HUDManager::Update: a hidden HUD applies zero alpha and snaps on its return.
+			// Early returns run no fade math; relinquished control hides the HUD like shouldHide.
+			const auto start = std::chrono::steady_clock::now();
+			bool hidden = false;
+			if (events & kDisabled) {
+				state.wasHidden = true;
+				hidden = true;
+			} else if (!(events & kSkipped)) {
+				const auto targets = FadeEngine::ComputeTargets(state, inputs, config);
+				hidden = inputs.shouldHide && inputs.delta > 0.0f;
+				if (hidden) {
+					state.wasHidden = true;
+				} else {
+					FadeEngine::Advance(state, targets, inputs, config);
+				}
+			}
+			const auto costNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+			totalNs += costNs;
+			maxNs = std::max(maxNs, costNs);
+
+			const float scale = hidden ? 0.0f : 1.0f;
+			csv += fmt::format("{},{:.6f},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{}\n",
+				frame, inputs.delta, events, hidden ? 1 : 0,
+				state.currentAlpha * scale, state.interiorAlpha * scale, state.exteriorAlpha * scale,
+				state.combatAlpha * scale, state.notInCombatAlpha * scale, state.weaponAlpha * scale,
+				state.lockedOnAlpha * scale, state.enchantAlphaL * scale, state.enchantAlphaR * scale,
+				state.ctxAlpha * scale, state.ctxSneakAlpha * scale, costNs);
+			frame++;
+		}
+
+		std::ofstream out(a_output, std::ios::binary | std::ios::trunc);
+		if (!out.is_open()) {
+			logger::warn("Trace replay: cannot write {}", a_output.string());
+			return false;
+		}
+		out.write(csv.data(), static_cast<std::streamsize>(csv.size()));
+
+		logger::info("Trace replay: {} frames -> {} (mean {:.0f} ns, max {} ns per frame)",
+			frame, a_output.string(), frame ? static_cast<double>(totalNs) / static_cast<double>(frame) : 0.0, maxNs);
+		return true;
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "FadeEngine.h"
+
+// Deterministic game-state traces for the fade engine.
+// Recording (bRecordTrace) appends one compact record per HUDManager::Update frame.
+// Replay (bReplayTrace) feeds a trace back through FadeEngine at startup and writes
+// per-channel alpha timelines plus per-frame cost as CSV, so fade changes can be diffed.
+// Builds without game headers: tests/TraceReplay replays a trace on the host, and
+// tests/TraceTests.cpp checks a recorded session against a checked-in timeline.
+namespace Trace
+{
+	// One-shot events raised between frames, attached to the next recorded frame.
+	enum Event : std::uint8_t
+	{
+		kToggleDown = 1 << 0,
+		kToggleUp = 1 << 1,
+		kMenuOpen = 1 << 2,
+		kMenuClose = 1 << 3,
+		kReset = 1 << 4,     // HUDManager::Reset: fade state was cleared before this frame
+		kSkipped = 1 << 5,   // Update returned before the fade math; state was left untouched
+		kDisabled = 1 << 6   // Control was relinquished (g_DisableiHUD, "HUD" override): HUD hidden, snap on return
+	};
+
+	void SetRecording(bool a_enabled);
+
+	[[nodiscard]] bool IsRecording();
+
+	void RecordEvent(Event a_event);
+
+	// Appends a frame. The config is only written when it differs from the last one recorded.
+	void RecordFrame(const FadeEngine::Inputs& a_inputs, const FadeEngine::Config& a_config);
+
+	// Appends a frame for an Update that returned early. a_reason is kSkipped or kDisabled.
+	void RecordEarlyReturn(float a_delta, Event a_reason);
+
+	// Flushes buffered records to disk.
+	void Flush();
+
+	// Replays a_trace through FadeEngine and writes the timeline to a_output. Returns false if the trace is unreadable.
+	bool Replay(const fs::path& a_trace, const fs::path& a_output);
+
+	// Directory of the default trace/replay files (the SKSE log directory). Set once at startup.
+	void SetDirectory(const fs::path& a_directory);
+
+	// Default locations in that directory; empty until SetDirectory was called.
+	[[nodiscard]] std::optional<fs::path> GetTracePath();
+	[[nodiscard]] std::optional<fs::path> GetReplayPath();
+}
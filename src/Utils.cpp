@@ -1,134 +1,152 @@
 #include "Compat.h"
 #include "HUDManager.h"
+#include "PatternMatcher.h"
+#include "PluginAPI.h"
 #include "Settings.h"
+#include "StringKernels.h"
 #include "Utils.h"
 
 namespace Utils
 {
+	struct BuiltinPattern
+	{
+		std::string_view pattern;
+		std::uint32_t category;
+		PatternMatcher::Anchor anchor;
+	};
+
+	static constexpr std::array kBuiltinPatterns = {
+		// Exclude Compass Navigation Overhaul compass for harmless settings conflict.
+		// QuestItemList visibility is tied to the compass already, we don't want control.
+		BuiltinPattern{ "compass.swf", kIgnoredUrl, PatternMatcher::Anchor::kAnywhere },
+		BuiltinPattern{ "questitemlist.swf", kIgnoredUrl, PatternMatcher::Anchor::kAnywhere },
+
+		// Exclude moreHUD icon swf that we don't need spamming logs/cache.
+		BuiltinPattern{ "baseicons.swf", kIgnoredUrl, PatternMatcher::Anchor::kAnywhere },
+
+		// Exclude Sneak Vignette mod to avoid issues.
+		BuiltinPattern{ "sneakvignette.swf", kIgnoredUrl, PatternMatcher::Anchor::kAnywhere },
+		BuiltinPattern{ "sneakvignettedummy.swf", kIgnoredUrl, PatternMatcher::Anchor::kAnywhere },
+
+		BuiltinPattern{ "hudmenu.swf", kVanillaHUDUrl, PatternMatcher::Anchor::kAnywhere },
+
+		// SkyUI widget sources 💁🦋
+		BuiltinPattern{ "widgets/", kSkyUIWidget, PatternMatcher::Anchor::kAnywhere },
+		BuiltinPattern{ "skyui", kSkyUIWidget, PatternMatcher::Anchor::kAnywhere }
+	};
+
 	// Blocklist to help against recursion and snagging junk/crashing.
-	static const std::unordered_set<std::string_view> kDiscoveryBlockList = {
-		"markerData",
-		"widgetLoaderContainer",
-		"aCompassMarkerList",
-		"HUDHooksContainer",
-		"HudElements"
+	// Scaleform member names are case-sensitive, so unlike URLs these are matched exactly as written.
+	static constexpr std::array kBlockedMembers = {
+		BuiltinPattern{ "markerData", kBlockedMember, PatternMatcher::Anchor::kExact },
+		BuiltinPattern{ "widgetLoaderContainer", kBlockedMember, PatternMatcher::Anchor::kExact },
+		BuiltinPattern{ "aCompassMarkerList", kBlockedMember, PatternMatcher::Anchor::kExact },
+		BuiltinPattern{ "HUDHooksContainer", kBlockedMember, PatternMatcher::Anchor::kExact },
+		BuiltinPattern{ "HudElements", kBlockedMember, PatternMatcher::Anchor::kExact },
+		// Auto-generated flash instances
+		BuiltinPattern{ "instance", kBlockedMember, PatternMatcher::Anchor::kPrefix }
 	};
 
+	// Swapped atomically on rebuild so scans on other threads keep a consistent matcher.
+	static std::atomic<std::shared_ptr<const PatternMatcher>> g_matcher;
+
 	// Registry to track SWF files known to be interactive interfaces.
 	// This allows MCMGen to prune them from the config even if the menu is closed.
 	static std::unordered_set<std::string> g_interactiveSources;
 	static std::mutex g_interactiveSourceLock;
 
-	// Hardcoded blocked swf files.
-	bool IsIgnoredUrl(std::string_view a_url)
-	{
-		// Use thread_local buffer to avoid repeated allocations
-		thread_local std::string lowerUrl;
-		lowerUrl.assign(a_url);
-		std::transform(lowerUrl.begin(), lowerUrl.end(), lowerUrl.begin(), ::tolower);
+	// ==========================================
+	// Pattern Matching
+	// ==========================================
 
-		// Exclude Compass Navigation Overhaul compass for harmless settings conflict.
-		// QuestItemList visibility is tied to the compass already, we don't want control.
-		if (lowerUrl.find("compass.swf") != std::string::npos ||
-			lowerUrl.find("questitemlist.swf") != std::string::npos ||
+	void BuildMatcher(const std::vector<std::string>& a_extraIgnoredUrls)
+	{
+		auto matcher = std::make_shared<PatternMatcher>();
 
-			// Exclude moreHUD icon swf that we don't need spamming logs/cache.
-			lowerUrl.find("baseicons.swf") != std::string::npos ||
+		for (const auto& builtin : kBuiltinPatterns) {
+			matcher->Add(builtin.pattern, builtin.category, builtin.anchor);
+		}
 
-			// Exclude Sneak Vignette mod to avoid issues.
-			lowerUrl.find("sneakvignette.swf") != std::string::npos ||
-			lowerUrl.find("sneakvignettedummy.swf") != std::string::npos) {
-			return true;
+		for (const auto& url : a_extraIgnoredUrls) {
+			if (matcher->Add(url, kIgnoredUrl)) {
+				logger::info("Ignoring user-listed SWF pattern: {}", url);
+			} else {
+				logger::warn("Rejected ignored SWF pattern (must be printable ASCII): {}", url);
+			}
 		}
 
-		return false;
+		matcher->Build();
+		g_matcher.store(std::move(matcher));
 	}
 
-	// ==========================================
-	// String & Path Helpers
-	// ==========================================
-
-	std::string SanitizeName(std::string_view a_name)
+	std::uint32_t MatchPatterns(std::string_view a_text)
 	{
-		std::string clean(a_name);
-		for (char& c : clean) {
-			if (!isalnum(static_cast<unsigned char>(c))) {
-				c = '_';
-			}
+		auto matcher = g_matcher.load();
+		if (!matcher) {
+			// Settings have not loaded yet: built-in patterns only
+			BuildMatcher({});
+			matcher = g_matcher.load();
 		}
-		return clean;
+		return matcher->Match(a_text);
 	}
 
-	std::string UrlDecode(std::string_view a_src)
+	bool IsIgnoredUrl(std::string_view a_url)
 	{
-		std::string ret;
-		ret.reserve(a_src.length());
-		unsigned int ii;
-
-		for (size_t i = 0; i < a_src.length(); i++) {
-			if (a_src[i] == '%') {
-				if (i + 2 < a_src.length()) {
-					// Need a temporary string for sscanf if using string_view source
-					char hex[3] = { a_src[i + 1], a_src[i + 2], '\0' };
-					if (sscanf_s(hex, "%x", &ii) != EOF) {
-						ret += static_cast<char>(ii);
-						i = i + 2;
-						continue;
-					}
-				}
-			}
-			ret += (a_src[i] == '+') ? ' ' : a_src[i];
-		}
-		return ret;
+		return (MatchPatterns(a_url) & kIgnoredUrl) != 0;
 	}
 
-	std::string ExtractFilename(std::string_view a_path)
+	bool IsVanillaHUDUrl(std::string_view a_url)
 	{
-		if (a_path.empty()) {
-			return "";
-		}
-
-		// Work with view first to identify bounds
-		std::string_view p = a_path;
-
-		// 1. Handle directory separators
-		// find_last_of handles both / and \ so manual replacement is not needed
-		size_t lastSlash = p.find_last_of("/\\");
-		if (lastSlash != std::string_view::npos) {
-			p = p.substr(lastSlash + 1);
-		}
+		return (MatchPatterns(a_url) & kVanillaHUDUrl) != 0;
+	}
 
-		// 2. Handle extensions
-		size_t lastDot = p.rfind('.');
-		if (lastDot != std::string_view::npos) {
-			p = p.substr(0, lastDot);
-		}
+	bool IsBlockedMemberName(std::string_view a_name)
+	{
+		static const PatternMatcher matcher = [] {
+			PatternMatcher result(false);
+			for (const auto& builtin : kBlockedMembers) {
+				result.Add(builtin.pattern, builtin.category, builtin.anchor);
+			}
+			result.Build();
+			return result;
+		}();
+		return matcher.Match(a_name) != 0;
+	}
 
-		if (p.empty()) {
-			return "";
-		}
+	bool IsSkyUIWidgetSource(std::string_view a_source)
+	{
+		return (MatchPatterns(a_source) & kSkyUIWidget) != 0;
+	}
 
-		// 3. Construct result and fix case
-		std::string result(p);
+	// ==========================================
+	// String & Path Helpers
+	// ==========================================
 
-		// Only fix purely lowercase strings.
-		bool hasUpper = std::any_of(result.begin(), result.end(), [](unsigned char c) {
-			return std::isupper(c);
-		});
+	std::string UrlDecode(std::string_view a_src)
+	{
+		std::string ret;
+		UrlDecode(a_src, ret);
+		return ret;
+	}
 
-		if (!hasUpper) {
-			result[0] = static_cast<char>(toupper(static_cast<unsigned char>(result[0])));
-		}
+	void UrlDecode(std::string_view a_src, std::string& a_out)
+	{
+		StringKernels::PercentDecode(a_src, a_out);
+	}
 
-		return result;
+	bool ContainsNoCase(std::string_view a_haystack, std::string_view a_needle)
+	{
+		return StringKernels::FindNoCase(a_haystack, a_needle) != std::string_view::npos;
 	}
 
-	std::string GetWidgetDisplayName(std::string_view a_source)
+	std::uint64_t HashString(std::string_view a_data, std::uint64_t a_seed)
 	{
-		// Extract the clean name from the Source URL (e.g., "meter.swf" -> "Meter").
-		// We rely on the fact that ScanArrayContainer and GetMenuURL ensure a_source is never empty.
-		std::string name = ExtractFilename(a_source);
-		return name;
+		std::uint64_t hash = a_seed;
+		for (char c : a_data) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
 	}
 
 	// ==========================================
@@ -153,17 +171,24 @@ namespace Utils
 
 	std::string GetMenuURL(RE::GPtr<RE::GFxMovieView> a_movie)
 	{
-		if (!a_movie) {
-			return "Unknown";
-		}
-		RE::GFxValue root;
-		if (a_movie->GetVariable(&root, "_root")) {
-			RE::GFxValue urlVal;
-			if (root.GetMember("_url", &urlVal) && urlVal.IsString()) {
-				return urlVal.GetString();
+		std::string url;
+		GetMenuURL(a_movie.get(), url);
+		return url;
+	}
+
+	void GetMenuURL(RE::GFxMovieView* a_movie, std::string& a_out)
+	{
+		if (a_movie) {
+			RE::GFxValue root;
+			if (a_movie->GetVariable(&root, "_root")) {
+				RE::GFxValue urlVal;
+				if (root.GetMember("_url", &urlVal) && urlVal.IsString()) {
+					a_out.assign(urlVal.GetString());
+					return;
+				}
 			}
 		}
-		return "Unknown";
+		a_out.assign("Unknown");
 	}
 
 	// ==========================================
@@ -274,53 +299,6 @@ namespace Utils
 		logger::info("{}: '{}'. Flags: [{}]", logPrefix, a_name, flagStr);
 	}
 
-	// ==========================================
-	// Widget Scanning Logic
-	// ==========================================
-
-	void ScanArrayContainer(const std::string& a_path, const RE::GFxValue& a_container, int& a_foundCount, bool& a_changes)
-	{
-		for (int i = 0; i < 128; i++) {
-			RE::GFxValue entry;
-			std::string indexStr = std::to_string(i);
-
-			if (!const_cast<RE::GFxValue&>(a_container).GetMember(indexStr.c_str(), &entry)) {
-				continue;
-			}
-			if (!entry.IsObject()) {
-				continue;
-			}
-
-			RE::GFxValue widget;
-			if (!entry.GetMember("widget", &widget)) {
-				if (entry.IsDisplayObject()) {
-					widget = entry;
-				} else {
-					continue;
-				}
-			}
-			if (!widget.IsDisplayObject()) {
-				continue;
-			}
-
-			std::string widgetPath = a_path + "." + indexStr;
-			std::string url = "Internal/SkyUI Widget";
-
-			RE::GFxValue urlVal;
-			if (widget.GetMember("_url", &urlVal) && urlVal.IsString()) {
-				url = urlVal.GetString();
-			}
-
-			// Always increment count for valid widgets, whether new or old
-			a_foundCount++;
-
-			if (Settings::GetSingleton()->AddDiscoveredPath(widgetPath, url)) {
-				a_changes = true;
-				logger::info("Discovered SkyUI Widget: {} [Source: {}]", widgetPath, url);
-			}
-		}
-	}
-
 	// ==========================================
 	// DebugVisitor
 	// ==========================================
@@ -337,7 +315,7 @@ namespace Utils
 		}
 		std::string name(a_name);
 
-		if (kDiscoveryBlockList.contains(name) || name.starts_with("instance")) {
+		if (IsBlockedMemberName(name)) {
 			return;
 		}
 
@@ -369,85 +347,4 @@ namespace Utils
 			});
 		}
 	}
-
-	// ==========================================
-	// ContainerDiscoveryVisitor
-	// ==========================================
-
-	ContainerDiscoveryVisitor::ContainerDiscoveryVisitor(int& a_count, bool& a_changes, std::string a_pathPrefix, int a_depth) :
-		_count(a_count),
-		_changes(a_changes),
-		_pathPrefix(std::move(a_pathPrefix)),
-		_depth(a_depth)
-	{}
-
-	void ContainerDiscoveryVisitor::Visit(const char* a_name, const RE::GFxValue& a_val)
-	{
-		if (!a_name) {
-			return;
-		}
-		std::string name(a_name);
-
-		// Use the general blocklist and ignore auto-generated flash instances
-		if (kDiscoveryBlockList.contains(name) || name.starts_with("instance")) {
-			return;
-		}
-
-		std::string currentPath = _pathPrefix + "." + name;
-
-		// Special handling for SkyUI WidgetContainer
-		if (name == "WidgetContainer") {
-			ScanArrayContainer(currentPath, a_val, _count, _changes);
-			return;
-		}
-
-		// Check if this is a discoverable widget
-		if (a_val.IsDisplayObject()) {
-			RE::GFxValue urlVal;
-			if (const_cast<RE::GFxValue&>(a_val).GetMember("_url", &urlVal) && urlVal.IsString()) {
-				std::string url = urlVal.GetString();
-
-				if (IsIgnoredUrl(url)) {
-					return;
-				}
-
-				std::string lowerUrl = url;
-				std::transform(lowerUrl.begin(), lowerUrl.end(), lowerUrl.begin(), ::tolower);
-
-				// If it's not the vanilla HUD, add it to settings.
-				bool isVanilla = (lowerUrl.find("hudmenu.swf") != std::string::npos);
-
-				if (!isVanilla) {
-					// Always increment found count for population check
-					_count++;
-					if (Settings::GetSingleton()->AddDiscoveredPath(currentPath, url)) {
-						_changes = true;
-						logger::info("Discovered External Element: {} [Source: {}]", currentPath, url);
-					}
-					// Don't recurse into discovered external widgets
-					return;
-				}
-
-				// If we are here, it is a Vanilla object.
-				if (name != "HUDMovieBaseInstance") {
-					return;
-				}
-
-				// INPA SEKIRO FIX: Inpa Sekiro Combat heavily modifies HUDMovieBaseInstance.
-				// Calling VisitMembers on it causes a crash. We skip deep scanning it.
-				// Direct path access (GetVariable) for hardcoded elements still works fine.
-				if (Compat::GetSingleton()->IsInpaSekiroCombatLoaded()) {
-					return;
-				}
-			}
-		}
-
-		// Recurse into DisplayObjects and Arrays only (not generic Objects)
-		if (_depth > 0 && (a_val.IsDisplayObject() || a_val.IsArray())) {
-			ContainerDiscoveryVisitor subVisitor(_count, _changes, currentPath, _depth - 1);
-			a_val.VisitMembers([&subVisitor](const char* name, const RE::GFxValue& val) {
-				subVisitor.Visit(name, val);
-			});
-		}
-	}
 }
@@ -1,21 +1,49 @@
 #pragma once
 
+#include "StringKernels.h"
+
 namespace Utils
 {
+	// Categories reported by the pattern matchers.
+	enum MatchCategory : std::uint32_t
+	{
+		kIgnoredUrl = 1 << 0,     // SWFs we never manage (built-in list plus sIgnoredUrls)
+		kVanillaHUDUrl = 1 << 1,  // The vanilla hudmenu.swf
+		kBlockedMember = 1 << 2,  // Scaleform members skipped during discovery (IsBlockedMemberName only)
+		kSkyUIWidget = 1 << 3     // Sources loaded into SkyUI's WidgetContainer
+	};
+
+	// Compiles the built-in patterns plus user-supplied ignored URL fragments into the shared matcher.
+	void BuildMatcher(const std::vector<std::string>& a_extraIgnoredUrls);
+
+	// Evaluates every URL pattern in one case-insensitive pass and returns the matched MatchCategory bits.
+	std::uint32_t MatchPatterns(std::string_view a_text);
+
 	// Checks if a swf file is on the blocklist
 	bool IsIgnoredUrl(std::string_view a_url);
 
-	// Converts "_root.WidgetContainer.10" -> "_root_WidgetContainer_10".
-	std::string SanitizeName(std::string_view a_name);
+	bool IsVanillaHUDUrl(std::string_view a_url);
+
+	// Checks discovery member names against the blocklist and auto-generated "instanceN" names.
+	// Case-sensitive, like the Scaleform names themselves.
+	bool IsBlockedMemberName(std::string_view a_name);
+
+	// Heuristic: the source is a SkyUI widget (late-loading, lives in WidgetContainer).
+	bool IsSkyUIWidgetSource(std::string_view a_source);
 
 	// Decodes URL encoded strings (e.g. "%20" -> " ").
 	std::string UrlDecode(std::string_view a_src);
 
-	// Extract "meter" from "Interface/skyui/meter.swf".
-	std::string ExtractFilename(std::string_view a_path);
+	// Decodes into a caller-owned buffer so per-frame callers can reuse its capacity.
+	void UrlDecode(std::string_view a_src, std::string& a_out);
+
+	// Case-insensitive substring search. a_needle must already be lowercase.
+	bool ContainsNoCase(std::string_view a_haystack, std::string_view a_needle);
+
+	using StringKernels::TransparentStringHash;
 
-	// Central logic to determine the human-readable name for the MCM.
-	std::string GetWidgetDisplayName(std::string_view a_source);
+	// FNV-1a hash, chainable through a_seed. Used for cache fingerprints.
+	std::uint64_t HashString(std::string_view a_data, std::uint64_t a_seed = 0xCBF29CE484222325ull);
 
 	// Checks if a menu name corresponds to a vanilla System Menu (Map, Inventory, etc.)
 	bool IsSystemMenu(std::string_view a_menuName);
@@ -23,6 +51,9 @@ namespace Utils
 	// Helper to safely extract the _url member from a MovieView
 	std::string GetMenuURL(RE::GPtr<RE::GFxMovieView> a_movie);
 
+	// Writes into a caller-owned buffer so scans can reuse its capacity.
+	void GetMenuURL(RE::GFxMovieView* a_movie, std::string& a_out);
+
 	// Checks menu flags to determine if it is an interactive interface (e.g. Loot Menu, Explorer)
 	// rather than a passive HUD element.
 	bool IsInteractiveMenu(RE::IMenu* a_menu);
@@ -38,9 +69,6 @@ namespace Utils
 	void RegisterInteractiveSource(const std::string& a_source);
 	bool IsSourceInteractive(const std::string& a_source);
 
-	// Shared logic for scanning SkyUI Widget Containers.
-	void ScanArrayContainer(const std::string& a_path, const RE::GFxValue& a_container, int& a_foundCount, bool& a_changes);
-
 	// Dumps the structure of a GFxObject to the log.
 	class DebugVisitor : public RE::GFxValue::ObjectVisitor
 	{
@@ -52,19 +80,4 @@ namespace Utils
 		std::string _prefix;
 		int _depth;
 	};
-
-	// Scans a GFxObject for DisplayObjects (widgets) and registers them with Settings.
-	class ContainerDiscoveryVisitor : public RE::GFxValue::ObjectVisitor
-	{
-	public:
-		// Depth default set to 2 to allow entry into HUDMovieBaseInstance -> Children
-		ContainerDiscoveryVisitor(int& a_count, bool& a_changes, std::string a_pathPrefix, int a_depth = 2);
-		void Visit(const char* a_name, const RE::GFxValue& a_val) override;
-
-	private:
-		int& _count;
-		bool& _changes;
-		std::string _pathPrefix;
-		int _depth;
-	};
 }
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "GFxOps.h"
+
+// Widget discovery behind HUDManager::ScanForWidgets: external menu roots, SkyUI's WidgetContainer slots and,
+// on deep scans, the display objects below the HUD's _root. Written against the GFxOps Value/Movie concepts
+// like HUDApply, so the host tests run the same code over generated movie trees (tests/DiscoveryScene.h).
+// Settings, the plugin API and the URL patterns are reached through a Sink.
+namespace WidgetDiscovery
+{
+	enum class UrlKind : std::uint8_t
+	{
+		kIgnored,     // Blocklisted SWF (Utils::kIgnoredUrl)
+		kVanillaHUD,  // hudmenu.swf itself
+		kExternal
+	};
+
+	template <class S>
+	concept Sink = requires(S& a_sink, std::string_view a_text) {
+		{ a_sink.IsBlockedMember(a_text) } -> std::convertible_to<bool>;
+		{ a_sink.ClassifyUrl(a_text) } -> std::same_as<UrlKind>;
+		{ a_sink.IsRegisteredClip(a_text) } -> std::convertible_to<bool>;
+		{ a_sink.BindMovie(a_text, a_text) } -> std::convertible_to<bool>;          // Menu taken by a plugin API registration
+		{ a_sink.AddDiscoveredPath(a_text, a_text) } -> std::convertible_to<bool>;  // New path or changed source
+		{ a_sink.ScansHUDBase() } -> std::convertible_to<bool>;                     // False while Inpa Sekiro Combat is loaded
+	};
+
+	// Totals of one scan.
+	struct Result
+	{
+		int found = 0;         // Valid widgets and elements, new or known
+		bool changes = false;  // A path was added or its source changed
+	};
+
+	// Member names "0".."127", built once instead of formatting them on every scan.
+	inline constexpr std::size_t kMaxContainerSlots = 128;
+
+	inline const std::array<std::string, kMaxContainerSlots>& GetSlotNames()
+	{
+		static const auto names = []() {
+			std::array<std::string, kMaxContainerSlots> result;
+			for (std::size_t i = 0; i < kMaxContainerSlots; i++) {
+				result[i] = std::to_string(i);
+			}
+			return result;
+		}();
+		return names;
+	}
+
+	// Paths are built in one buffer owned by the caller: every helper appends its member name and
+	// truncates back before returning, so a scan allocates only while the buffer grows to its deepest path.
+	class PathScope
+	{
+	public:
+		PathScope(std::string& a_path, std::string_view a_member) :
+			_path(a_path),
+			_size(a_path.size())
+		{
+			_path.append(1, '.').append(a_member);
+		}
+		~PathScope() { _path.resize(_size); }
+
+		PathScope(const PathScope&) = delete;
+		PathScope& operator=(const PathScope&) = delete;
+
+	private:
+		std::string& _path;
+		std::size_t _size;
+	};
+
+	// Shared logic for scanning SkyUI Widget Containers. a_path holds the container's path.
+	template <GFxOps::Value V, Sink S>
+	void ScanArrayContainer(std::string& a_path, const V& a_container, S& a_sink, Result& a_result)
+	{
+		for (const auto& indexStr : GetSlotNames()) {
+			V entry;
+			if (!GFxOps::GetMember(a_container, indexStr.c_str(), &entry)) {
+				continue;
+			}
+			if (!entry.IsObject()) {
+				continue;
+			}
+
+			V widget;
+			if (!GFxOps::GetMember(entry, "widget", &widget)) {
+				if (entry.IsDisplayObject()) {
+					widget = entry;
+				} else {
+					continue;
+				}
+			}
+			if (!widget.IsDisplayObject()) {
+				continue;
+			}
+
+			const PathScope widgetPath(a_path, indexStr);
+			if (a_sink.IsRegisteredClip(a_path)) {
+				continue;
+			}
+
+			std::string_view url = "Internal/SkyUI Widget";
+			V urlVal;
+			if (GFxOps::GetMember(widget, "_url", &urlVal) && urlVal.IsString()) {
+				url = urlVal.GetString();
+			}
+
+			// Always increment count for valid widgets, whether new or old
+			a_result.found++;
+
+			if (a_sink.AddDiscoveredPath(a_path, url)) {
+				a_result.changes = true;
+				logger::info("Discovered SkyUI Widget: {} [Source: {}]", a_path, url);
+			}
+		}
+	}
+
+	// One member of a deep scan. a_path holds the path of the object a_name belongs to.
+	template <GFxOps::Value V, Sink S>
+	void VisitMember(std::string& a_path, const char* a_name, const V& a_val, int a_depth, S& a_sink, Result& a_result)
+	{
+		if (!a_name) {
+			return;
+		}
+		std::string_view name(a_name);
+
+		// Use the general blocklist and ignore auto-generated flash instances
+		if (a_sink.IsBlockedMember(name)) {
+			return;
+		}
+
+		// Only display objects and arrays can be registered or recursed into
+		if (!a_val.IsDisplayObject() && !a_val.IsArray()) {
+			return;
+		}
+
+		const PathScope currentPath(a_path, name);
+
+		// Special handling for SkyUI WidgetContainer
+		if (name == "WidgetContainer") {
+			ScanArrayContainer(a_path, a_val, a_sink, a_result);
+			return;
+		}
+
+		// Registered through the plugin API: pushed to by HUDManager, never discovered
+		if (a_sink.IsRegisteredClip(a_path)) {
+			return;
+		}
+
+		// Check if this is a discoverable widget
+		if (a_val.IsDisplayObject()) {
+			V urlVal;
+			if (GFxOps::GetMember(a_val, "_url", &urlVal) && urlVal.IsString()) {
+				const std::string_view url(urlVal.GetString());
+
+				// One pass over the URL covers both the blocklist and the vanilla HUD check
+				const auto kind = a_sink.ClassifyUrl(url);
+				if (kind == UrlKind::kIgnored) {
+					return;
+				}
+
+				// If it's not the vanilla HUD, add it to settings.
+				if (kind == UrlKind::kExternal) {
+					// Always increment found count for population check
+					a_result.found++;
+					if (a_sink.AddDiscoveredPath(a_path, url)) {
+						a_result.changes = true;
+						logger::info("Discovered External Element: {} [Source: {}]", a_path, url);
+					}
+					// Don't recurse into discovered external widgets
+					return;
+				}
+
+				// If we are here, it is a Vanilla object.
+				if (name != "HUDMovieBaseInstance") {
+					return;
+				}
+
+				// INPA SEKIRO FIX: Inpa Sekiro Combat heavily modifies HUDMovieBaseInstance.
+				// Calling VisitMembers on it causes a crash. We skip deep scanning it.
+				// Direct path access (GetVariable) for hardcoded elements still works fine.
+				if (!a_sink.ScansHUDBase()) {
+					return;
+				}
+			}
+		}
+
+		// Recurse into DisplayObjects and Arrays only (not generic Objects)
+		if (a_depth > 0) {
+			GFxOps::VisitMembers(a_val, [&](const char* a_member, const V& a_child) {
+				VisitMember(a_path, a_member, a_child, a_depth - 1, a_sink, a_result);
+			});
+		}
+	}
+
+	// Deep scan of a movie's _root. Depth 2 allows entry into HUDMovieBaseInstance -> Children.
+	template <class M, GFxOps::Value V, Sink S>
+	void ScanForContainers(M* a_movie, std::string& a_path, S& a_sink, Result& a_result, int a_depth = 2)
+	{
+		static_assert(GFxOps::Movie<M, V>);
+
+		V root;
+		if (!a_movie || !GFxOps::GetVariable(a_movie, &root, "_root")) {
+			return;
+		}
+		a_path.assign("_root");
+		GFxOps::VisitMembers(root, [&](const char* a_member, const V& a_child) {
+			VisitMember(a_path, a_member, a_child, a_depth, a_sink, a_result);
+		});
+	}
+
+	// External menu a_name: reads its _root _url into a_url and registers it unless the plugin API binds it.
+	// Returns true if the menu is new or its source changed.
+	template <class M, GFxOps::Value V, Sink S>
+	bool ScanMenu(std::string_view a_name, M* a_movie, std::string& a_url, S& a_sink)
+	{
+		static_assert(GFxOps::Movie<M, V>);
+
+		V root;
+		V urlVal;
+		if (a_movie && GFxOps::GetVariable(a_movie, &root, "_root") && GFxOps::GetMember(root, "_url", &urlVal) && urlVal.IsString()) {
+			a_url.assign(urlVal.GetString());
+		} else {
+			a_url.assign("Unknown");
+		}
+
+		if (a_sink.BindMovie(a_name, a_url)) {
+			return false;
+		}
+		return a_sink.AddDiscoveredPath(a_name, a_url);
+	}
+}
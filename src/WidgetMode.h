@@ -0,0 +1,20 @@
+#pragma once
+
+// Display modes of HUD elements and widgets, as stored in settings.ini and listed by the MCM.
+// Outside Settings.h so the fade math builds without game headers; Settings re-exports them.
+namespace WidgetModes
+{
+	enum WidgetMode
+	{
+		kVisible = 0,
+		kImmersive = 1,
+		kHidden = 2,
+		kIgnored = 3,
+		kInterior = 4,
+		kExterior = 5,
+		kInCombat = 6,
+		kNotInCombat = 7,
+		kWeaponDrawn = 8,
+		kLockedOn = 9
+	};
+}
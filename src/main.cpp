@@ -2,7 +2,22 @@
 #include "HUDManager.h"
 #include "MCMGen.h"
 #include "PCH.h"
+#include "Papyrus.h"
+#include "PluginAPI.h"
+#include "ScriptOverrides.h"
 #include "Settings.h"
+#include "Trace.h"
+
+namespace
+{
+	// File parsing that needs no game data runs here between kPostLoad and kDataLoaded.
+	std::future<void> g_startupPreload;
+
+	double ElapsedMs(std::chrono::steady_clock::time_point a_start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_start).count();
+	}
+}
 
 void OnInit(SKSE::MessagingInterface::Message* a_msg)
 {
@@ -32,10 +47,18 @@ void OnInit(SKSE::MessagingInterface::Message* a_msg)
 			logger::info("Obtained BTPS API");
 		}
 
-		compat->g_DetectionMeter = LoadLibraryA("Data/SKSE/Plugins/MaxsuDetectionMeter.dll");
-		if (compat->g_DetectionMeter) {
-			logger::info("Obtained Detection Meter DLL");
+		// Detection Meter predates the plugin API: claim the detection display on its behalf
+		if (GetModuleHandleA("MaxsuDetectionMeter.dll")) {
+			PluginAPI::GetSingleton()->ClaimElement(ImmersiveHUDAPI::CompatOwner, ImmersiveHUDAPI::DetectionElementId);
+			logger::info("Detection Meter found. Detection display claimed on its behalf.");
 		}
+
+		g_startupPreload = std::async(std::launch::async, []() {
+			const auto start = std::chrono::steady_clock::now();
+			Settings::GetSingleton()->Load();
+			Compat::GetSingleton()->LoadSkyHUDConfig();
+			logger::info("Startup: settings and cache preloaded in {:.2f} ms (background)", ElapsedMs(start));
+		});
 		break;
 
 	case SKSE::MessagingInterface::kPostPostLoad:
@@ -44,9 +67,36 @@ void OnInit(SKSE::MessagingInterface::Message* a_msg)
 		}
 		break;
 
+	case SKSE::MessagingInterface::kPreLoadGame:
+	case SKSE::MessagingInterface::kNewGame:
+		// Script overrides are not saved; scripts apply them again on load
+		ScriptOverrides::GetSingleton()->Clear();
+		break;
+
 	case SKSE::MessagingInterface::kDataLoaded:
-		HUDManager::GetSingleton()->InstallHooks();
-		compat->InitExternalData();
+		{
+			const auto start = std::chrono::steady_clock::now();
+			if (g_startupPreload.valid()) {
+				g_startupPreload.get();
+			} else {
+				Settings::GetSingleton()->Load();
+				compat->LoadSkyHUDConfig();
+			}
+			const double waitMs = ElapsedMs(start);
+
+			// Replay the previous session's trace before hooks install: recording truncates it on the first frame.
+			if (Settings::GetSingleton()->IsReplayTraceEnabled()) {
+				const auto tracePath = Trace::GetTracePath();
+				const auto replayPath = Trace::GetReplayPath();
+				if (tracePath && replayPath) {
+					Trace::Replay(*tracePath, *replayPath);
+				}
+			}
+
+			HUDManager::GetSingleton()->InstallHooks();
+			compat->InitExternalData();
+			logger::info("Startup: kDataLoaded handled in {:.2f} ms (preload wait {:.2f} ms)", ElapsedMs(start), waitMs);
+		}
 		break;
 
 	}
@@ -92,6 +142,7 @@ void InitializeLog()
 		stl::report_and_fail("Failed to find standard logging directory"sv);
 	}
 
+	Trace::SetDirectory(*path);
 	*path /= fmt::format(FMT_STRING("{}.log"), Version::PROJECT);
 	auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
 
@@ -118,5 +169,14 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 		return false;
 	}
 
+	// Interface requests from other plugins (API/ImmersiveHUDAPI.h)
+	if (!messaging->RegisterListener(nullptr, PluginAPI::HandleMessage)) {
+		logger::warn("Failed to register the plugin API listener");
+	}
+
+	if (!SKSE::GetPapyrusInterface()->Register(Papyrus::Register)) {
+		logger::warn("Failed to register Papyrus natives");
+	}
+
 	return true;
 }
@@ -0,0 +1,53 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local bool t_counting = false;
+	thread_local std::size_t t_allocations = 0;
+
+	void* Allocate(std::size_t a_size, std::size_t a_alignment)
+	{
+		if (t_counting) {
+			t_allocations++;
+		}
+		a_size = a_size ? a_size : 1;
+		void* ptr = a_alignment > alignof(std::max_align_t) ?
+		                std::aligned_alloc(a_alignment, (a_size + a_alignment - 1) / a_alignment * a_alignment) :
+		                std::malloc(a_size);
+		if (!ptr) {
+			throw std::bad_alloc();
+		}
+		return ptr;
+	}
+}
+
+namespace AllocationCounter
+{
+	void Begin()
+	{
+		t_allocations = 0;
+		t_counting = true;
+	}
+
+	std::size_t End()
+	{
+		t_counting = false;
+		return t_allocations;
+	}
+}
+
+void* operator new(std::size_t a_size) { return Allocate(a_size, 0); }
+void* operator new[](std::size_t a_size) { return Allocate(a_size, 0); }
+void* operator new(std::size_t a_size, std::align_val_t a_alignment) { return Allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new[](std::size_t a_size, std::align_val_t a_alignment) { return Allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+void operator delete(void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t, std::align_val_t) noexcept { std::free(a_ptr); }
@@ -0,0 +1,34 @@
+#pragma once
+
+// Counts heap allocations made by the current thread while a Scope is open. Linking AllocationCounter.cpp
+// replaces the global operator new/delete of the executable, so only tests and benchmarks that need it do.
+namespace AllocationCounter
+{
+	void Begin();
+	std::size_t End();
+
+	class Scope
+	{
+	public:
+		Scope() { Begin(); }
+		~Scope()
+		{
+			if (!_ended) {
+				End();
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		// Allocations since construction; stops counting.
+		std::size_t Count()
+		{
+			_ended = true;
+			return End();
+		}
+
+	private:
+		bool _ended = false;
+	};
+}
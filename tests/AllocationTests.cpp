@@ -0,0 +1,103 @@
+#include "AllocationCounter.h"
+#include "DiscoveryScene.h"
+#include "HUDScene.h"
+
+#include <gtest/gtest.h>
+
+// The apply path (HUDApply) makes no heap allocation per frame once its caches are warm, and a discovery
+// rescan (WidgetDiscovery) none once its path buffer has grown. Own binary: see AllocationCounter.h.
+namespace
+{
+	constexpr int kCycle = 600;  // HUDScene::Session frames per scripted cycle
+}
+
+TEST(HUDApplyAllocation, CounterSeesAllocations)
+{
+	AllocationCounter::Scope counting;
+	auto value = std::make_unique<int>(1);
+	std::vector<int> values(16);
+	EXPECT_EQ(counting.Count(), 2u);
+}
+
+TEST(HUDApplyAllocation, SessionReplayDoesNotAllocate)
+{
+	Mock::Movie hud;
+	HUDScene::Host host;
+	HUDScene::BuildHUD(hud, host, 64);
+	const auto menus = HUDScene::BuildMenus(8);
+
+	HUDScene::Applier applier;
+	HUDScene::Session session;
+	auto runFrame = [&]() {
+		applier.BeginFrame(session.Step());
+		applier.ApplyHUD(&hud, host);
+		for (const auto& menu : menus) {
+			applier.ApplyMenu(&menu->movie, menu->name, menu->mode);
+		}
+	};
+
+	// One full cycle fills the caches: every fade, coalescing change and menu cull happens once
+	for (int i = 0; i < kCycle; i++) {
+		runFrame();
+	}
+
+	for (int cycle = 0; cycle < 2; cycle++) {
+		AllocationCounter::Scope counting;
+		for (int i = 0; i < kCycle; i++) {
+			runFrame();
+		}
+		EXPECT_EQ(counting.Count(), 0u) << "cycle " << cycle;
+	}
+}
+
+TEST(HUDApplyAllocation, RestAfterLayoutChangeDoesNotAllocate)
+{
+	Mock::Movie hud;
+	HUDScene::Host host;
+	HUDScene::BuildHUD(hud, host, 16);
+
+	HUDScene::Applier applier;
+	HUDScene::Session session;
+	HUDApply::Frame frame;
+	for (int i = 0; i < 190; i++) {
+		frame = session.Step();
+		applier.BeginFrame(frame);
+		applier.ApplyHUD(&hud, host);
+	}
+
+	// A clip added under a hammered bar is picked up by the next layout check, then the HUD is at rest again
+	Mock::Value health;
+	ASSERT_TRUE(hud.GetVariable(&health, "_root.HUDMovieBaseInstance.Health"));
+	health.GetNode()->Add("SurvivalPenalty");
+	for (int i = 0; i < 121; i++) {
+		frame.timer += 1.0f / 60.0f;
+		applier.BeginFrame(frame);
+		applier.ApplyHUD(&hud, host);
+	}
+
+	AllocationCounter::Scope counting;
+	for (int i = 0; i < 240; i++) {
+		frame.timer += 1.0f / 60.0f;
+		applier.BeginFrame(frame);
+		applier.ApplyHUD(&hud, host);
+	}
+	EXPECT_EQ(counting.Count(), 0u);
+}
+
+TEST(DiscoveryAllocation, RescanDoesNotAllocate)
+{
+	const DiscoveryScene::Shape shape{ .width = 8, .depth = 3, .widgets = 64, .externals = 8, .menus = 8 };
+	auto scene = DiscoveryScene::Build(shape);
+	DiscoveryScene::Sink sink;
+	std::string path;
+	std::string url;
+	DiscoveryScene::Scan(*scene, sink, path, url);
+	ASSERT_EQ(sink.sources.size(), DiscoveryScene::ExpectedPaths(shape));
+
+	for (int scan = 0; scan < 2; scan++) {
+		AllocationCounter::Scope counting;
+		const auto result = DiscoveryScene::Scan(*scene, sink, path, url);
+		EXPECT_EQ(counting.Count(), 0u) << "scan " << scan;
+		EXPECT_FALSE(result.changes);
+	}
+}
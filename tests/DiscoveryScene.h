@@ -0,0 +1,156 @@
+#pragma once
+
+#include "MockScaleform.h"
+#include "StringKernels.h"
+#include "WidgetDiscovery.h"
+
+// Generated movie trees for WidgetDiscovery, shared by WidgetDiscoveryTests and WidgetDiscoveryBench.
+namespace DiscoveryScene
+{
+	// Tree shape. Each generic container below _root holds width children per level, depth levels deep.
+	struct Shape
+	{
+		std::size_t width = 8;      // Children per generic container level, and containers below _root
+		std::size_t depth = 2;      // Levels below each container (discovery stops kScanLevels below _root)
+		std::size_t widgets = 16;   // Occupied WidgetContainer slots, at most WidgetDiscovery::kMaxContainerSlots
+		std::size_t externals = 4;  // External SWF clips below _root
+		std::size_t menus = 4;      // External menu movies
+	};
+
+	// WidgetDiscovery::Sink over plain containers. Lookups take string_views; only new paths allocate.
+	struct Sink
+	{
+		bool IsBlockedMember(std::string_view a_name) const { return a_name.starts_with("instance"); }
+
+		WidgetDiscovery::UrlKind ClassifyUrl(std::string_view a_url) const
+		{
+			if (a_url.find("ignored") != std::string_view::npos) {
+				return WidgetDiscovery::UrlKind::kIgnored;
+			}
+			return a_url.ends_with("hudmenu.swf") ? WidgetDiscovery::UrlKind::kVanillaHUD : WidgetDiscovery::UrlKind::kExternal;
+		}
+
+		bool IsRegisteredClip(std::string_view a_path) const { return registered.contains(a_path); }
+		bool BindMovie(std::string_view, std::string_view) const { return false; }
+
+		bool AddDiscoveredPath(std::string_view a_path, std::string_view a_source)
+		{
+			adds++;
+			const auto it = sources.find(a_path);
+			if (it == sources.end()) {
+				sources.emplace(a_path, a_source);
+				return true;
+			}
+			if (it->second != a_source) {
+				it->second.assign(a_source);
+				return true;
+			}
+			return false;
+		}
+
+		bool ScansHUDBase() const { return true; }
+
+		using PathSet = std::unordered_set<std::string, StringKernels::TransparentStringHash, std::equal_to<>>;
+		using PathMap = std::unordered_map<std::string, std::string, StringKernels::TransparentStringHash, std::equal_to<>>;
+
+		PathSet registered;
+		PathMap sources;      // Discovered path -> source
+		std::size_t adds = 0;  // AddDiscoveredPath calls
+	};
+
+	struct Menu
+	{
+		std::string name;
+		Mock::Movie movie;
+	};
+
+	struct Scene
+	{
+		Mock::Movie hud;
+		std::vector<std::unique_ptr<Menu>> menus;
+		std::size_t visitable = 0;  // Display objects within kScanLevels of _root
+	};
+
+	// Levels below _root a deep scan visits (WidgetDiscovery::ScanForContainers at its default depth).
+	inline constexpr std::size_t kScanLevels = 3;
+
+	// a_levels levels of a_width generic clips below a_node, which sits a_level levels below _root.
+	inline void AddLevels(Mock::Node& a_node, std::size_t a_level, std::size_t a_width, std::size_t a_levels, std::size_t& a_visitable)
+	{
+		if (a_levels == 0) {
+			return;
+		}
+		for (std::size_t i = 0; i < a_width; i++) {
+			auto& child = a_node.Add("clip" + std::to_string(i));
+			if (a_level < kScanLevels) {
+				a_visitable++;
+			}
+			AddLevels(child, a_level + 1, a_width, a_levels - 1, a_visitable);
+		}
+	}
+
+	inline std::unique_ptr<Scene> Build(const Shape& a_shape)
+	{
+		auto scene = std::make_unique<Scene>();
+		auto& root = scene->hud.Root();
+
+		// Vanilla HUD: recursed into, like HUDMovieBaseInstance in game
+		auto& base = root.Add("HUDMovieBaseInstance");
+		base.url = "Interface/hudmenu.swf";
+		scene->visitable++;
+		AddLevels(base, 1, a_shape.width, a_shape.depth, scene->visitable);
+
+		// Plain containers and auto-generated instances
+		for (std::size_t i = 0; i < a_shape.width; i++) {
+			auto& holder = root.Add("Holder" + std::to_string(i));
+			scene->visitable++;
+			AddLevels(holder, 1, a_shape.width, a_shape.depth, scene->visitable);
+			root.Add("instance" + std::to_string(i)).Add("clip");
+		}
+
+		// External SWFs: discovered, never recursed into
+		for (std::size_t i = 0; i < a_shape.externals; i++) {
+			auto& external = root.Add("External" + std::to_string(i));
+			external.url = "mods/external" + std::to_string(i) + ".swf";
+			external.Add("content");
+			scene->visitable++;
+		}
+		root.Add("Blocklisted").url = "mods/ignored.swf";
+		scene->visitable++;
+
+		// SkyUI WidgetContainer, slots filled from 0
+		auto& container = root.Add("WidgetContainer");
+		scene->visitable++;
+		for (std::size_t i = 0; i < std::min(a_shape.widgets, WidgetDiscovery::kMaxContainerSlots); i++) {
+			auto& widget = container.Add(std::to_string(i)).Add("widget");
+			widget.url = "widgets/widget" + std::to_string(i) + ".swf";
+		}
+
+		for (std::size_t i = 0; i < a_shape.menus; i++) {
+			auto menu = std::make_unique<Menu>();
+			menu->name = "ExternalMenu" + std::to_string(i);
+			menu->movie.Root().url = "menus/menu" + std::to_string(i) + ".swf";
+			scene->menus.push_back(std::move(menu));
+		}
+		return scene;
+	}
+
+	// Paths a full scan of a_shape discovers: widgets, external clips and menus.
+	inline std::size_t ExpectedPaths(const Shape& a_shape)
+	{
+		return std::min(a_shape.widgets, WidgetDiscovery::kMaxContainerSlots) + a_shape.externals + a_shape.menus;
+	}
+
+	// One ScanForWidgets pass: every external menu, then a deep scan of the HUD. a_path and a_url are reused.
+	inline WidgetDiscovery::Result Scan(Scene& a_scene, Sink& a_sink, std::string& a_path, std::string& a_url)
+	{
+		WidgetDiscovery::Result result;
+		for (const auto& menu : a_scene.menus) {
+			if (WidgetDiscovery::ScanMenu<Mock::Movie, Mock::Value>(menu->name, &menu->movie, a_url, a_sink)) {
+				result.changes = true;
+			}
+		}
+		WidgetDiscovery::ScanForContainers<Mock::Movie, Mock::Value>(&a_scene.hud, a_path, a_sink, result);
+		return result;
+	}
+}
@@ -0,0 +1,99 @@
+#include "FadeEngine.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+// Quantized fades (fAlphaStep) driven through FadeEngine the way HUDManager applies them.
+namespace
+{
+	constexpr double kSteps[] = { 0.5, 1.0, 2.5, 5.0, 10.0 };
+
+	struct FadeRun
+	{
+		std::vector<double> written;  // Quantized value per frame
+		float end = 0.0f;
+	};
+
+	// Fades the interior channel from one target to the other and records the quantized output.
+	FadeRun RunFade(const FadeEngine::Config& a_config, double a_step, bool a_fadeIn, std::mt19937& a_rng)
+	{
+		FadeEngine::State state;
+		FadeEngine::Inputs inputs;
+		inputs.isInterior = !a_fadeIn;
+
+		// Settle on the start target (the first frame snaps out of wasHidden)
+		FadeEngine::Advance(state, FadeEngine::ComputeTargets(state, inputs, a_config), inputs, a_config);
+
+		inputs.isInterior = a_fadeIn;
+		FadeRun run;
+		std::uniform_real_distribution<float> frameTime(1.0f / 240.0f, 1.0f / 20.0f);
+		for (int frame = 0; frame < 10000; frame++) {
+			inputs.delta = frameTime(a_rng);
+			const auto targets = FadeEngine::ComputeTargets(state, inputs, a_config);
+			FadeEngine::Advance(state, targets, inputs, a_config);
+			run.end = targets.interior;
+			run.written.push_back(FadeEngine::QuantizeAlpha(state.interiorAlpha, a_step, targets.interior));
+			if (state.interiorAlpha == targets.interior) {
+				break;
+			}
+		}
+		return run;
+	}
+}
+
+TEST(FadeEngine, QuantizedFadesReachExactEndpoints)
+{
+	std::mt19937 rng(46);
+	std::uniform_real_distribution<float> opacity(0.0f, 100.0f);
+	std::uniform_real_distribution<float> speed(0.25f, 20.0f);
+
+	for (int i = 0; i < 2000; i++) {
+		FadeEngine::Config config;
+		config.hudMin = opacity(rng);
+		config.hudMax = opacity(rng);
+		config.fadeInSpeed = speed(rng);
+		config.fadeOutSpeed = speed(rng);
+		if (i % 10 == 0) {
+			config.hudMin = 0.0f;
+		}
+
+		for (const double step : kSteps) {
+			for (const bool fadeIn : { true, false }) {
+				const auto run = RunFade(config, step, fadeIn, rng);
+				SCOPED_TRACE(::testing::Message() << "min " << config.hudMin << " max " << config.hudMax << " step " << step);
+
+				ASSERT_FALSE(run.written.empty());
+				// The last write is the target itself, bit for bit
+				ASSERT_EQ(run.written.back(), static_cast<double>(run.end));
+
+				// Moving towards the target, never past it
+				const bool rising = run.written.front() <= run.end;
+				for (std::size_t f = 0; f < run.written.size(); f++) {
+					if (rising) {
+						ASSERT_LE(run.written[f], run.end);
+						ASSERT_TRUE(f == 0 || run.written[f] >= run.written[f - 1]);
+					} else {
+						ASSERT_GE(run.written[f], run.end);
+						ASSERT_TRUE(f == 0 || run.written[f] <= run.written[f - 1]);
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST(FadeEngine, QuantizeAlphaPassThrough)
+{
+	// Disabled step and zero alpha pass through; values at the end target are written as the target
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(37.3, 0.0, 80.0), 37.3);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(0.0, 5.0, 80.0), 0.0);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(79.995, 5.0, 80.0), 80.0);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(42.7, 5.0, 42.7), 42.7);
+
+	// Mid-fade values snap to the step but not past the end target
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(37.3, 5.0, 80.0), 35.0);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(41.0, 5.0, 42.7), 40.0);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(42.2, 5.0, 42.0), 42.0);
+	EXPECT_EQ(FadeEngine::QuantizeAlpha(40.1, 5.0, 42.7), 40.0);
+}
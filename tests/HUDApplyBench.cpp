@@ -0,0 +1,101 @@
+#include "HUDScene.h"
+
+#include <cstdio>
+
+// Runs the real apply path (HUDApply) over a mock vanilla-plus-SkyHUD HUD with N SkyUI widgets and M external menus.
+// Reports wall time and the Scaleform calls GFxOps counted per frame, for a scripted session (fading) and for a
+// frame held at rest (steady). Not part of ctest: run HUDApplyBench from a Release build.
+namespace
+{
+	constexpr int kWarmupFrames = 600;
+	constexpr int kFrames = 6000;
+
+	struct Result
+	{
+		double nsPerFrame = 0.0;
+		double callsPerFrame = 0.0;
+		double alphaWritesPerFrame = 0.0;
+	};
+
+	template <class F>
+	Result Measure(std::size_t a_widgets, std::size_t a_menus, F&& a_nextFrame)
+	{
+		Mock::Movie hud;
+		HUDScene::Host host;
+		HUDScene::BuildHUD(hud, host, a_widgets);
+		const auto menus = HUDScene::BuildMenus(a_menus);
+
+		HUDScene::Applier applier;
+		auto runFrame = [&]() {
+			applier.BeginFrame(a_nextFrame());
+			applier.ApplyHUD(&hud, host);
+			for (const auto& menu : menus) {
+				applier.ApplyMenu(&menu->movie, menu->name, menu->mode);
+			}
+		};
+
+		for (int i = 0; i < kWarmupFrames; i++) {
+			runFrame();
+		}
+
+		Result result;
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < kFrames; i++) {
+			runFrame();
+		}
+		result.nsPerFrame = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kFrames;
+
+		// Counted in a second pass: the enabled profiler times its stages, which would skew the first
+		Profiler::g_enabled = true;
+		std::uint64_t calls = 0;
+		std::uint64_t alphaWrites = 0;
+		for (int i = 0; i < kFrames; i++) {
+			runFrame();
+			for (std::uint32_t call = 0; call < static_cast<std::uint32_t>(Profiler::Call::kTotal); call++) {
+				calls += Profiler::GetFrameCount(static_cast<Profiler::Call>(call));
+			}
+			alphaWrites += Profiler::GetFrameCount(Profiler::Counter::kAlphaWrites);
+			Profiler::EndFrame();
+		}
+		Profiler::g_enabled = false;
+		Profiler::Reset();
+
+		result.callsPerFrame = static_cast<double>(calls) / kFrames;
+		result.alphaWritesPerFrame = static_cast<double>(alphaWrites) / kFrames;
+		return result;
+	}
+
+	void Print(const char* a_scenario, std::size_t a_widgets, std::size_t a_menus, const Result& a_result)
+	{
+		std::printf("%-8s %4zu widgets %3zu menus %10.0f ns/frame %8.1f calls/frame %7.1f alpha writes/frame\n",
+			a_scenario, a_widgets, a_menus, a_result.nsPerFrame, a_result.callsPerFrame, a_result.alphaWritesPerFrame);
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	// HUDApplyBench [widgets menus]: one configuration instead of the sweep
+	std::vector<std::pair<std::size_t, std::size_t>> configs = { { 0, 0 }, { 16, 4 }, { 64, 8 }, { 256, 32 } };
+	if (a_argc == 3) {
+		configs = { { std::stoul(a_argv[1]), std::stoul(a_argv[2]) } };
+	}
+
+	for (const auto& [widgets, menus] : configs) {
+		HUDScene::Session fading;
+		Print("fading", widgets, menus, Measure(widgets, menus, [&]() { return fading.Step(); }));
+
+		// HUD toggled on, in combat with a weapon drawn, every channel at its end value
+		HUDScene::Session session;
+		HUDApply::Frame rest;
+		for (int i = 0; i < 600 + 190; i++) {
+			rest = session.Step();
+		}
+		Print("steady", widgets, menus, Measure(widgets, menus, [&]() {
+			rest.timer += 1.0f / 60.0f;
+			return rest;
+		}));
+	}
+	return 0;
+}
@@ -0,0 +1,253 @@
+#include "HUDScene.h"
+
+#include <gtest/gtest.h>
+
+// The apply path (HUDApply) on the mock HUD: what reaches the clips, and what is left alone.
+namespace
+{
+	using WidgetModes::kIgnored;
+	using WidgetModes::kHidden;
+
+	class HUDApplyTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			HUDScene::BuildHUD(_hud, _host, 12);
+		}
+
+		void TearDown() override
+		{
+			Profiler::g_enabled = false;
+			Profiler::Reset();
+		}
+
+		// Advances the scripted session by a_frames and applies each of them.
+		HUDApply::Frame Run(int a_frames)
+		{
+			HUDApply::Frame frame;
+			for (int i = 0; i < a_frames; i++) {
+				frame = _session.Step();
+				_applier.BeginFrame(frame);
+				_applier.ApplyHUD(&_hud, _host);
+			}
+			return frame;
+		}
+
+		// Applies a_frame a_frames more times with only the timer advancing: the HUD at rest.
+		void Hold(HUDApply::Frame& a_frame, int a_frames)
+		{
+			for (int i = 0; i < a_frames; i++) {
+				a_frame.timer += 1.0f / 60.0f;
+				_applier.BeginFrame(a_frame);
+				_applier.ApplyHUD(&_hud, _host);
+			}
+		}
+
+		// Same, with the Profiler counting GFxOps calls and events over all of them.
+		void HoldCounted(HUDApply::Frame& a_frame, int a_frames)
+		{
+			Profiler::Reset();
+			Profiler::g_enabled = true;
+			Hold(a_frame, a_frames);
+			Profiler::g_enabled = false;
+		}
+
+		Mock::Node& Clip(std::string_view a_path) { return *FindClip(a_path); }
+
+		Mock::Node* FindClip(std::string_view a_path)
+		{
+			Mock::Value value;
+			const std::string path(a_path);
+			return _hud.GetVariable(&value, path.c_str()) ? value.GetNode() : nullptr;
+		}
+
+		Mock::Movie _hud;
+		HUDScene::Host _host;
+		HUDScene::Applier _applier;
+		HUDScene::Session _session;
+	};
+}
+
+TEST_F(HUDApplyTest, WidgetsReachTheirChannelAlpha)
+{
+	const auto frame = Run(190);  // Toggled on, in combat, weapon drawn
+	ASSERT_GT(frame.globalAlpha, 0.0f);
+
+	// WidgetContainer.0 is Immersive, .1 InCombat, .4 Visible
+	EXPECT_DOUBLE_EQ(Clip(HUDScene::WidgetPath(0)).alpha, frame.globalAlpha);
+	EXPECT_DOUBLE_EQ(Clip(HUDScene::WidgetPath(1)).alpha, frame.fade.combatAlpha);
+	EXPECT_DOUBLE_EQ(Clip(HUDScene::WidgetPath(4)).alpha, frame.hudMax);
+	EXPECT_TRUE(Clip(HUDScene::WidgetPath(0)).visible);
+}
+
+TEST_F(HUDApplyTest, MismatchedWidgetSourceIsLeftAlone)
+{
+	auto& widget = Clip(HUDScene::WidgetPath(0));
+	widget.url = "widgets/other.swf";  // SkyUI index shift: the slot now holds another widget
+	widget.alpha = 42.0;
+
+	Run(190);
+	EXPECT_EQ(widget.alpha, 42.0);
+	EXPECT_EQ(widget.alphaWrites, 0u);
+}
+
+TEST_F(HUDApplyTest, IgnoredWidgetIsShownAgain)
+{
+	auto& widget = Clip(HUDScene::WidgetPath(5));  // kIgnored
+	widget.alpha = 0.0;
+	widget.visible = false;
+
+	Run(1);
+	EXPECT_EQ(widget.alpha, 100.0);
+	EXPECT_TRUE(widget.visible);
+}
+
+TEST_F(HUDApplyTest, CoalescedElementWritesItsParent)
+{
+	const auto frame = Run(190);
+
+	const auto* def = &HUDElements::Get()[HUDElements::IndexOf("iMode_Compass")];
+	EXPECT_DOUBLE_EQ(Clip(def->parent).alpha, frame.globalAlpha);
+	for (const char* path : def->paths) {
+		EXPECT_EQ(Clip(path).alpha, 100.0) << path;
+	}
+}
+
+TEST_F(HUDApplyTest, ClaimedElementIsNotTouched)
+{
+	const auto index = HUDElements::IndexOf("iMode_Health");
+	_host.claimed.assign(HUDElements::Get().size(), false);
+	_host.claimed[index] = true;
+
+	Run(190);
+	for (const char* path : HUDElements::Get()[index].paths) {
+		EXPECT_EQ(Clip(path).alphaWrites, 0u) << path;
+	}
+}
+
+TEST_F(HUDApplyTest, HiddenMenuIsCulledAfterHoldTime)
+{
+	Mock::Movie menu;
+	HUDApply::Frame frame;
+	for (int i = 0; i < 60; i++) {
+		frame = _session.Step();
+		_applier.BeginFrame(frame);
+		_applier.ApplyMenu(&menu, "HiddenMenu", kHidden);
+	}
+
+	EXPECT_EQ(menu.Root().alpha, 0.0);
+	EXPECT_FALSE(menu.Root().visible);
+
+	// Handed back visible once the menu is ignored
+	_applier.ApplyMenu(&menu, "HiddenMenu", kIgnored);
+	EXPECT_TRUE(menu.Root().visible);
+}
+
+TEST_F(HUDApplyTest, HammerTouchesOnlyCachedHandlesAtRest)
+{
+	auto frame = Run(190);
+	HoldCounted(frame, 120);
+
+	// One shallow layout check per hammered parent over the 2 s interval, instead of one per parent per frame
+	EXPECT_EQ(Profiler::GetFrameCount(Profiler::Counter::kHammerChildrenWalked), 0u);
+	EXPECT_LE(Profiler::GetFrameCount(Profiler::Call::kVisitMembers), 10u);
+}
+
+TEST_F(HUDApplyTest, HammerPicksUpAddedChildAtLayoutCheck)
+{
+	auto frame = Run(190);
+	auto& penalty = Clip("_root.HUDMovieBaseInstance.Health").Add("SurvivalPenalty");
+	penalty.visible = false;
+
+	Hold(frame, 121);
+	EXPECT_TRUE(penalty.visible);
+}
+
+TEST_F(HUDApplyTest, HammerWalksAgainWhenCachedChildUnloads)
+{
+	auto frame = Run(190);
+	auto& health = Clip("_root.HUDMovieBaseInstance.Health");
+	health.Find("MeterBar")->Unload();
+	auto& replacement = health.Add("MeterBarNew");
+	replacement.visible = false;
+
+	HoldCounted(frame, 1);
+	EXPECT_GT(Profiler::GetFrameCount(Profiler::Counter::kHammerChildrenWalked), 0u);
+	EXPECT_TRUE(replacement.visible);
+}
+
+TEST_F(HUDApplyTest, CompassAndShoutMeterShareTheirHolder)
+{
+	const auto frame = Run(190);
+
+	EXPECT_DOUBLE_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder").alpha, frame.globalAlpha);
+	EXPECT_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass").alpha, 100.0);
+	for (const auto id : { "iMode_Compass", "iMode_ShoutMeter" }) {
+		for (const char* path : HUDElements::Get()[HUDElements::IndexOf(id)].paths) {
+			EXPECT_EQ(Clip(path).alpha, 100.0) << path;
+		}
+	}
+}
+
+TEST_F(HUDApplyTest, ShoutMeterInAnotherModeLeavesTheHolderAtFull)
+{
+	_host.elementModes[HUDElements::IndexOf("iMode_ShoutMeter")] = kHidden;
+	const auto frame = Run(190);
+
+	// The compass falls back to its own parent, the shout meter to per-clip writes
+	EXPECT_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder").alpha, 100.0);
+	EXPECT_DOUBLE_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass").alpha, frame.globalAlpha);
+	for (const char* path : HUDElements::Get()[HUDElements::IndexOf("iMode_ShoutMeter")].paths) {
+		EXPECT_EQ(Clip(path).alpha, 0.0) << path;
+	}
+}
+
+TEST_F(HUDApplyTest, ForeignChildKeepsTheHolderPerClip)
+{
+	Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder").Add("QuestMarkerOverlay");
+	const auto frame = Run(190);
+
+	EXPECT_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder").alpha, 100.0);
+	EXPECT_DOUBLE_EQ(Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass").alpha, frame.globalAlpha);
+}
+
+TEST_F(HUDApplyTest, HeldClipDriftIsUndoneWithinOneCycle)
+{
+	auto frame = Run(190);
+	auto& card = Clip("_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass.CompassCard");
+	card.alpha = 40.0;  // Faded by the engine or SkyHUD behind the coalesced parent
+
+	// 7 compass clips, the compass parent and 4 shout clips, one read back per frame
+	Hold(frame, 12);
+	EXPECT_EQ(card.alpha, 100.0);
+}
+
+TEST_F(HUDApplyTest, CoalescedHolderSavesPerClipLookups)
+{
+	auto frame = Run(190);
+	HoldCounted(frame, 60);
+	const auto coalescedLookups = Profiler::GetFrameCount(Profiler::Call::kGetVariable);
+	EXPECT_EQ(Profiler::GetFrameCount(Profiler::Counter::kAlphaWrites), 0u);
+
+	// Same HUD at rest with every compass and shout clip resolved per frame
+	HUDScene::Applier perClip;
+	for (const char* parent : { "_root.HUDMovieBaseInstance.CompassShoutMeterHolder", "_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass" }) {
+		Clip(parent).Add("QuestMarkerOverlay");
+	}
+	perClip.BeginFrame(frame);
+	perClip.ApplyHUD(&_hud, _host);
+
+	Profiler::Reset();
+	Profiler::g_enabled = true;
+	for (int i = 0; i < 60; i++) {
+		frame.timer += 1.0f / 60.0f;
+		perClip.BeginFrame(frame);
+		perClip.ApplyHUD(&_hud, _host);
+	}
+	Profiler::g_enabled = false;
+
+	// 11 clip lookups per frame become none
+	EXPECT_EQ(Profiler::GetFrameCount(Profiler::Call::kGetVariable), coalescedLookups + 11u * 60u);
+	EXPECT_EQ(Profiler::GetFrameCount(Profiler::Counter::kAlphaWrites), 0u);
+}
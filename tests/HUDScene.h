@@ -0,0 +1,173 @@
+#pragma once
+
+#include "HUDApply.h"
+#include "MockScaleform.h"
+
+// Mock HUD shared by HUDApplyTests and HUDApplyBench: the vanilla and SkyHUD clips of every HUDElements entry
+// in one movie, N SkyUI widgets in _root.WidgetContainer and M external menu movies.
+namespace HUDScene
+{
+	using Applier = HUDApply::Applier<Mock::Movie, Mock::Value>;
+
+	// HUDApply::Host over plain containers. Lookups take string_views and do not allocate.
+	struct Host
+	{
+		bool IsElementClaimed(std::size_t a_index) const { return a_index < claimed.size() && claimed[a_index]; }
+		int GetElementMode(std::size_t a_index, std::string_view) const { return elementModes[a_index]; }
+
+		int GetWidgetMode(std::string_view a_path) const
+		{
+			const auto it = widgetModes.find(a_path);
+			return it != widgetModes.end() ? it->second : WidgetModes::kImmersive;
+		}
+
+		bool IsWidgetSkipped(std::string_view a_path) const { return skipped.contains(a_path); }
+		const std::vector<std::string>& GetWidgetPaths() const { return paths; }
+		std::uint32_t GetSourceGeneration() const { return generation; }
+
+		std::uint32_t GetSourceGeneration(std::string_view a_path) const
+		{
+			const auto it = pathGenerations.find(a_path);
+			return it != pathGenerations.end() ? it->second : 0;
+		}
+
+		const std::string& GetWidgetSource(std::string_view a_path) const
+		{
+			static const std::string none;
+			const auto it = sources.find(a_path);
+			return it != sources.end() ? it->second : none;
+		}
+
+		template <class T>
+		using PathMap = std::unordered_map<std::string, T, StringKernels::TransparentStringHash, std::equal_to<>>;
+
+		std::vector<int> elementModes = std::vector<int>(HUDElements::Get().size(), WidgetModes::kImmersive);
+		std::vector<bool> claimed;
+		std::vector<std::string> paths;
+		PathMap<int> widgetModes;
+		PathMap<std::string> sources;
+		PathMap<std::uint32_t> pathGenerations;
+		std::unordered_set<std::string, StringKernels::TransparentStringHash, std::equal_to<>> skipped;
+		std::uint32_t generation = 1;
+	};
+
+	inline Mock::Node& AddClip(Mock::Node& a_root, std::string_view a_path)
+	{
+		return a_root.AddPath(a_path.substr(a_path.find('.') + 1));  // Below "_root."
+	}
+
+	// Children the Visibility Hammer and the sub-meter writes walk.
+	inline void AddElementChildren(const HUDElements::Def& a_def, Mock::Node& a_clip)
+	{
+		const std::string_view id(a_def.id);
+		if (id == "iMode_Health" || id == "iMode_Magicka" || id == "iMode_Stamina") {
+			a_clip.Add("MeterBar");
+			a_clip.Add("MeterFlashAnim");
+			a_clip.Add("PenaltyMeter");
+		} else if (id == "iMode_EnchantLeft" || id == "iMode_EnchantRight") {
+			a_clip.Add("ChargeMeter_mc").Add("Bar");
+			a_clip.Add("Frame");
+		} else if (id == "iMode_EnchantCombined") {
+			for (const auto name : { "ChargeMeterFrameAlt", "ChargeMeterLeftAlt", "ChargeMeterRightAlt" }) {
+				a_clip.Add(name).Add("Bar");
+			}
+		} else if (id == "iMode_StealthMeter") {
+			a_clip.Add("SneakAnimInstance");
+			a_clip.Add("SneakTextHolder");
+		}
+	}
+
+	inline std::string WidgetPath(std::size_t a_index)
+	{
+		return "_root.WidgetContainer." + std::to_string(a_index);
+	}
+
+	// Vanilla and SkyHUD clips of every element, plus a_widgets SkyUI widgets registered with a_host.
+	inline void BuildHUD(Mock::Movie& a_movie, Host& a_host, std::size_t a_widgets)
+	{
+		auto& root = a_movie.Root();
+		for (const auto& def : HUDElements::Get()) {
+			for (const char* path : def.paths) {
+				AddElementChildren(def, AddClip(root, path));
+			}
+		}
+
+		auto& container = root.Add("WidgetContainer");
+		static constexpr std::array kModes = { WidgetModes::kImmersive, WidgetModes::kInCombat, WidgetModes::kInterior,
+			WidgetModes::kWeaponDrawn, WidgetModes::kVisible, WidgetModes::kIgnored };
+		for (std::size_t i = 0; i < a_widgets; i++) {
+			auto& widget = container.Add(std::to_string(i));
+			widget.url = "widgets/widget" + std::to_string(i) + ".swf";
+			widget.Add("widget");
+
+			const auto path = WidgetPath(i);
+			a_host.paths.push_back(path);
+			a_host.sources.emplace(path, widget.url);
+			a_host.widgetModes.emplace(path, kModes[i % kModes.size()]);
+		}
+	}
+
+	struct Menu
+	{
+		std::string name;
+		int mode;
+		Mock::Movie movie;
+	};
+
+	inline std::vector<std::unique_ptr<Menu>> BuildMenus(std::size_t a_count)
+	{
+		static constexpr std::array kModes = { WidgetModes::kImmersive, WidgetModes::kInCombat, WidgetModes::kExterior, WidgetModes::kHidden };
+		std::vector<std::unique_ptr<Menu>> menus;
+		for (std::size_t i = 0; i < a_count; i++) {
+			auto menu = std::make_unique<Menu>(Menu{ "ExternalMenu" + std::to_string(i), kModes[i % kModes.size()], {} });
+			menu->movie.Root().Add("content");
+			menus.push_back(std::move(menu));
+		}
+		return menus;
+	}
+
+	// Scripted play: a toggled HUD fading in and out, combat, interiors, weapon draws and sneaking.
+	// Runs the real fade engine; its state is handed to the applier the way HUDManager::ApplyAlphaToHUD does.
+	class Session
+	{
+	public:
+		HUDApply::Frame Step()
+		{
+			constexpr float kDelta = 1.0f / 60.0f;
+			const int phase = _frame++ % 600;
+
+			FadeEngine::Inputs inputs;
+			inputs.delta = kDelta;
+			inputs.userWantsVisible = phase < 200 || (phase >= 400 && phase < 450);
+			inputs.isInCombat = phase >= 100 && phase < 300;
+			inputs.isWeaponDrawn = phase >= 150 && phase < 350;
+			inputs.isInterior = phase >= 300;
+			inputs.isSneaking = phase >= 450 && phase < 550;
+			inputs.detectionLevel = inputs.isSneaking ? 40.0f : 0.0f;
+			inputs.hasLeftEnchant = true;
+			inputs.hasRightEnchant = true;
+
+			const auto targets = FadeEngine::ComputeTargets(_state, inputs, _config);
+			FadeEngine::Advance(_state, targets, inputs, _config);
+			_timer += kDelta;
+
+			HUDApply::Frame frame;
+			frame.timer = _timer;
+			frame.globalAlpha = _state.currentAlpha;
+			frame.fade = _state;
+			frame.targets = targets;
+			frame.isSneaking = inputs.isSneaking;
+			frame.detectionLevel = inputs.detectionLevel;
+			frame.weaponDrawn = inputs.isWeaponDrawn;
+			frame.enchantedLeft = true;
+			frame.enchantedRight = true;
+			return frame;
+		}
+
+	private:
+		FadeEngine::Config _config;
+		FadeEngine::State _state;
+		float _timer = 0.0f;
+		int _frame = 0;
+	};
+}
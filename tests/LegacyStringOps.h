@@ -0,0 +1,71 @@
+#pragma once
+
+// The scalar code StringKernels replaced, kept as the reference for tests and the benchmark.
+// Bodies follow the last version before the kernels; only sscanf_s became std::sscanf.
+namespace Legacy
+{
+	// Settings::AddDiscoveredPath validation
+	inline bool IsPrintableAscii(std::string_view a_str)
+	{
+		for (char c : a_str) {
+			auto uc = static_cast<unsigned char>(c);
+			if (uc < 32 || uc > 126) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// IsIgnoredUrl: lowercase copy, then find
+	inline std::size_t FindNoCase(std::string_view a_haystack, std::string_view a_needle)
+	{
+		thread_local std::string lower;
+		lower.assign(a_haystack);
+		std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+		return lower.find(a_needle);
+	}
+
+	inline void ToLowerAscii(std::string& a_str)
+	{
+		std::transform(a_str.begin(), a_str.end(), a_str.begin(), ::tolower);
+	}
+
+	inline std::string SanitizeName(std::string_view a_name)
+	{
+		std::string clean(a_name);
+		for (char& c : clean) {
+			if (!isalnum(static_cast<unsigned char>(c))) {
+				c = '_';
+			}
+		}
+		return clean;
+	}
+
+	// When sscanf converted nothing the old code appended whatever ii held. a_keepUnconverted copies
+	// the '%' literally instead, as PercentDecode does; a_unconverted reports that such an escape was seen.
+	inline std::string UrlDecode(std::string_view a_src, bool a_keepUnconverted = false, bool* a_unconverted = nullptr)
+	{
+		std::string ret;
+		ret.reserve(a_src.length());
+		unsigned int ii;
+
+		for (size_t i = 0; i < a_src.length(); i++) {
+			if (a_src[i] == '%') {
+				if (i + 2 < a_src.length()) {
+					char hex[3] = { a_src[i + 1], a_src[i + 2], '\0' };
+					const int converted = std::sscanf(hex, "%x", &ii);
+					if (converted == 0 && a_unconverted) {
+						*a_unconverted = true;
+					}
+					if (converted != EOF && (converted > 0 || !a_keepUnconverted)) {
+						ret += static_cast<char>(ii);
+						i = i + 2;
+						continue;
+					}
+				}
+			}
+			ret += (a_src[i] == '+') ? ' ' : a_src[i];
+		}
+		return ret;
+	}
+}
@@ -0,0 +1,275 @@
+#include "JsonStream.h"
+#include "MCMConfig.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+	constexpr std::array<std::string_view, 10> kOptions = {
+		"$fzIH_ModeVisible", "$fzIH_ModeImmersive", "$fzIH_ModeHidden", "$fzIH_ModeIgnored",
+		"$fzIH_ModeInterior", "$fzIH_ModeExterior", "$fzIH_ModeInCombat", "$fzIH_ModeNotInCombat",
+		"$fzIH_ModeWeaponDrawn", "$fzIH_ModeTDMDisabled"
+	};
+
+	// The serializer MCMConfig replaced: rebuild the generated pages as json values, then dump(2).
+	json CreateEnum(const MCMConfig::Entry& a_entry)
+	{
+		std::vector<std::string> options(kOptions.begin(), kOptions.end());
+		return {
+			{ "help", a_entry.help },
+			{ "id", a_entry.id },
+			{ "text", a_entry.text },
+			{ "type", "enum" },
+			{ "valueOptions", { { "options", options }, { "sourceType", "ModSettingInt" }, { "defaultValue", 1 } } }
+		};
+	}
+
+	std::string ReferenceSerialize(json a_document, const MCMConfig::GeneratedPages& a_pages)
+	{
+		if (a_document.contains("pages") && a_document["pages"].is_array()) {
+			for (auto& page : a_document["pages"]) {
+				if (!page.is_object() || !page.contains("content")) {
+					continue;
+				}
+				const std::string name = page.value("pageDisplayName", "");
+				auto& content = page["content"];
+				if (name == "$fzIH_PageElements") {
+					content = json::array();
+					content.push_back({ { "id", "ElemStatus" }, { "text", a_pages.elementStatus }, { "type", "text" } });
+					content.push_back({ { "type", "header" } });
+					for (const auto& entry : a_pages.elements) {
+						content.push_back(CreateEnum(entry));
+					}
+				} else if (name == "$fzIH_PageWidgets") {
+					content = json::array();
+					content.push_back({ { "id", "WidStatus" }, { "text", a_pages.widgetStatus }, { "type", "text" } });
+					content.push_back({ { "type", "header" } });
+					for (const auto& entry : *a_pages.widgets | std::views::values) {
+						content.push_back(CreateEnum(entry));
+					}
+				}
+			}
+		}
+		return a_document.dump(2);
+	}
+
+	MCMConfig::Entry MakeEntry(std::string_view a_key, std::string_view a_label, std::string_view a_source, std::string_view a_path)
+	{
+		MCMConfig::Entry entry;
+		entry.iniKey = a_key;
+		entry.id = std::string(a_key) + ":Widgets";
+		entry.text = a_label;
+		entry.source = a_source;
+		entry.rawPath = a_path;
+		entry.help = "Source: " + std::string(a_source) + "\nID: " + std::string(a_path);
+		return entry;
+	}
+
+	// Shape of the shipped config.json: authored pages around the two generated ones.
+	json MakeDocument()
+	{
+		return json::parse(R"({
+			"modName": "ImmersiveHUD",
+			"displayName": "$fzIH_ModName",
+			"minMcmVersion": 9,
+			"cursorFillMode": "topToBottom",
+			"pages": [
+				{
+					"pageDisplayName": "$fzIH_PageGeneral",
+					"cursorFillMode": "topToBottom",
+					"content": [
+						{ "type": "header", "text": "$fzIH_HeaderGeneral" },
+						{ "id": "fFadeInSpeed:General", "type": "slider", "text": "$fzIH_FadeIn",
+						  "valueOptions": { "min": 0.5, "max": 20.0, "step": 0.25, "formatString": "{2}", "sourceType": "ModSettingFloat" } },
+						{ "id": "bHoldMode:General", "type": "toggle", "text": "$fzIH_HoldMode", "valueOptions": { "sourceType": "ModSettingBool" } },
+						{ "id": "iToggleKey:General", "type": "keymap", "ignoreConflicts": false, "valueOptions": {} },
+						{ "type": "empty" }
+					]
+				},
+				{ "pageDisplayName": "$fzIH_PageElements", "cursorFillMode": "leftToRight", "content": [] },
+				{ "pageDisplayName": "$fzIH_PageWidgets", "cursorFillMode": "leftToRight", "content": [ { "stale": true } ] },
+				{ "pageDisplayName": "$fzIH_PageDebug", "content": [], "hidden": null }
+			]
+		})");
+	}
+
+	void ExpectMatchesReference(const json& a_document, const MCMConfig::GeneratedPages& a_pages)
+	{
+		const std::string streamed = MCMConfig::Serialize(a_document, a_pages);
+		const std::string reference = ReferenceSerialize(a_document, a_pages);
+		ASSERT_EQ(streamed.size(), reference.size());
+		EXPECT_EQ(streamed, reference);
+	}
+
+	// Writes any json value through the JsonStream primitives the way MCMConfig does.
+	void Stream(JsonStream& a_js, const json& a_value)
+	{
+		if (a_value.is_object()) {
+			a_js.Open('{');
+			for (const auto& [key, value] : a_value.items()) {
+				a_js.Key(key);
+				Stream(a_js, value);
+			}
+			a_js.Close('}');
+		} else if (a_value.is_array()) {
+			a_js.Open('[');
+			for (const auto& value : a_value) {
+				a_js.Element();
+				Stream(a_js, value);
+			}
+			a_js.Close(']');
+		} else if (a_value.is_string()) {
+			a_js.String(a_value.get_ref<const std::string&>());
+		} else {
+			a_js.Raw(a_value.dump());
+		}
+	}
+
+	std::string RandomString(std::mt19937& a_rng)
+	{
+		static constexpr std::string_view kSpecial[] = { "\"", "\\", "/", "\b", "\f", "\n", "\r", "\t", "\x01", "\x1f", "\x7f",
+			"\xc3\xbc", "\xf0\x9f\xa6\x8b", "<font color='#00FF00'>", "$fzIH_" };
+		std::string out;
+		const int length = std::uniform_int_distribution<int>(0, 12)(a_rng);
+		for (int i = 0; i < length; i++) {
+			if (std::uniform_int_distribution<int>(0, 3)(a_rng) == 0) {
+				out += kSpecial[std::uniform_int_distribution<std::size_t>(0, std::size(kSpecial) - 1)(a_rng)];
+			} else {
+				out += static_cast<char>(std::uniform_int_distribution<int>(0x20, 0x7E)(a_rng));
+			}
+		}
+		return out;
+	}
+
+	json RandomValue(std::mt19937& a_rng, int a_depth)
+	{
+		switch (std::uniform_int_distribution<int>(0, a_depth > 0 ? 7 : 5)(a_rng)) {
+		case 0:
+			return nullptr;
+		case 1:
+			return std::uniform_int_distribution<int>(0, 1)(a_rng) == 1;
+		case 2:
+			return std::uniform_int_distribution<int>(-100000, 100000)(a_rng);
+		case 3:
+			return std::uniform_real_distribution<double>(-1000.0, 1000.0)(a_rng);
+		case 4:
+		case 5:
+			return RandomString(a_rng);
+		case 6:
+			{
+				json array = json::array();
+				const int size = std::uniform_int_distribution<int>(0, 4)(a_rng);
+				for (int i = 0; i < size; i++) {
+					array.push_back(RandomValue(a_rng, a_depth - 1));
+				}
+				return array;
+			}
+		default:
+			{
+				json object = json::object();
+				const int size = std::uniform_int_distribution<int>(0, 4)(a_rng);
+				for (int i = 0; i < size; i++) {
+					object[RandomString(a_rng)] = RandomValue(a_rng, a_depth - 1);
+				}
+				return object;
+			}
+		}
+	}
+}
+
+TEST(JsonStream, MatchesDumpForRandomDocuments)
+{
+	std::mt19937 rng(0x49485544);
+	for (int i = 0; i < 2000; i++) {
+		const json value = RandomValue(rng, 5);
+
+		std::string streamed;
+		JsonStream js(streamed);
+		Stream(js, value);
+
+		ASSERT_EQ(streamed, value.dump(2)) << "iteration " << i;
+	}
+}
+
+TEST(JsonStream, ValueReindentsAtDepth)
+{
+	const json nested = json::parse(R"({ "a": [1, { "b": [] }, {}], "c": "x" })");
+	const json outer = { { "k", { { "inner", nested }, { "list", json::array({ nested, 2 }) } } } };
+
+	std::string streamed;
+	JsonStream js(streamed);
+	js.Open('{');
+	js.Key("k");
+	js.Open('{');
+	js.Key("inner");
+	js.Value(nested);
+	js.Key("list");
+	js.Open('[');
+	js.Element();
+	js.Value(nested);
+	js.Element();
+	js.Raw("2");
+	js.Close(']');
+	js.Close('}');
+	js.Close('}');
+
+	EXPECT_EQ(streamed, outer.dump(2));
+}
+
+TEST(MCMConfig, MatchesReferenceSerializer)
+{
+	std::vector<MCMConfig::Entry> elements = {
+		MakeEntry("iMode_Compass", "$fzIH_ElemCompass", "Internal/Vanilla", "_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass"),
+		MakeEntry("iMode_Health", "$fzIH_ElemHealth", "Internal/Vanilla", "_root.HUDMovieBaseInstance.Health"),
+		MakeEntry("iMode_Empty", "$fzIH_ElemEmpty", "Internal/Vanilla", "")
+	};
+	std::map<std::string, MCMConfig::Entry> widgets;
+	for (auto entry : { MakeEntry("iMode_Meter", "Meter", "Interface/exported/widgets/skyui/meter.swf", "_root.WidgetContainer.3.widget"),
+			 MakeEntry("iMode_Clock", "Clock \"Extended\"", "Interface\\clock.swf", "Clock Menu"),
+			 MakeEntry("iMode_Tabs", "Tabs\tand\nlines", "Interface/\x01odd.swf", "_root.A") }) {
+		entry.help += "\n(+ 2 other instances)";
+		widgets.emplace(entry.id, entry);
+	}
+
+	MCMConfig::GeneratedPages pages;
+	pages.elementStatus = "<font color='#00FF00'>Status: 3 HUD Elements registered.</font>";
+	pages.elements = elements;
+	pages.widgetStatus = "$fzIH_WidgetNewFound";
+	pages.widgets = &widgets;
+	pages.options = kOptions;
+
+	ExpectMatchesReference(MakeDocument(), pages);
+}
+
+TEST(MCMConfig, EmptyGeneratedPages)
+{
+	const std::map<std::string, MCMConfig::Entry> widgets;
+
+	MCMConfig::GeneratedPages pages;
+	pages.elementStatus = "";
+	pages.widgetStatus = "<font color='#00FF00'>Status: 0 widgets registered.</font>";
+	pages.widgets = &widgets;
+	pages.options = kOptions;
+
+	ExpectMatchesReference(MakeDocument(), pages);
+}
+
+TEST(MCMConfig, IrregularDocuments)
+{
+	const std::map<std::string, MCMConfig::Entry> widgets;
+	MCMConfig::GeneratedPages pages;
+	pages.widgets = &widgets;
+	pages.options = kOptions;
+
+	for (const char* text : {
+			 R"({})",
+			 R"({ "pages": [] })",
+			 R"({ "pages": {} })",
+			 R"({ "pages": [1, "two", null, [], {}] })",
+			 R"({ "a": { "b": { "c": [[], [{}]] } }, "pages": [ { "pageDisplayName": "$fzIH_PageOther", "content": [] }, { "content": [1] } ] })" }) {
+		SCOPED_TRACE(text);
+		ExpectMatchesReference(json::parse(text), pages);
+	}
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "MCMUpdate.h"
+#include "StringKernels.h"
+
+// Seeded MCM directories for MCMUpdate, shared by MCMUpdateTests and MCMUpdateBench.
+// A session is a fresh Model over config.json and settings.ini in a temp directory, like a game launch.
+namespace MCMScene
+{
+	// Stand-in for CSimpleIniA: the same calls, case-insensitive keys, sections and keys kept in file order.
+	// Writes "key = value" lines with two blank lines between sections, which round-trips the shipped settings.ini.
+	class Ini
+	{
+	public:
+		void SetUnicode() {}
+
+		int LoadFile(const char* a_path)
+		{
+			std::ifstream file(a_path, std::ios::binary);
+			if (!file) {
+				return -1;
+			}
+			std::string line;
+			std::string section;
+			while (std::getline(file, line)) {
+				const auto text = Trim(line);
+				if (text.empty() || text[0] == ';' || text[0] == '#') {
+					continue;
+				}
+				if (text.front() == '[' && text.back() == ']') {
+					section.assign(text.substr(1, text.size() - 2));
+					FindSection(section, true);
+					continue;
+				}
+				const auto equals = text.find('=');
+				if (equals != std::string_view::npos) {
+					SetValue(section, Trim(text.substr(0, equals)), Trim(text.substr(equals + 1)));
+				}
+			}
+			return 0;
+		}
+
+		int SaveFile(const char* a_path)
+		{
+			std::string text;
+			for (const auto& section : _sections) {
+				if (!text.empty()) {
+					text += "\n\n";
+				}
+				text += '[' + section.name + "]\n";
+				for (const auto& [key, value] : section.values) {
+					text += value.empty() ? key + " =\n" : key + " = " + value + '\n';
+				}
+			}
+			std::ofstream file(a_path, std::ios::binary | std::ios::trunc);
+			file.write(text.data(), static_cast<std::streamsize>(text.size()));
+			saves++;
+			bytesWritten += text.size();
+			return file ? 0 : -1;
+		}
+
+		const char* GetValue(const char* a_section, const char* a_key, const char* a_default) const
+		{
+			const auto* value = Find(a_section, a_key);
+			return value ? value->c_str() : a_default;
+		}
+
+		long GetLongValue(const char* a_section, const char* a_key, long a_default) const
+		{
+			const auto* value = Find(a_section, a_key);
+			return value ? std::strtol(value->c_str(), nullptr, 10) : a_default;
+		}
+
+		int SetLongValue(const char* a_section, const char* a_key, long a_value, const char*)
+		{
+			SetValue(a_section, a_key, std::to_string(a_value));
+			return 0;
+		}
+
+		std::size_t saves = 0;
+		std::size_t bytesWritten = 0;
+
+	private:
+		struct Section
+		{
+			std::string name;
+			std::vector<std::pair<std::string, std::string>> values;
+			std::unordered_map<std::string, std::size_t> index;  // Lowercase key -> values
+		};
+
+		static std::string_view Trim(std::string_view a_text)
+		{
+			const auto first = a_text.find_first_not_of(" \t\r\n");
+			if (first == std::string_view::npos) {
+				return {};
+			}
+			return a_text.substr(first, a_text.find_last_not_of(" \t\r\n") - first + 1);
+		}
+
+		static std::string Lower(std::string_view a_text)
+		{
+			std::string result(a_text);
+			std::ranges::transform(result, result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return result;
+		}
+
+		Section* FindSection(std::string_view a_name, bool a_create)
+		{
+			for (auto& section : _sections) {
+				if (Lower(section.name) == Lower(a_name)) {
+					return &section;
+				}
+			}
+			return a_create ? &_sections.emplace_back(Section{ std::string(a_name) }) : nullptr;
+		}
+
+		const std::string* Find(std::string_view a_section, std::string_view a_key) const
+		{
+			auto* section = const_cast<Ini*>(this)->FindSection(a_section, false);
+			if (!section) {
+				return nullptr;
+			}
+			const auto it = section->index.find(Lower(a_key));
+			return it != section->index.end() ? &section->values[it->second].second : nullptr;
+		}
+
+		void SetValue(std::string_view a_section, std::string_view a_key, std::string_view a_value)
+		{
+			auto* section = FindSection(a_section, true);
+			const auto [it, inserted] = section->index.emplace(Lower(a_key), section->values.size());
+			if (inserted) {
+				section->values.emplace_back(a_key, a_value);
+			} else {
+				section->values[it->second].second.assign(a_value);
+			}
+		}
+
+		std::vector<Section> _sections;
+	};
+
+	// MCMUpdate::Host over plain containers: the discovery cache, installed files and open interactive menus.
+	struct Host
+	{
+		const std::set<std::string, std::less<>>& GetActivePaths() const { return paths; }
+
+		const std::string& GetWidgetSource(std::string_view a_path) const
+		{
+			static const std::string kUnknown = "Unknown";
+			const auto it = sources.find(a_path);
+			return it != sources.end() ? it->second : kUnknown;
+		}
+
+		bool IsSkyUIWidgetSource(std::string_view a_source) const
+		{
+			return StringKernels::FindNoCase(a_source, "widgets/") != std::string_view::npos ||
+			       StringKernels::FindNoCase(a_source, "skyui") != std::string_view::npos;
+		}
+
+		bool IsSystemMenu(std::string_view a_menuName) const { return a_menuName == "InventoryMenu" || a_menuName == "MapMenu"; }
+		bool IsInteractive(const std::string&, const std::string& a_source) const { return interactive.contains(a_source); }
+
+		void ProbeSources(const std::vector<std::string>& a_sources) { probes += a_sources.size(); }
+		bool SourceExists(const std::string& a_source) const { return installed.contains(a_source); }
+
+		bool UsesTDM() const { return false; }
+		bool IsAltChargeEnabled() const { return false; }
+		void SaveCache() { cacheSaves++; }
+
+		void Add(const std::string& a_path, const std::string& a_source)
+		{
+			paths.insert(a_path);
+			sources.insert_or_assign(a_path, a_source);
+			installed.insert(a_source);
+		}
+
+		std::set<std::string, std::less<>> paths;
+		std::map<std::string, std::string, std::less<>> sources;
+		std::unordered_set<std::string> installed;    // Sources on disk or in an archive
+		std::unordered_set<std::string> interactive;  // Sources of known interactive menus
+		std::size_t probes = 0;
+		std::size_t cacheSaves = 0;
+	};
+
+	using Model = MCMUpdate::Model<Ini>;
+
+	// Unique directory below the system temp path, removed with everything in it.
+	class TempDir
+	{
+	public:
+		TempDir()
+		{
+			static std::atomic_uint32_t counter = 0;
+			_path = fs::temp_directory_path() / fmt::format("ihud_mcm_{}_{}", std::chrono::steady_clock::now().time_since_epoch().count(), counter++);
+			fs::create_directories(_path);
+		}
+		~TempDir()
+		{
+			std::error_code ec;
+			fs::remove_all(_path, ec);
+		}
+
+		TempDir(const TempDir&) = delete;
+		TempDir& operator=(const TempDir&) = delete;
+
+		const fs::path& Path() const { return _path; }
+
+	private:
+		fs::path _path;
+	};
+
+	inline std::unique_ptr<Model> OpenSession(const fs::path& a_dir)
+	{
+		auto model = std::make_unique<Model>();
+		model->configPath = a_dir / "config.json";
+		model->iniPath = a_dir / "settings.ini";
+		return model;
+	}
+
+	inline std::string ReadFile(const fs::path& a_path)
+	{
+		std::ifstream file(a_path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	// The installed mod: the shipped config.json and settings.ini.
+	inline void Install(const fs::path& a_dir)
+	{
+		const fs::path shipped = fs::path(IHUD_MCM_DATA);
+		fs::copy_file(shipped / "config.json", a_dir / "config.json", fs::copy_options::overwrite_existing);
+		fs::copy_file(shipped / "settings.ini", a_dir / "settings.ini", fs::copy_options::overwrite_existing);
+	}
+
+	// A load order with a_widgets SkyUI widgets in WidgetContainer slots from a_firstSlot, every fifth a second
+	// instance of the one before, plus one external menu for every eight widgets.
+	inline void AddLoadOrder(Host& a_host, std::size_t a_widgets, std::size_t a_firstSlot = 0)
+	{
+		for (std::size_t i = 0; i < a_widgets; i++) {
+			const auto mod = (i % 5 == 4) ? i - 1 : i;
+			a_host.Add(fmt::format("_root.WidgetContainer.{}", a_firstSlot + i), fmt::format("widgets/mod{0}/widget{0}.swf", mod));
+		}
+		for (std::size_t i = 0; i < a_widgets / 8; i++) {
+			a_host.Add(fmt::format("ModMenu{}", i), fmt::format("Interface/mods/modmenu{}.swf", i));
+		}
+	}
+
+	// One game launch: the initial scan at the main menu, the mid scan once the HUD loaded, one runtime scan.
+	inline void PlaySession(const fs::path& a_dir, Host& a_host)
+	{
+		auto model = OpenSession(a_dir);
+		MCMUpdate::Update(*model, a_host, false, false);
+		MCMUpdate::Update(*model, a_host, false, true);
+		MCMUpdate::Update(*model, a_host, true, true);
+	}
+
+	// An installed mod whose last session discovered the a_widgets load order.
+	inline void Seed(const fs::path& a_dir, std::size_t a_widgets)
+	{
+		Install(a_dir);
+		Host host;
+		AddLoadOrder(host, a_widgets);
+		PlaySession(a_dir, host);
+	}
+}
@@ -0,0 +1,118 @@
+#include "AllocationCounter.h"
+#include "MCMScene.h"
+
+#include <cstdio>
+
+// Runs the real MCM generation (MCMUpdate) over temp directories seeded with N widgets by a previous session.
+// Each scenario is one new session: a fresh Model hydrated from disk, then the scans of that scenario.
+// Reports wall time, bytes written to config.json and settings.ini, and heap allocations per session.
+// Not part of ctest: run MCMUpdateBench from a Release build.
+namespace
+{
+	struct Scenario
+	{
+		const char* name;
+		std::size_t newWidgets;  // Widgets added to the load order since the seeded session
+		std::size_t firstSlot;   // WidgetContainer slot of the first widget
+		bool runtime;            // Last scan is a runtime scan, as after the mid scan
+	};
+
+	constexpr Scenario kScenarios[] = {
+		{ "runtime", 0, 0, true },
+		{ "midscan", 4, 0, false },
+		{ "shift", 0, 1, false },
+	};
+
+	struct Result
+	{
+		double usPerSession = 0.0;
+		std::size_t bytesWritten = 0;
+		std::size_t allocations = 0;
+	};
+
+	struct Session
+	{
+		std::size_t bytesWritten = 0;
+	};
+
+	Session RunSession(const fs::path& a_dir, MCMScene::Host& a_host, const Scenario& a_scenario)
+	{
+		Session session;
+		auto model = MCMScene::OpenSession(a_dir);
+		auto update = [&](bool a_runtime, bool a_populated) {
+			const auto result = MCMUpdate::Update(*model, a_host, a_runtime, a_populated);
+			session.bytesWritten += result.configWritten ? result.configBytes : 0;
+		};
+		update(false, false);
+		update(false, true);
+		if (a_scenario.runtime) {
+			a_host.Add("LateMenu", "Interface/mods/latemenu.swf");
+			update(true, true);
+		}
+		session.bytesWritten += model->ini.bytesWritten;
+		return session;
+	}
+
+	Result Measure(std::size_t a_widgets, const Scenario& a_scenario)
+	{
+		MCMScene::TempDir seeded;
+		MCMScene::Seed(seeded.Path(), a_widgets);
+
+		MCMScene::TempDir dir;
+		auto restore = [&]() {
+			for (const auto* file : { "config.json", "settings.ini" }) {
+				fs::copy_file(seeded.Path() / file, dir.Path() / file, fs::copy_options::overwrite_existing);
+			}
+		};
+		auto makeHost = [&]() {
+			MCMScene::Host host;
+			MCMScene::AddLoadOrder(host, a_widgets + a_scenario.newWidgets, a_scenario.firstSlot);
+			return host;
+		};
+
+		Result result;
+		{
+			restore();
+			auto host = makeHost();
+			AllocationCounter::Scope counting;
+			result.bytesWritten = RunSession(dir.Path(), host, a_scenario).bytesWritten;
+			result.allocations = counting.Count();
+		}
+
+		const int sessions = a_widgets <= 100 ? 50 : 5;
+		std::chrono::steady_clock::duration elapsed{};
+		for (int i = 0; i < sessions; i++) {
+			restore();
+			auto host = makeHost();
+			const auto start = std::chrono::steady_clock::now();
+			RunSession(dir.Path(), host, a_scenario);
+			elapsed += std::chrono::steady_clock::now() - start;
+		}
+		result.usPerSession = std::chrono::duration<double, std::micro>(elapsed).count() / sessions;
+		return result;
+	}
+
+	void Print(std::size_t a_widgets, const Scenario& a_scenario, const Result& a_result)
+	{
+		std::printf("%-8s %5zu widgets %10.0f us/session %9zu bytes written %8zu allocs\n",
+			a_scenario.name, a_widgets, a_result.usPerSession, a_result.bytesWritten, a_result.allocations);
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	// MCMUpdateBench [widgets]: one load order size instead of the sweep
+	std::vector<std::size_t> sizes = { 10, 100, 500, 2000 };
+	if (a_argc == 2) {
+		sizes = { std::stoul(a_argv[1]) };
+	}
+
+	for (const auto widgets : sizes) {
+		for (const auto& scenario : kScenarios) {
+			Print(widgets, scenario, Measure(widgets, scenario));
+		}
+	}
+	return 0;
+}
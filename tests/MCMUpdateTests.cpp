@@ -0,0 +1,190 @@
+#include "MCMScene.h"
+
+#include <gtest/gtest.h>
+
+// MCM generation (MCMUpdate) run against seeded temp directories, session by session like the game.
+// The golden configs in data/mcm pin the generated config.json and settings.ini byte for byte;
+// after an intended output change, rerun with IHUD_UPDATE_GOLDEN=1 to rewrite them and review the diff.
+namespace
+{
+	constexpr std::size_t kGoldenWidgets = 10;
+
+	void ExpectGolden(const fs::path& a_dir, std::string_view a_scenario)
+	{
+		const fs::path golden = fs::path(IHUD_TEST_DATA) / "mcm";
+		const std::pair<fs::path, fs::path> files[] = {
+			{ a_dir / "config.json", golden / fmt::format("{}.config.json", a_scenario) },
+			{ a_dir / "settings.ini", golden / fmt::format("{}.settings.ini", a_scenario) }
+		};
+
+		for (const auto& [actual, expected] : files) {
+			if (std::getenv("IHUD_UPDATE_GOLDEN")) {
+				fs::create_directories(golden);
+				fs::copy_file(actual, expected, fs::copy_options::overwrite_existing);
+				continue;
+			}
+			ASSERT_TRUE(fs::exists(expected)) << expected;
+			EXPECT_EQ(MCMScene::ReadFile(actual), MCMScene::ReadFile(expected)) << "differs from " << expected;
+		}
+	}
+
+	const json& GetPage(const json& a_config, std::string_view a_name)
+	{
+		for (const auto& page : a_config["pages"]) {
+			if (page.value("pageDisplayName", "") == a_name) {
+				return page;
+			}
+		}
+		static const json kMissing;
+		return kMissing;
+	}
+
+	std::string WidgetStatus(const fs::path& a_dir)
+	{
+		const auto config = json::parse(MCMScene::ReadFile(a_dir / "config.json"));
+		return GetPage(config, "$fzIH_PageWidgets")["content"][0]["text"].get<std::string>();
+	}
+}
+
+TEST(MCMUpdate, IniStandInRoundTripsTheShippedSettings)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Install(dir.Path());
+
+	MCMScene::Ini ini;
+	ASSERT_EQ(ini.LoadFile((dir.Path() / "settings.ini").string().c_str()), 0);
+	ASSERT_EQ(ini.SaveFile((dir.Path() / "saved.ini").string().c_str()), 0);
+	EXPECT_EQ(MCMScene::ReadFile(dir.Path() / "saved.ini"), MCMScene::ReadFile(dir.Path() / "settings.ini"));
+}
+
+TEST(MCMUpdate, FirstLaunchMatchesGolden)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), kGoldenWidgets);
+	ExpectGolden(dir.Path(), "seeded");
+	EXPECT_NE(WidgetStatus(dir.Path()), "$fzIH_WidgetNewFound");
+}
+
+// A menu discovered after the mid scan: registered, but the page keeps its count status (the MCM cannot refresh).
+TEST(MCMUpdate, RuntimeDiscoveryMatchesGolden)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), kGoldenWidgets);
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, kGoldenWidgets);
+	MCMScene::PlaySession(dir.Path(), host);
+
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, false);
+	MCMUpdate::Update(*model, host, false, true);
+	host.Add("LateMenu", "Interface/mods/latemenu.swf");
+	const auto result = MCMUpdate::Update(*model, host, true, true);
+
+	EXPECT_TRUE(result.configWritten);
+	EXPECT_TRUE(model->widgets.contains("iMode_Latemenu:Widgets"));
+	EXPECT_NE(WidgetStatus(dir.Path()), "$fzIH_WidgetNewFound");
+	ExpectGolden(dir.Path(), "runtime");
+}
+
+// New widgets seen by the mid scan: appended to settings.ini and flagged for a restart.
+TEST(MCMUpdate, MidScanDiscoveryMatchesGolden)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), kGoldenWidgets);
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, kGoldenWidgets + 4);
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, false);
+	MCMUpdate::Update(*model, host, false, true);
+
+	EXPECT_EQ(WidgetStatus(dir.Path()), "$fzIH_WidgetNewFound");
+	EXPECT_NE(model->ini.GetValue("Widgets", "iMode_Widget12", nullptr), nullptr);
+	ExpectGolden(dir.Path(), "midscan");
+}
+
+// SkyUI reordered its container: entries follow their sources to the new slots without a restart warning.
+TEST(MCMUpdate, IndexShiftMatchesGolden)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), kGoldenWidgets);
+	const auto seededIni = MCMScene::ReadFile(dir.Path() / "settings.ini");
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, kGoldenWidgets, 1);
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, false);
+	MCMUpdate::Update(*model, host, false, true);
+
+	EXPECT_NE(WidgetStatus(dir.Path()), "$fzIH_WidgetNewFound");
+	EXPECT_EQ(model->widgets.at("iMode_Widget0:Widgets").rawPath, "_root.WidgetContainer.1");
+	EXPECT_EQ(MCMScene::ReadFile(dir.Path() / "settings.ini"), seededIni);
+	ExpectGolden(dir.Path(), "indexshift");
+}
+
+// Closed menus are probed once per update; uninstalled ones are pruned, installed ones kept.
+TEST(MCMUpdate, ClosedMenusArePrunedOnlyWhenUninstalled)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), 16);
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, 16);
+	host.paths.erase("ModMenu0");
+	host.paths.erase("ModMenu1");
+	host.installed.erase("Interface/mods/modmenu1.swf");
+
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, true);
+	EXPECT_EQ(host.probes, 2u);
+	EXPECT_TRUE(model->widgets.contains("iMode_Modmenu0:Widgets"));
+	EXPECT_FALSE(model->widgets.contains("iMode_Modmenu1:Widgets"));
+}
+
+// A setting stored under a key the naming no longer produces moves to the new key of the same source.
+TEST(MCMUpdate, OrphanedSettingMigratesToTheNewKey)
+{
+	MCMScene::TempDir dir;
+	MCMScene::Install(dir.Path());
+	{
+		auto config = json::parse(MCMScene::ReadFile(dir.Path() / "config.json"));
+		for (auto& page : config["pages"]) {
+			if (page.value("pageDisplayName", "") == "$fzIH_PageWidgets") {
+				page["content"].push_back({ { "help", "Source: widgets/mod3/widget3.swf\nID: _root.WidgetContainer.3" },
+					{ "id", "iMode__root_WidgetContainer_3:Widgets" }, { "text", "Widget3" }, { "type", "enum" } });
+			}
+		}
+		std::ofstream(dir.Path() / "config.json", std::ios::binary) << config.dump(2);
+		std::ofstream(dir.Path() / "settings.ini", std::ios::app) << "iMode__root_WidgetContainer_3 = 2\n";
+	}
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, 8);
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, true);
+
+	EXPECT_EQ(model->ini.GetLongValue("Widgets", "iMode_Widget3", -1), 2);
+	EXPECT_FALSE(model->widgets.contains("iMode__root_WidgetContainer_3:Widgets"));
+}
+
+// Large load orders: every source grouped once, and an unchanged rescan writes nothing.
+TEST(MCMUpdate, LargeLoadOrderRescanWritesNothing)
+{
+	constexpr std::size_t kWidgets = 2000;
+	MCMScene::TempDir dir;
+	MCMScene::Seed(dir.Path(), kWidgets);
+
+	MCMScene::Host host;
+	MCMScene::AddLoadOrder(host, kWidgets);
+	auto model = MCMScene::OpenSession(dir.Path());
+	MCMUpdate::Update(*model, host, false, false);
+	MCMUpdate::Update(*model, host, false, true);
+	const auto saves = model->ini.saves;
+
+	const auto result = MCMUpdate::Update(*model, host, true, true);
+	EXPECT_FALSE(result.configWritten);
+	EXPECT_EQ(result.configBytes, 0u);
+	EXPECT_EQ(model->ini.saves, saves);
+	EXPECT_EQ(model->widgets.size(), kWidgets / 5 * 4 + kWidgets / 8);
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "GFxOps.h"
+
+// In-memory stand-in for the Scaleform objects behind the GFxOps concepts, so HUDApply runs on the host.
+// A Movie owns a tree of Nodes; Values are non-owning handles into it, like RE::GFxValue display objects.
+// Path and member lookups compare names in place and never allocate.
+namespace Mock
+{
+	struct Node
+	{
+		explicit Node(std::string_view a_name, Node* a_parent = nullptr) :
+			name(a_name),
+			parent(a_parent)
+		{}
+
+		Node& Add(std::string_view a_name)
+		{
+			return *children.emplace_back(std::make_unique<Node>(a_name, this));
+		}
+
+		Node* Find(std::string_view a_name) const
+		{
+			for (const auto& child : children) {
+				if (child->name == a_name) {
+					return child.get();
+				}
+			}
+			return nullptr;
+		}
+
+		// Creates the missing nodes of a dotted path below this one ("HUDMovieBaseInstance.Health").
+		Node& AddPath(std::string_view a_path)
+		{
+			Node* node = this;
+			for (const auto part : std::views::split(a_path, '.')) {
+				const std::string_view name(part.begin(), part.end());
+				Node* child = node->Find(name);
+				node = child ? child : &node->Add(name);
+			}
+			return *node;
+		}
+
+		// Unloaded clip: handles stay display objects but display info can no longer be read or written.
+		void Unload()
+		{
+			unloaded = true;
+			for (auto& child : children) {
+				child->Unload();
+			}
+		}
+
+		std::string name;
+		Node* parent;
+		std::vector<std::unique_ptr<Node>> children;
+		std::string url;  // _url member when not empty
+		double alpha = 100.0;
+		bool visible = true;
+		bool unloaded = false;
+		std::uint32_t alphaWrites = 0;
+		std::uint32_t visibleWrites = 0;
+	};
+
+	class Value
+	{
+	public:
+		// Mirrors the fields RE::GFxValue::DisplayInfo marshals: only the ones set on it are applied.
+		class DisplayInfo
+		{
+		public:
+			double GetAlpha() const { return _alpha; }
+			bool GetVisible() const { return _visible; }
+
+			void SetAlpha(double a_alpha)
+			{
+				_alpha = a_alpha;
+				_hasAlpha = true;
+			}
+
+			void SetVisible(bool a_visible)
+			{
+				_visible = a_visible;
+				_hasVisible = true;
+			}
+
+		private:
+			friend class Value;
+
+			double _alpha = 0.0;
+			bool _visible = false;
+			bool _hasAlpha = false;
+			bool _hasVisible = false;
+		};
+
+		Value() = default;
+		explicit Value(double a_number) :
+			_kind(Kind::kNumber),
+			_number(a_number)
+		{}
+		explicit Value(bool a_bool) :
+			_kind(Kind::kBool),
+			_bool(a_bool)
+		{}
+		explicit Value(const char* a_string) :
+			_kind(Kind::kString),
+			_string(a_string)
+		{}
+		explicit Value(Node* a_node) :
+			_kind(a_node ? Kind::kDisplayObject : Kind::kUndefined),
+			_node(a_node)
+		{}
+
+		static Value Object() { return Value(Kind::kObject); }
+		static Value Function() { return Value(Kind::kFunction); }
+
+		bool IsObject() const { return _kind == Kind::kObject || _kind == Kind::kDisplayObject || _kind == Kind::kFunction; }
+		bool IsDisplayObject() const { return _kind == Kind::kDisplayObject; }
+		bool IsArray() const { return false; }
+		bool IsString() const { return _kind == Kind::kString; }
+		bool IsNumber() const { return _kind == Kind::kNumber; }
+		bool IsBool() const { return _kind == Kind::kBool; }
+		bool IsUndefined() const { return _kind == Kind::kUndefined; }
+
+		const char* GetString() const { return _string; }
+		double GetNumber() const { return _number; }
+		bool GetBool() const { return _bool; }
+		Node* GetNode() const { return _node; }
+
+		bool GetMember(const char* a_name, Value* a_out) const
+		{
+			const std::string_view name(a_name);
+			if (_kind == Kind::kObject) {
+				*a_out = name == "_alpha" ? Value(_number) : Value();
+				return true;
+			}
+			if (!IsDisplayObject() || _node->unloaded) {
+				*a_out = Value();
+				return false;
+			}
+			if (name == "_parent") {
+				*a_out = Value(_node->parent);
+			} else if (name == "_url") {
+				*a_out = _node->url.empty() ? Value() : Value(_node->url.c_str());
+			} else if (name == "tweenTo") {
+				*a_out = Function();
+			} else if (Node* child = _node->Find(name)) {
+				*a_out = Value(child);
+			} else {
+				*a_out = Value();
+			}
+			return true;
+		}
+
+		bool GetDisplayInfo(DisplayInfo* a_info) const
+		{
+			if (!IsDisplayObject() || _node->unloaded) {
+				return false;
+			}
+			a_info->_alpha = _node->alpha;
+			a_info->_visible = _node->visible;
+			return true;
+		}
+
+		bool SetDisplayInfo(const DisplayInfo& a_info)
+		{
+			if (!IsDisplayObject() || _node->unloaded) {
+				return false;
+			}
+			if (a_info._hasAlpha) {
+				_node->alpha = a_info._alpha;
+				_node->alphaWrites++;
+			}
+			if (a_info._hasVisible) {
+				_node->visible = a_info._visible;
+				_node->visibleWrites++;
+			}
+			return true;
+		}
+
+		bool SetMember(const char* a_name, const Value& a_value)
+		{
+			const std::string_view name(a_name);
+			if (_kind == Kind::kObject) {
+				_number = a_value.GetNumber();  // tweenTo property bag: only _alpha is used
+				return true;
+			}
+			DisplayInfo info;
+			if (name == "_alpha") {
+				info.SetAlpha(a_value.GetNumber());
+			} else if (name == "_visible") {
+				info.SetVisible(a_value.GetBool());
+			}
+			return SetDisplayInfo(info);
+		}
+
+		// getDepth, swapDepths, tweenTo (applied at once) and tweenEnd.
+		bool Invoke(const char* a_name, Value* a_result, const Value* a_args, std::size_t a_numArgs)
+		{
+			if (!IsDisplayObject() || _node->unloaded) {
+				return false;
+			}
+			const std::string_view name(a_name);
+			auto& siblings = _node->parent->children;
+			const auto self = std::ranges::find_if(siblings, [&](const auto& a_child) { return a_child.get() == _node; });
+
+			if (name == "getDepth") {
+				if (a_result) {
+					*a_result = Value(static_cast<double>(self - siblings.begin()));
+				}
+				return true;
+			}
+			if (name == "swapDepths" && a_numArgs == 1 && a_args[0].IsDisplayObject()) {
+				const auto other = std::ranges::find_if(siblings, [&](const auto& a_child) { return a_child.get() == a_args[0]._node; });
+				if (other == siblings.end()) {
+					return false;
+				}
+				std::iter_swap(self, other);
+				return true;
+			}
+			if (name == "tweenTo" && a_numArgs == 2) {
+				DisplayInfo info;
+				info.SetAlpha(a_args[1]._number);
+				return SetDisplayInfo(info);
+			}
+			return name == "tweenEnd";
+		}
+
+		template <class F>
+		void VisitMembers(F&& a_visitor) const
+		{
+			if (!IsDisplayObject() || _node->unloaded) {
+				return;
+			}
+			for (const auto& child : _node->children) {
+				a_visitor(child->name.c_str(), Value(child.get()));
+			}
+		}
+
+	private:
+		enum class Kind : std::uint8_t
+		{
+			kUndefined,
+			kNumber,
+			kBool,
+			kString,
+			kObject,
+			kFunction,
+			kDisplayObject
+		};
+
+		explicit Value(Kind a_kind) :
+			_kind(a_kind)
+		{}
+
+		Kind _kind = Kind::kUndefined;
+		Node* _node = nullptr;
+		double _number = 0.0;
+		bool _bool = false;
+		const char* _string = nullptr;
+	};
+
+	class Movie
+	{
+	public:
+		Node& Root() { return _root; }
+
+		// GFx extensions (tweenTo) as enabled by the movie itself
+		void SetExtensions(bool a_enabled) { _extensions = a_enabled; }
+
+		bool GetVariable(Value* a_out, const char* a_path) const
+		{
+			const std::string_view path(a_path);
+			if (path == "_global.gfxExtensions") {
+				*a_out = Value(_extensions);
+				return true;
+			}
+
+			const Node* node = nullptr;
+			for (const auto part : std::views::split(path, '.')) {
+				const std::string_view name(part.begin(), part.end());
+				node = node ? node->Find(name) : (name == _root.name ? &_root : nullptr);
+				if (!node) {
+					*a_out = Value();
+					return false;
+				}
+			}
+			*a_out = Value(const_cast<Node*>(node));
+			return node != nullptr;
+		}
+
+		void CreateObject(Value* a_out) const { *a_out = Value::Object(); }
+
+	private:
+		Node _root{ "_root" };
+		bool _extensions = false;
+	};
+
+	static_assert(GFxOps::Movie<Movie, Value>);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// Host stand-in for src/PCH.h: the standard library and the aliases the host modules rely on.
+// Anything that needs RE/SKSE types does not belong in a host module.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+using namespace std::literals;
+using json = nlohmann::json;
+
+// SKSE::log forwards to spdlog in game; the host modules log straight to spdlog.
+namespace logger
+{
+	using spdlog::debug;
+	using spdlog::error;
+	using spdlog::info;
+	using spdlog::warn;
+}
@@ -0,0 +1,151 @@
+#include "PatternMatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+// PatternMatcher against a naive check of every pattern with find/starts_with/==.
+namespace
+{
+	struct Pattern
+	{
+		std::string text;
+		std::uint32_t category;
+		PatternMatcher::Anchor anchor;
+	};
+
+	std::string Fold(std::string_view a_str, bool a_ignoreCase)
+	{
+		std::string out(a_str);
+		if (a_ignoreCase) {
+			for (char& c : out) {
+				if (c >= 'A' && c <= 'Z') {
+					c = static_cast<char>(c | 0x20);
+				}
+			}
+		}
+		return out;
+	}
+
+	std::uint32_t NaiveMatch(const std::vector<Pattern>& a_patterns, std::string_view a_text, bool a_ignoreCase)
+	{
+		const std::string text = Fold(a_text, a_ignoreCase);
+		std::uint32_t result = 0;
+		for (const auto& pattern : a_patterns) {
+			const std::string needle = Fold(pattern.text, a_ignoreCase);
+			bool matched = false;
+			switch (pattern.anchor) {
+			case PatternMatcher::Anchor::kAnywhere:
+				matched = text.find(needle) != std::string::npos;
+				break;
+			case PatternMatcher::Anchor::kPrefix:
+				matched = text.starts_with(needle);
+				break;
+			case PatternMatcher::Anchor::kExact:
+				matched = text == needle;
+				break;
+			}
+			if (matched) {
+				result |= pattern.category;
+			}
+		}
+		return result;
+	}
+
+	// Small alphabet with both cases so patterns overlap, share prefixes and nest inside each other.
+	std::string RandomWord(std::mt19937& a_rng, int a_maxLength)
+	{
+		static constexpr std::string_view kAlphabet = "abAB./_x";
+		std::string out;
+		const int length = std::uniform_int_distribution<int>(1, a_maxLength)(a_rng);
+		for (int i = 0; i < length; i++) {
+			out += kAlphabet[std::uniform_int_distribution<std::size_t>(0, kAlphabet.size() - 1)(a_rng)];
+		}
+		return out;
+	}
+
+	std::string RandomText(std::mt19937& a_rng)
+	{
+		std::string out;
+		const int length = std::uniform_int_distribution<int>(0, 24)(a_rng);
+		for (int i = 0; i < length; i++) {
+			switch (std::uniform_int_distribution<int>(0, 9)(a_rng)) {
+			case 0:
+				out += static_cast<char>(std::uniform_int_distribution<int>(0x80, 0xFF)(a_rng));
+				break;
+			case 1:
+				out += static_cast<char>(std::uniform_int_distribution<int>(0x20, 0x7E)(a_rng));
+				break;
+			default:
+				out += RandomWord(a_rng, 1);
+				break;
+			}
+		}
+		return out;
+	}
+
+	void FuzzAgainstNaive(bool a_ignoreCase, std::uint32_t a_seed)
+	{
+		std::mt19937 rng(a_seed);
+		for (int round = 0; round < 500; round++) {
+			std::vector<Pattern> patterns;
+			PatternMatcher matcher(a_ignoreCase);
+			const int count = std::uniform_int_distribution<int>(1, 12)(rng);
+			for (int i = 0; i < count; i++) {
+				Pattern pattern{ RandomWord(rng, 5), 1u << std::uniform_int_distribution<int>(0, 7)(rng),
+					static_cast<PatternMatcher::Anchor>(std::uniform_int_distribution<int>(0, 2)(rng)) };
+				ASSERT_TRUE(matcher.Add(pattern.text, pattern.category, pattern.anchor));
+				patterns.push_back(std::move(pattern));
+			}
+			matcher.Build();
+			ASSERT_EQ(matcher.GetPatternCount(), patterns.size());
+
+			for (int i = 0; i < 200; i++) {
+				const std::string text = RandomText(rng);
+				ASSERT_EQ(matcher.Match(text), NaiveMatch(patterns, text, a_ignoreCase)) << "text: " << text;
+			}
+		}
+	}
+}
+
+TEST(PatternMatcher, IgnoreCaseMatchesNaive)
+{
+	FuzzAgainstNaive(true, 11);
+}
+
+TEST(PatternMatcher, CaseSensitiveMatchesNaive)
+{
+	FuzzAgainstNaive(false, 12);
+}
+
+// The discovery member blocklist is exact and case-sensitive, like the unordered_set it replaced.
+TEST(PatternMatcher, CaseSensitiveAnchors)
+{
+	PatternMatcher matcher(false);
+	matcher.Add("HudElements", 1, PatternMatcher::Anchor::kExact);
+	matcher.Add("instance", 2, PatternMatcher::Anchor::kPrefix);
+	matcher.Build();
+
+	EXPECT_EQ(matcher.Match("HudElements"), 1u);
+	EXPECT_EQ(matcher.Match("HUDElements"), 0u);
+	EXPECT_EQ(matcher.Match("HudElements2"), 0u);
+	EXPECT_EQ(matcher.Match("instance42"), 2u);
+	EXPECT_EQ(matcher.Match("Instance42"), 0u);
+	EXPECT_EQ(matcher.Match("myinstance"), 0u);
+}
+
+TEST(PatternMatcher, RejectsUnusablePatterns)
+{
+	PatternMatcher matcher;
+	EXPECT_FALSE(matcher.Add("", 1));
+	EXPECT_FALSE(matcher.Add("abc", 0));
+	EXPECT_FALSE(matcher.Add("tab\there", 1));
+	EXPECT_FALSE(matcher.Add("caf\xc3\xa9", 1));
+	EXPECT_EQ(matcher.GetPatternCount(), 0u);
+
+	// Unbuilt matchers match nothing
+	EXPECT_TRUE(matcher.Add("abc", 1));
+	EXPECT_EQ(matcher.Match("abc"), 0u);
+	matcher.Build();
+	EXPECT_EQ(matcher.Match("xABCx"), 1u);
+}
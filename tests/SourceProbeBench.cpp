@@ -0,0 +1,87 @@
+#include "SourceProbe.h"
+
+#include <cstdio>
+#include <thread>
+
+// Resolves a few hundred sources through SourceProbe over loose files in a temp directory, half of them missing,
+// with every fifth source requested twice like multi-instance widgets. Reports the cold batch (every source probed)
+// and the warm one (all cached) for a serial backend, as BSResource is in game, and for a thread-safe one.
+// An optional per-probe latency stands in for archive lookups. Not part of ctest: run SourceProbeBench from a
+// Release build. SourceProbeBench [sources latency_us]
+namespace
+{
+	class LooseFileBackend : public SourceProbe::Backend
+	{
+	public:
+		LooseFileBackend(fs::path a_root, bool a_threadSafe, std::chrono::microseconds a_latency) :
+			_root(std::move(a_root)),
+			_threadSafe(a_threadSafe),
+			_latency(a_latency)
+		{}
+
+		bool Exists(const std::string& a_source) override
+		{
+			if (_latency.count() > 0) {
+				std::this_thread::sleep_for(_latency);
+			}
+			std::error_code ec;
+			return fs::exists(_root / a_source, ec);
+		}
+
+		bool IsThreadSafe() const override { return _threadSafe; }
+
+	private:
+		fs::path _root;
+		bool _threadSafe;
+		std::chrono::microseconds _latency;
+	};
+
+	double MeasureUs(auto&& a_func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		a_func();
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	std::vector<std::size_t> counts = { 100, 300, 1000 };
+	std::vector<int> latencies = { 0, 50 };
+	if (a_argc == 3) {
+		counts = { std::stoul(a_argv[1]) };
+		latencies = { std::stoi(a_argv[2]) };
+	}
+
+	const fs::path root = fs::temp_directory_path() / fmt::format("ihud_probe_{}", std::chrono::steady_clock::now().time_since_epoch().count());
+	fs::create_directories(root / "Interface" / "mods");
+
+	for (const auto count : counts) {
+		std::vector<std::string> batch;
+		for (std::size_t i = 0; i < count; i++) {
+			auto source = fmt::format("Interface/mods/menu{}.swf", i);
+			if (i % 2 == 0) {
+				std::ofstream(root / source) << "FWS";
+			}
+			batch.push_back(source);
+			if (i % 5 == 4) {
+				batch.push_back(source);
+			}
+		}
+
+		for (const auto latency : latencies) {
+			for (const bool threadSafe : { false, true }) {
+				LooseFileBackend backend(root, threadSafe, std::chrono::microseconds(latency));
+				SourceProbe::Resolver resolver(backend);
+				const double cold = MeasureUs([&]() { resolver.Probe(batch); });
+				const double warm = MeasureUs([&]() { resolver.Probe(batch); });
+				std::printf("%5zu sources %4d us latency %-8s %10.0f us cold %8.1f us warm %5zu cached\n",
+					count, latency, threadSafe ? "parallel" : "serial", cold, warm, resolver.CachedCount());
+			}
+		}
+	}
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+	return 0;
+}
@@ -0,0 +1,122 @@
+#include "SourceProbe.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+// The batched, cached source resolver (SourceProbe) over a fake backend.
+namespace
+{
+	class FakeBackend : public SourceProbe::Backend
+	{
+	public:
+		FakeBackend(std::unordered_set<std::string> a_installed, bool a_threadSafe, std::chrono::microseconds a_latency = {}) :
+			_installed(std::move(a_installed)),
+			_threadSafe(a_threadSafe),
+			_latency(a_latency)
+		{}
+
+		bool Exists(const std::string& a_source) override
+		{
+			const auto active = ++_active;
+			for (auto peak = _peak.load(); active > peak && !_peak.compare_exchange_weak(peak, active);) {}
+			{
+				std::lock_guard lock(_lock);
+				calls[a_source]++;
+				threads.insert(std::this_thread::get_id());
+			}
+			if (_latency.count() > 0) {
+				std::this_thread::sleep_for(_latency);
+			}
+			--_active;
+			return _installed.contains(a_source);
+		}
+
+		bool IsThreadSafe() const override { return _threadSafe; }
+
+		// Most Exists calls seen running at once.
+		std::size_t Peak() const { return _peak; }
+
+		std::map<std::string, std::size_t> calls;
+		std::unordered_set<std::thread::id> threads;
+
+	private:
+		std::unordered_set<std::string> _installed;
+		bool _threadSafe;
+		std::chrono::microseconds _latency;
+		std::mutex _lock;
+		std::atomic_size_t _active = 0;
+		std::atomic_size_t _peak = 0;
+	};
+
+	std::vector<std::string> MakeSources(std::size_t a_count)
+	{
+		std::vector<std::string> sources;
+		for (std::size_t i = 0; i < a_count; i++) {
+			sources.push_back(fmt::format("Interface/mods/menu{}.swf", i));
+		}
+		return sources;
+	}
+}
+
+TEST(SourceProbe, DuplicatesAreProbedOnce)
+{
+	FakeBackend backend({ "a.swf" }, true);
+	SourceProbe::Resolver resolver(backend);
+
+	resolver.Probe({ "a.swf", "b.swf", "a.swf", "b.swf", "a.swf" });
+	EXPECT_EQ(backend.calls.size(), 2u);
+	EXPECT_EQ(backend.calls["a.swf"], 1u);
+	EXPECT_EQ(backend.calls["b.swf"], 1u);
+	EXPECT_TRUE(resolver.Exists("a.swf"));
+	EXPECT_FALSE(resolver.Exists("b.swf"));
+	EXPECT_FALSE(resolver.Exists("never-probed.swf"));
+}
+
+TEST(SourceProbe, CachedUntilInvalidated)
+{
+	FakeBackend backend({ "a.swf" }, true);
+	SourceProbe::Resolver resolver(backend);
+
+	resolver.Probe({ "a.swf", "b.swf" });
+	resolver.Probe({ "a.swf", "b.swf", "c.swf" });
+	EXPECT_EQ(backend.calls["a.swf"], 1u);
+	EXPECT_EQ(backend.calls["c.swf"], 1u);
+	EXPECT_EQ(resolver.CachedCount(), 3u);
+
+	resolver.Invalidate();
+	EXPECT_FALSE(resolver.Exists("a.swf"));
+	resolver.Probe({ "a.swf" });
+	EXPECT_EQ(backend.calls["a.swf"], 2u);
+	EXPECT_TRUE(resolver.Exists("a.swf"));
+}
+
+TEST(SourceProbe, SerialBackendStaysOnTheCallingThread)
+{
+	const auto sources = MakeSources(64);
+	FakeBackend backend({ sources.begin(), sources.begin() + 32 }, false, std::chrono::microseconds(50));
+	SourceProbe::Resolver resolver(backend);
+
+	resolver.Probe(sources);
+	EXPECT_EQ(backend.Peak(), 1u);
+	ASSERT_EQ(backend.threads.size(), 1u);
+	EXPECT_TRUE(backend.threads.contains(std::this_thread::get_id()));
+	for (std::size_t i = 0; i < sources.size(); i++) {
+		EXPECT_EQ(resolver.Exists(sources[i]), i < 32) << sources[i];
+	}
+}
+
+TEST(SourceProbe, ThreadSafeBackendSharesTheBatch)
+{
+	const auto sources = MakeSources(64);
+	FakeBackend backend({ sources.begin(), sources.begin() + 32 }, true, std::chrono::microseconds(500));
+	SourceProbe::Resolver resolver(backend);
+
+	resolver.Probe(sources);
+	EXPECT_GT(backend.Peak(), 1u);
+	EXPECT_LE(backend.Peak(), SourceProbe::Resolver::kMaxWorkers);
+	EXPECT_EQ(backend.calls.size(), sources.size());
+	for (std::size_t i = 0; i < sources.size(); i++) {
+		EXPECT_EQ(resolver.Exists(sources[i]), i < 32) << sources[i];
+	}
+}
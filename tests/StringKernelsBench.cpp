@@ -0,0 +1,67 @@
+#include "LegacyStringOps.h"
+#include "StringKernels.h"
+
+#include <cstdio>
+
+// Times each kernel against the code it replaced over widget URLs and display paths.
+// Not part of ctest: run StringKernelsBench from a Release build.
+namespace
+{
+	constexpr std::string_view kCorpus[] = {
+		"Interface/exported/widgets/skyui/meter.swf",
+		"Interface%2Fexported%2Fwidgets%2FiEquip%2FiEquip%5FWidget.swf",
+		"C:/Games/Steam/steamapps/common/Skyrim Special Edition/Data/Interface/HUDMenu.swf",
+		"_root.WidgetContainer.12.widget.MeterHolder.meter_mc",
+		"_root.HUDMovieBaseInstance.CompassShoutMeterHolder.Compass",
+		"Interface/exported/moreHUD/baseIcons.swf",
+		"Interface/Sneak+Vignette/SneakVignetteDummy.swf",
+		"file:///Data/Interface/Exported/Widgets/TrueHUD/TrueHUD.swf"
+	};
+
+	volatile std::size_t g_sink = 0;
+
+	template <class F>
+	void Time(const char* a_name, F&& a_body)
+	{
+		constexpr int kRounds = 200000;
+		const auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < kRounds; round++) {
+			for (const auto input : kCorpus) {
+				g_sink = g_sink + a_body(input);
+			}
+		}
+		const auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%-28s %8.1f ns/call\n", a_name, ns / (kRounds * std::size(kCorpus)));
+	}
+}
+
+int main()
+{
+#ifdef IHUD_NO_SIMD
+	std::printf("StringKernels: scalar (IHUD_NO_SIMD)\n");
+#else
+	std::printf("StringKernels: SSE2 where available\n");
+#endif
+
+	std::string buffer;
+
+	Time("legacy IsPrintableAscii", [](std::string_view a_in) { return static_cast<std::size_t>(Legacy::IsPrintableAscii(a_in)); });
+	Time("kernel IsPrintableAscii", [](std::string_view a_in) { return static_cast<std::size_t>(StringKernels::IsPrintableAscii(a_in)); });
+
+	Time("legacy FindNoCase", [](std::string_view a_in) { return Legacy::FindNoCase(a_in, "sneakvignette.swf"); });
+	Time("kernel FindNoCase", [](std::string_view a_in) { return StringKernels::FindNoCase(a_in, "sneakvignette.swf"); });
+
+	Time("legacy SanitizeName", [](std::string_view a_in) { return Legacy::SanitizeName(a_in).size(); });
+	Time("kernel SanitizeAlnum", [&](std::string_view a_in) {
+		buffer.assign(a_in);
+		StringKernels::SanitizeAlnum(buffer.data(), buffer.size());
+		return buffer.size();
+	});
+
+	Time("legacy UrlDecode", [](std::string_view a_in) { return Legacy::UrlDecode(a_in).size(); });
+	Time("kernel PercentDecode", [&](std::string_view a_in) {
+		StringKernels::PercentDecode(a_in, buffer);
+		return buffer.size();
+	});
+	return 0;
+}
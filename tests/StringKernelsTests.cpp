@@ -0,0 +1,150 @@
+#include "LegacyStringOps.h"
+#include "StringKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+
+// Built twice: against the SSE2 kernels (ImmersiveHUDTests) and with IHUD_NO_SIMD (StringKernelsScalarTests).
+namespace
+{
+	// Mostly URL/path shaped text, with every byte value mixed in so that 16-byte blocks hit all ranges.
+	std::string RandomInput(std::mt19937& a_rng)
+	{
+		static constexpr std::string_view kPieces[] = { "%", "%2F", "%2f", "%20", "%G1", "%4G", "% 5", "%+f", "%-1",
+			"+", "Interface/", "exported\\", "Compass.SWF", "skyui", "_root.WidgetContainer.", "SneakVignette" };
+		std::string out;
+		const int pieces = std::uniform_int_distribution<int>(0, 24)(a_rng);
+		for (int i = 0; i < pieces; i++) {
+			switch (std::uniform_int_distribution<int>(0, 3)(a_rng)) {
+			case 0:
+				out += kPieces[std::uniform_int_distribution<std::size_t>(0, std::size(kPieces) - 1)(a_rng)];
+				break;
+			case 1:
+				out += static_cast<char>(std::uniform_int_distribution<int>(0, 255)(a_rng));
+				break;
+			default:
+				out += static_cast<char>(std::uniform_int_distribution<int>(0x20, 0x7E)(a_rng));
+				break;
+			}
+		}
+		return out;
+	}
+
+	std::string Lowered(std::string a_str)
+	{
+		Legacy::ToLowerAscii(a_str);
+		return a_str;
+	}
+
+	constexpr int kIterations = 200000;
+}
+
+TEST(StringKernels, ToLowerMatchesLegacy)
+{
+	std::mt19937 rng(1);
+	for (int i = 0; i < kIterations; i++) {
+		std::string input = RandomInput(rng);
+		std::string expected = input;
+		Legacy::ToLowerAscii(expected);
+		StringKernels::ToLowerAscii(input.data(), input.size());
+		ASSERT_EQ(input, expected);
+	}
+}
+
+TEST(StringKernels, IsPrintableMatchesLegacy)
+{
+	std::mt19937 rng(2);
+	for (int i = 0; i < kIterations; i++) {
+		const std::string input = RandomInput(rng);
+		ASSERT_EQ(StringKernels::IsPrintableAscii(input), Legacy::IsPrintableAscii(input)) << input;
+	}
+}
+
+TEST(StringKernels, SanitizeMatchesLegacy)
+{
+	std::mt19937 rng(3);
+	for (int i = 0; i < kIterations; i++) {
+		std::string input = RandomInput(rng);
+		const std::string expected = Legacy::SanitizeName(input);
+		StringKernels::SanitizeAlnum(input.data(), input.size());
+		ASSERT_EQ(input, expected);
+	}
+}
+
+TEST(StringKernels, FindNoCaseMatchesLegacy)
+{
+	std::mt19937 rng(4);
+	for (int i = 0; i < kIterations; i++) {
+		const std::string haystack = RandomInput(rng);
+		// Needles are lowercase, as at every call site: half cut from the haystack, half random
+		std::string needle;
+		if (!haystack.empty() && std::uniform_int_distribution<int>(0, 1)(rng) == 0) {
+			const auto pos = std::uniform_int_distribution<std::size_t>(0, haystack.size() - 1)(rng);
+			const auto len = std::uniform_int_distribution<std::size_t>(0, std::min<std::size_t>(haystack.size() - pos, 20))(rng);
+			needle = Lowered(haystack.substr(pos, len));
+		} else {
+			needle = Lowered(RandomInput(rng).substr(0, 6));
+		}
+		ASSERT_EQ(StringKernels::FindNoCase(haystack, needle), Legacy::FindNoCase(haystack, needle)) << haystack << " / " << needle;
+	}
+}
+
+// Every pair of bytes after a '%', in front of a 16-byte tail so the SSE2 run scan is involved too.
+// Escapes sscanf could not convert are compared against the literal-'%' reading (see PercentDecode).
+TEST(StringKernels, PercentDecodeMatchesLegacyForEveryEscape)
+{
+	std::string decoded;
+	int unconvertedPairs = 0;
+	for (int first = 0; first < 256; first++) {
+		for (int second = 0; second < 256; second++) {
+			const std::string input = std::string("a%") + static_cast<char>(first) + static_cast<char>(second) + "+Interface/%2Fx.swf";
+			bool unconverted = false;
+			const std::string expected = Legacy::UrlDecode(input, true, &unconverted);
+			StringKernels::PercentDecode(input, decoded);
+			ASSERT_EQ(decoded, expected) << first << ", " << second;
+			unconvertedPairs += unconverted ? 1 : 0;
+		}
+	}
+	// Sanity check that both kinds of escape were exercised
+	EXPECT_GT(unconvertedPairs, 0);
+	EXPECT_LT(unconvertedPairs, 256 * 256);
+}
+
+TEST(StringKernels, PercentDecodeMatchesLegacy)
+{
+	std::mt19937 rng(5);
+	std::string decoded;
+	int identical = 0;
+	for (int i = 0; i < kIterations; i++) {
+		const std::string input = RandomInput(rng);
+		bool unconverted = false;
+		const std::string expected = Legacy::UrlDecode(input, true, &unconverted);
+		StringKernels::PercentDecode(input, decoded);
+		ASSERT_EQ(decoded, expected) << input;
+		identical += unconverted ? 0 : 1;
+	}
+	// Most inputs have no unconvertible escape, so the old decoder's output is matched exactly
+	EXPECT_GT(identical, kIterations / 2);
+}
+
+TEST(StringKernels, PercentDecodeEdges)
+{
+	std::string decoded;
+	for (const auto& [input, expected] : std::initializer_list<std::pair<std::string_view, std::string_view>>{
+			 { "", "" },
+			 { "%", "%" },
+			 { "%4", "%4" },
+			 { "x%41", "xA" },
+			 { "%GG", "%GG" },
+			 { "% 41", "\x04" "1" },
+			 { "%4G", "\x04" },
+			 { "%  ", "%  " },
+			 { "%+f", "\x0f" },
+			 { "%-1", "\xff" },
+			 { "a+b", "a b" } }) {
+		StringKernels::PercentDecode(input, decoded);
+		EXPECT_EQ(decoded, expected) << input;
+	}
+}
@@ -0,0 +1,11 @@
+#include "Trace.h"
+
+// Host counterpart of bReplayTrace: same replay code, without starting the game.
+int main(int a_argc, char** a_argv)
+{
+	if (a_argc != 3) {
+		fmt::print(stderr, "usage: {} <trace.bin> <timeline.csv>\n", a_argc > 0 ? a_argv[0] : "TraceReplay");
+		return 2;
+	}
+	return Trace::Replay(a_argv[1], a_argv[2]) ? 0 : 1;
+}
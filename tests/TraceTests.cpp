@@ -0,0 +1,203 @@
+#include "Trace.h"
+#include "WidgetMode.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <sstream>
+
+// Regression check for the fade engine: a scripted session is recorded through Trace and replayed,
+// and the timeline must match tests/data/fade_session.csv (per-frame cost excluded).
+// After an intended fade change, regenerate both fixtures with IHUD_UPDATE_FIXTURES=1 and review the CSV diff.
+namespace
+{
+	const fs::path kDataDir = IHUD_TEST_DATA;
+	const fs::path kTraceFixture = kDataDir / "fade_session.bin";
+	const fs::path kTimelineFixture = kDataDir / "fade_session.csv";
+
+	bool Within(int a_frame, int a_begin, int a_end)
+	{
+		return a_frame >= a_begin && a_frame < a_end;
+	}
+
+	// Drives the recorder the way HUDManager::Update does over ~12 seconds of play.
+	void RecordSession()
+	{
+		FadeEngine::Config config;
+		for (int frame = 0; frame < 720; frame++) {
+			const float delta = Within(frame, 520, 540) ? 0.0f : (frame % 7 == 0 ? 1.0f / 30.0f : 1.0f / 60.0f);
+
+			// HUD Menu not loaded yet
+			if (frame < 5) {
+				Trace::RecordEarlyReturn(delta, Trace::kSkipped);
+				continue;
+			}
+			if (frame == 5 || frame == 600) {
+				Trace::RecordEvent(Trace::kReset);
+			}
+			if (frame == 60) {
+				Trace::RecordEvent(Trace::kToggleDown);
+			}
+			if (frame == 61) {
+				Trace::RecordEvent(Trace::kToggleUp);
+			}
+			if (frame == 240) {
+				Trace::RecordEvent(Trace::kMenuOpen);
+			}
+			if (frame == 261) {
+				Trace::RecordEvent(Trace::kMenuClose);
+			}
+			if (Within(frame, 300, 340)) {
+				Trace::RecordEarlyReturn(delta, Trace::kDisabled);
+				continue;
+			}
+
+			if (frame == 420) {
+				config.fadeInSpeed = 4.0f;
+				config.hudMin = 20.0f;
+				config.crosshairHideWhileSneaking = true;
+			}
+			if (frame == 460) {
+				config.sneakMeterEnabled = false;
+				config.stealthMeterMode = WidgetModes::kInterior;
+			}
+			if (frame == 560) {
+				config.alwaysShowInCombat = true;
+				config.ctxMax = 80.0f;
+			}
+
+			FadeEngine::Inputs inputs;
+			inputs.delta = delta;
+			inputs.userWantsVisible = Within(frame, 60, 200);
+			inputs.shouldHide = Within(frame, 240, 261);
+			inputs.isInCombat = Within(frame, 150, 300) || Within(frame, 550, 620);
+			inputs.isWeaponDrawn = Within(frame, 180, 330);
+			inputs.isInterior = Within(frame, 350, 500);
+			inputs.isSneaking = Within(frame, 380, 480);
+			inputs.detectionLevel = inputs.isSneaking ? static_cast<float>((frame - 380) % 50) * 2.0f : 0.0f;
+			inputs.isActionActive = Within(frame, 400, 420);
+			inputs.isLookActive = Within(frame, 430, 450);
+			inputs.hasLeftEnchant = Within(frame, 440, 470);
+			inputs.hasRightEnchant = Within(frame, 450, 490);
+			inputs.isLockedOn = Within(frame, 620, 680);
+			inputs.isTDM = inputs.isLockedOn;
+			inputs.isSmoothCam = Within(frame, 640, 700);
+			inputs.smoothCamOwnsCrosshair = Within(frame, 660, 700);
+			Trace::RecordFrame(inputs, config);
+		}
+	}
+
+	std::string ReadFile(const fs::path& a_path)
+	{
+		std::ifstream in(a_path, std::ios::binary);
+		std::ostringstream out;
+		out << in.rdbuf();
+		return out.str();
+	}
+
+	// Timeline rows without the trailing costNs column, which is wall-clock time.
+	std::vector<std::string> Timeline(const fs::path& a_csv)
+	{
+		std::vector<std::string> rows;
+		std::istringstream in(ReadFile(a_csv));
+		for (std::string line; std::getline(in, line);) {
+			rows.push_back(line.substr(0, line.rfind(',')));
+		}
+		return rows;
+	}
+
+	std::vector<std::string> Split(const std::string& a_row)
+	{
+		std::vector<std::string> fields;
+		std::istringstream in(a_row);
+		for (std::string field; std::getline(in, field, ',');) {
+			fields.push_back(field);
+		}
+		return fields;
+	}
+
+	class TraceTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			_dir = fs::temp_directory_path() / ("ihud_trace_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+			fs::create_directories(_dir);
+			Trace::SetDirectory(_dir);
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(_dir, ec);
+		}
+
+		fs::path Record()
+		{
+			Trace::SetRecording(true);
+			RecordSession();
+			Trace::SetRecording(false);
+			return *Trace::GetTracePath();
+		}
+
+		fs::path _dir;
+	};
+}
+
+TEST_F(TraceTest, RecordingMatchesFixture)
+{
+	const auto trace = Record();
+
+	if (std::getenv("IHUD_UPDATE_FIXTURES")) {
+		fs::copy_file(trace, kTraceFixture, fs::copy_options::overwrite_existing);
+		ASSERT_TRUE(Trace::Replay(trace, kTimelineFixture));
+	}
+
+	// A mismatch means the record layout changed: bump Trace::kVersion and regenerate.
+	ASSERT_TRUE(fs::exists(kTraceFixture)) << kTraceFixture;
+	EXPECT_EQ(ReadFile(trace), ReadFile(kTraceFixture));
+}
+
+TEST_F(TraceTest, ReplayMatchesTimelineFixture)
+{
+	ASSERT_TRUE(fs::exists(kTimelineFixture)) << kTimelineFixture;
+
+	const auto output = _dir / "replay.csv";
+	ASSERT_TRUE(Trace::Replay(kTraceFixture, output));
+
+	const auto replayed = Timeline(output);
+	const auto expected = Timeline(kTimelineFixture);
+	ASSERT_EQ(replayed.size(), expected.size());
+	for (std::size_t i = 0; i < replayed.size(); i++) {
+		ASSERT_EQ(replayed[i], expected[i]) << "row " << i;
+	}
+}
+
+TEST_F(TraceTest, ReplayHonoursEarlyReturns)
+{
+	const auto output = _dir / "replay.csv";
+	ASSERT_TRUE(Trace::Replay(Record(), output));
+
+	const auto rows = Timeline(output);
+	ASSERT_EQ(rows.size(), 721u);  // header + one row per Update call
+
+	enum Column { kFrame, kDelta, kEvents, kHidden, kHud };
+	for (int frame = 0; frame < 720; frame++) {
+		const auto fields = Split(rows[frame + 1]);
+		SCOPED_TRACE(frame);
+		ASSERT_EQ(std::stoi(fields[kFrame]), frame);
+		if (frame < 5) {
+			EXPECT_EQ(std::stoi(fields[kEvents]), Trace::kSkipped);
+			EXPECT_EQ(std::stof(fields[kHud]), 0.0f);
+		} else if (Within(frame, 240, 261) || Within(frame, 300, 340)) {
+			EXPECT_EQ(fields[kHidden], "1");
+			EXPECT_EQ(std::stof(fields[kHud]), 0.0f);
+		} else {
+			EXPECT_EQ(fields[kHidden], "0");
+		}
+	}
+
+	// Toggled on from frame 60: the HUD has fully faded in well before it is toggled off
+	EXPECT_EQ(std::stof(Split(rows[191])[kHud]), 100.0f);
+	EXPECT_EQ(std::stoi(Split(rows[601])[kEvents]), Trace::kReset);
+}
@@ -0,0 +1,90 @@
+#include "AllocationCounter.h"
+#include "DiscoveryScene.h"
+
+#include <cstdio>
+
+// Runs widget discovery (WidgetDiscovery) as ScanForWidgets does on a deep scan: every external menu, then the
+// HUD's _root, over generated trees from a few hundred to tens of thousands of display objects. Reports wall time,
+// heap allocations and Scaleform calls per scan, for the first scan (every path new) and for rescans.
+// Not part of ctest: run WidgetDiscoveryBench from a Release build.
+namespace
+{
+	constexpr int kScans = 50;
+
+	struct Result
+	{
+		std::size_t visitable = 0;
+		std::size_t discovered = 0;
+		std::size_t firstAllocations = 0;
+		std::size_t rescanAllocations = 0;
+		double usPerScan = 0.0;
+		double callsPerScan = 0.0;
+	};
+
+	Result Measure(const DiscoveryScene::Shape& a_shape)
+	{
+		auto scene = DiscoveryScene::Build(a_shape);
+		DiscoveryScene::Sink sink;
+		std::string path;
+		std::string url;
+
+		Result result;
+		result.visitable = scene->visitable;
+		{
+			AllocationCounter::Scope counting;
+			DiscoveryScene::Scan(*scene, sink, path, url);
+			result.firstAllocations = counting.Count();
+		}
+		result.discovered = sink.sources.size();
+
+		{
+			AllocationCounter::Scope counting;
+			const auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < kScans; i++) {
+				DiscoveryScene::Scan(*scene, sink, path, url);
+			}
+			result.usPerScan = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kScans;
+			result.rescanAllocations = counting.Count();
+		}
+
+		// Counted in a second pass: the enabled profiler times its stages, which would skew the first
+		Profiler::g_enabled = true;
+		DiscoveryScene::Scan(*scene, sink, path, url);
+		std::uint64_t calls = 0;
+		for (std::uint32_t call = 0; call < static_cast<std::uint32_t>(Profiler::Call::kTotal); call++) {
+			calls += Profiler::GetFrameCount(static_cast<Profiler::Call>(call));
+		}
+		Profiler::g_enabled = false;
+		Profiler::Reset();
+		result.callsPerScan = static_cast<double>(calls);
+		return result;
+	}
+
+	void Print(const DiscoveryScene::Shape& a_shape, const Result& a_result)
+	{
+		std::printf("width %3zu depth %zu %3zu widgets %3zu menus %6zu clips %4zu paths %9.1f us/scan %8.0f calls/scan %6zu allocs first %zu allocs rescan\n",
+			a_shape.width, a_shape.depth, a_shape.widgets, a_shape.menus, a_result.visitable, a_result.discovered,
+			a_result.usPerScan, a_result.callsPerScan, a_result.firstAllocations, a_result.rescanAllocations / kScans);
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	// WidgetDiscoveryBench [width depth widgets menus]: one shape instead of the sweep
+	std::vector<DiscoveryScene::Shape> shapes = {
+		{ .width = 4, .depth = 2, .widgets = 8, .menus = 2 },
+		{ .width = 8, .depth = 2, .widgets = 32, .menus = 8 },
+		{ .width = 16, .depth = 3, .widgets = 64, .menus = 16 },
+		{ .width = 32, .depth = 4, .widgets = 128, .menus = 32 },
+	};
+	if (a_argc == 5) {
+		shapes = { { .width = std::stoul(a_argv[1]), .depth = std::stoul(a_argv[2]), .widgets = std::stoul(a_argv[3]), .menus = std::stoul(a_argv[4]) } };
+	}
+
+	for (const auto& shape : shapes) {
+		Print(shape, Measure(shape));
+	}
+	return 0;
+}
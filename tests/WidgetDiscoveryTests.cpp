@@ -0,0 +1,154 @@
+#include "DiscoveryScene.h"
+
+#include <gtest/gtest.h>
+
+// Widget discovery (WidgetDiscovery) over generated movie trees: what a scan finds, and how its cost grows.
+namespace
+{
+	struct ScanCost
+	{
+		std::uint32_t calls = 0;  // Scaleform calls counted by GFxOps
+		std::size_t visitable = 0;
+	};
+
+	std::uint32_t CountedCalls()
+	{
+		std::uint32_t calls = 0;
+		for (std::uint32_t call = 0; call < static_cast<std::uint32_t>(Profiler::Call::kTotal); call++) {
+			calls += Profiler::GetFrameCount(static_cast<Profiler::Call>(call));
+		}
+		return calls;
+	}
+
+	// Scaleform calls of a rescan of a_shape, once its paths are known.
+	ScanCost MeasureRescan(const DiscoveryScene::Shape& a_shape)
+	{
+		auto scene = DiscoveryScene::Build(a_shape);
+		DiscoveryScene::Sink sink;
+		std::string path;
+		std::string url;
+		DiscoveryScene::Scan(*scene, sink, path, url);
+
+		Profiler::Reset();
+		Profiler::g_enabled = true;
+		DiscoveryScene::Scan(*scene, sink, path, url);
+		Profiler::g_enabled = false;
+
+		ScanCost cost{ CountedCalls(), scene->visitable };
+		Profiler::Reset();
+		return cost;
+	}
+}
+
+TEST(WidgetDiscovery, FindsWidgetsExternalsAndMenus)
+{
+	const DiscoveryScene::Shape shape;
+	auto scene = DiscoveryScene::Build(shape);
+	DiscoveryScene::Sink sink;
+	std::string path;
+	std::string url;
+
+	const auto result = DiscoveryScene::Scan(*scene, sink, path, url);
+	EXPECT_TRUE(result.changes);
+	EXPECT_EQ(result.found, static_cast<int>(shape.widgets + shape.externals));
+	EXPECT_EQ(sink.sources.size(), DiscoveryScene::ExpectedPaths(shape));
+
+	EXPECT_EQ(sink.sources.at("_root.WidgetContainer.3"), "widgets/widget3.swf");
+	EXPECT_EQ(sink.sources.at("_root.External1"), "mods/external1.swf");
+	EXPECT_EQ(sink.sources.at("ExternalMenu2"), "menus/menu2.swf");
+	EXPECT_FALSE(sink.sources.contains("_root.Blocklisted"));
+	EXPECT_FALSE(sink.sources.contains("_root.External1.content"));
+}
+
+TEST(WidgetDiscovery, RescanReportsOnlyChangedSources)
+{
+	auto scene = DiscoveryScene::Build({});
+	DiscoveryScene::Sink sink;
+	std::string path;
+	std::string url;
+	DiscoveryScene::Scan(*scene, sink, path, url);
+
+	EXPECT_FALSE(DiscoveryScene::Scan(*scene, sink, path, url).changes);
+
+	// SkyUI index shift: slot 0 now holds another widget
+	Mock::Value widget;
+	ASSERT_TRUE(scene->hud.GetVariable(&widget, "_root.WidgetContainer.0.widget"));
+	widget.GetNode()->url = "widgets/other.swf";
+	EXPECT_TRUE(DiscoveryScene::Scan(*scene, sink, path, url).changes);
+	EXPECT_EQ(sink.sources.at("_root.WidgetContainer.0"), "widgets/other.swf");
+}
+
+TEST(WidgetDiscovery, RegisteredClipIsNotDiscovered)
+{
+	auto scene = DiscoveryScene::Build({});
+	DiscoveryScene::Sink sink;
+	sink.registered.emplace("_root.WidgetContainer.5");
+	sink.registered.emplace("_root.External0");
+	std::string path;
+	std::string url;
+
+	DiscoveryScene::Scan(*scene, sink, path, url);
+	EXPECT_FALSE(sink.sources.contains("_root.WidgetContainer.5"));
+	EXPECT_FALSE(sink.sources.contains("_root.External0"));
+	EXPECT_TRUE(sink.sources.contains("_root.WidgetContainer.6"));
+}
+
+TEST(WidgetDiscovery, PathBufferIsRestoredBetweenMembers)
+{
+	auto scene = DiscoveryScene::Build({ .width = 3, .depth = 3 });
+	DiscoveryScene::Sink sink;
+	std::string path;
+	std::string url;
+
+	DiscoveryScene::Scan(*scene, sink, path, url);
+	EXPECT_EQ(path, "_root");
+	for (const auto& [discovered, source] : sink.sources) {
+		EXPECT_EQ(discovered.find(".."), std::string::npos) << discovered;
+	}
+}
+
+// Cost per reachable clip stays flat as the tree widens: a scan is linear in what it visits.
+TEST(WidgetDiscovery, CostGrowsLinearlyWithWidth)
+{
+	const auto small = MeasureRescan({ .width = 4 });
+	const auto large = MeasureRescan({ .width = 32 });
+	ASSERT_GT(large.visitable, small.visitable * 30);
+
+	const double smallPerClip = static_cast<double>(small.calls) / small.visitable;
+	const double largePerClip = static_cast<double>(large.calls) / large.visitable;
+	EXPECT_LE(largePerClip, smallPerClip * 1.1) << small.calls << " calls for " << small.visitable << " clips, "
+	                                            << large.calls << " for " << large.visitable;
+}
+
+// Levels below the scan depth are never entered, however deep the movie goes.
+TEST(WidgetDiscovery, CostIgnoresDepthBeyondTheScan)
+{
+	const auto shallow = MeasureRescan({ .width = 6, .depth = 2 });
+	const auto deep = MeasureRescan({ .width = 6, .depth = 5 });
+	EXPECT_EQ(deep.calls, shallow.calls);
+}
+
+// WidgetContainer costs one lookup per slot plus a constant per occupied slot.
+TEST(WidgetDiscovery, CostGrowsLinearlyWithWidgets)
+{
+	const auto empty = MeasureRescan({ .widgets = 0 });
+	const auto half = MeasureRescan({ .widgets = 64 });
+	const auto full = MeasureRescan({ .widgets = 128 });
+	EXPECT_EQ(full.calls - half.calls, half.calls - empty.calls);
+}
+
+// Each discovered path reaches the sink once per scan.
+TEST(WidgetDiscovery, SinkSeesEachPathOncePerScan)
+{
+	const DiscoveryScene::Shape shape{ .widgets = 100, .externals = 20, .menus = 10 };
+	auto scene = DiscoveryScene::Build(shape);
+	DiscoveryScene::Sink sink;
+	std::string path;
+	std::string url;
+
+	for (int scan = 0; scan < 3; scan++) {
+		sink.adds = 0;
+		DiscoveryScene::Scan(*scene, sink, path, url);
+		EXPECT_EQ(sink.adds, DiscoveryScene::ExpectedPaths(shape));
+	}
+}